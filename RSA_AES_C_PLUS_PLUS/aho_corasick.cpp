@@ -0,0 +1,115 @@
+// Sekcja includów - dołączanie niezbędnych bibliotek
+#include "aho_corasick.h"  // Deklaracja automatu
+#include <deque>           // Kolejka BFS przy budowie łączy niepowodzenia
+#include <cstring>         // memset
+
+// Budowa automatu
+// ===============
+
+AhoCorasick::AhoCorasick(const std::vector<std::string>& wzorce) {
+    // Kompresja alfabetu - każdy bajt występujący we wzorcach dostaje własną klasę
+    memset(klasa_bajtu_, 0, sizeof(klasa_bajtu_));
+    for (const auto& w : wzorce) {
+        for (unsigned char c : w) {
+            if (klasa_bajtu_[c] == 0) klasa_bajtu_[c] = static_cast<uint16_t>(liczba_klas_++);
+        }
+        if (w.size() > maks_dlugosc_) maks_dlugosc_ = w.size();
+    }
+    const uint32_t K = liczba_klas_;
+
+    // Drzewo trie: -1 oznacza brak krawędzi
+    std::vector<int32_t> trie(K, -1);
+    std::vector<std::vector<uint32_t>> wlasne_wyjscia(1);
+    dlugosci_.resize(wzorce.size());
+
+    for (uint32_t id = 0; id < wzorce.size(); ++id) {
+        dlugosci_[id] = static_cast<uint32_t>(wzorce[id].size());
+        if (wzorce[id].empty()) continue;  // Pusty wzorzec nie ma wystąpień
+
+        size_t stan = 0;
+        for (unsigned char c : wzorce[id]) {
+            const size_t indeks = stan * K + klasa_bajtu_[c];
+            if (trie[indeks] < 0) {  // Nowa krawędź - dodaj stan
+                trie[indeks] = static_cast<int32_t>(liczba_stanow_++);
+                trie.resize(liczba_stanow_ * K, -1);
+                wlasne_wyjscia.emplace_back();
+            }
+            stan = static_cast<size_t>(trie[indeks]);
+        }
+        wlasne_wyjscia[stan].push_back(id);
+    }
+
+    // BFS: łącza niepowodzenia, uzupełnienie brakujących przejść (pełny DFA) i scalanie wyjść
+    std::vector<uint32_t> porazka(liczba_stanow_, 0);
+    std::vector<std::vector<uint32_t>> wyjscia(liczba_stanow_);
+    std::deque<uint32_t> kolejka;
+
+    for (uint32_t k = 0; k < K; ++k) {
+        int32_t& cel = trie[k];
+        if (cel < 0) cel = 0;  // Z korzenia brak krawędzi - zostań w korzeniu
+        else {
+            porazka[cel] = 0;
+            kolejka.push_back(static_cast<uint32_t>(cel));
+        }
+    }
+    wyjscia[0] = wlasne_wyjscia[0];
+
+    while (!kolejka.empty()) {
+        uint32_t s = kolejka.front();
+        kolejka.pop_front();
+
+        // Wyjścia stanu = własne wzorce + wzorce stanu, na który wskazuje łącze niepowodzenia
+        wyjscia[s] = wlasne_wyjscia[s];
+        wyjscia[s].insert(wyjscia[s].end(), wyjscia[porazka[s]].begin(), wyjscia[porazka[s]].end());
+
+        for (uint32_t k = 0; k < K; ++k) {
+            int32_t& cel = trie[s * K + k];
+            if (cel < 0) {
+                cel = trie[porazka[s] * K + k];  // Przejście przez łącze niepowodzenia (już obliczone - BFS)
+            }
+            else {
+                porazka[cel] = static_cast<uint32_t>(trie[porazka[s] * K + k]);
+                kolejka.push_back(static_cast<uint32_t>(cel));
+            }
+        }
+    }
+
+    // Spłaszczenie: przesunięcia stanów zamiast numerów (brak mnożenia w pętli) + flaga wyjścia
+    przejscia_.resize(liczba_stanow_ * K);
+    for (size_t i = 0; i < przejscia_.size(); ++i) {
+        uint32_t cel = static_cast<uint32_t>(trie[i]);
+        przejscia_[i] = cel * K | (wyjscia[cel].empty() ? 0u : FLAGA_WYJSCIA);
+    }
+
+    wyjscia_poczatek_.resize(liczba_stanow_ + 1);
+    for (size_t s = 0; s < liczba_stanow_; ++s) {
+        wyjscia_poczatek_[s] = static_cast<uint32_t>(wyjscia_.size());
+        wyjscia_.insert(wyjscia_.end(), wyjscia[s].begin(), wyjscia[s].end());
+    }
+    wyjscia_poczatek_[liczba_stanow_] = static_cast<uint32_t>(wyjscia_.size());
+}
+
+// Zliczanie
+// =========
+
+void AhoCorasick::zlicz(std::string_view fragment, size_t min_koniec, size_t max_poczatek, std::vector<uint64_t>& liczniki) const {
+    if (liczniki.size() < dlugosci_.size()) liczniki.resize(dlugosci_.size(), 0);
+    if (maks_dlugosc_ == 0) return;
+
+    const uint32_t K = liczba_klas_;
+    const uint32_t* przejscia = przejscia_.data();
+    const size_t n = fragment.size();
+    uint32_t stan = 0;  // Przesunięcie bieżącego stanu (stan * K)
+
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t cel = przejscia[stan + klasa_bajtu_[static_cast<unsigned char>(fragment[i])]];
+        stan = cel & ~FLAGA_WYJSCIA;
+        if (!(cel & FLAGA_WYJSCIA) || i < min_koniec) continue;  // Większość bajtów nie kończy żadnego wzorca
+
+        const uint32_t id_stanu = stan / K;
+        for (uint32_t j = wyjscia_poczatek_[id_stanu]; j < wyjscia_poczatek_[id_stanu + 1]; ++j) {
+            const uint32_t id = wyjscia_[j];
+            if (i + 1 - dlugosci_[id] < max_poczatek) ++liczniki[id];  // Dopasowanie należy do tego fragmentu
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once          // Dyrektywa kompilatora zapobiegająca wielokrotnemu dołączaniu
+#ifndef AHO_CORASICK_H    // Tradycyjne zabezpieczenie przed podwójnym include
+#define AHO_CORASICK_H
+
+#include <string>       // Biblioteka do obsługi ciągów znaków (std::string)
+#include <string_view>  // Lekka reprezentacja fragmentów stringów
+#include <vector>       // Spłaszczone tablice automatu
+#include <cstdint>      // Typy o stałej szerokości (uint32_t)
+#include <cstddef>      // Definicje standardowe (np. size_t)
+
+/**
+ * Automat Aho-Corasick zliczający wystąpienia wielu wzorców w jednym przebiegu
+ * @brief Przejścia są zapisane jako pełny DFA w jednej spłaszczonej tablicy
+ *        [stan * liczba_klas + klasa_bajtu], a bajty nieobecne we wzorcach dzielą jedną klasę,
+ *        więc tablica pozostaje mała i mieści się w pamięci podręcznej procesora.
+ */
+class AhoCorasick {
+public:
+    /**
+     * Buduje automat dla zestawu wzorców
+     * @param wzorce Szukane słowa - puste słowa są pomijane (ich licznik zawsze wynosi 0)
+     */
+    explicit AhoCorasick(const std::vector<std::string>& wzorce);
+
+    /**
+     * Zlicza wystąpienia wszystkich wzorców we fragmencie (również nakładające się)
+     * @param fragment Przeszukiwany fragment
+     * @param min_koniec Dopasowania kończące się przed tym indeksem są pomijane (nakładka strumienia)
+     * @param max_poczatek Dopasowania zaczynające się od tego indeksu są pomijane (należą do następnego fragmentu)
+     * @param liczniki[in,out] Liczniki wzorców - wyniki są dodawane do istniejących wartości
+     */
+    void zlicz(std::string_view fragment, size_t min_koniec, size_t max_poczatek, std::vector<uint64_t>& liczniki) const;
+
+    size_t liczba_wzorcow() const { return dlugosci_.size(); }  // Liczba wzorców (łącznie z pustymi)
+    size_t maks_dlugosc() const { return maks_dlugosc_; }      // Długość najdłuższego wzorca
+    size_t liczba_stanow() const { return liczba_stanow_; }    // Liczba stanów automatu
+
+private:
+    static constexpr uint32_t FLAGA_WYJSCIA = 0x80000000u;  // Stan docelowy kończy co najmniej jeden wzorzec
+
+    uint16_t klasa_bajtu_[256];         // Kompresja alfabetu: bajt -> klasa
+    uint32_t liczba_klas_ = 1;          // Liczba klas (klasa 0 - bajty spoza wzorców)
+    size_t liczba_stanow_ = 1;
+    size_t maks_dlugosc_ = 0;
+    std::vector<uint32_t> przejscia_;   // Cel przejścia jako przesunięcie stanu (stan * liczba_klas) + FLAGA_WYJSCIA
+    std::vector<uint32_t> wyjscia_poczatek_;  // Dla stanu s: wzorce kończące się w s to wyjscia_[poczatek[s]..poczatek[s+1])
+    std::vector<uint32_t> wyjscia_;     // Numery wzorców (łącznie z osiągalnymi przez łącza słownikowe)
+    std::vector<uint32_t> dlugosci_;    // Długości wzorców
+};
+
+#endif // AHO_CORASICK_H
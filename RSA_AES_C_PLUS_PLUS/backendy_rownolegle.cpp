@@ -0,0 +1,360 @@
+// Sekcja includów - dołączanie niezbędnych bibliotek
+#include "backendy_rownolegle.h"  // Interfejs backendu i fabryka
+#include "topologia_numa.h"       // Przypinanie wątków OpenMP w trybie NUMA
+#include <omp.h>                  // Backendy OpenMP
+#include <algorithm>              // std::for_each, std::min
+#include <numeric>                // std::iota - numery bloków std::execution
+#include <atomic>                 // Wspólny licznik zadań areny
+#include <chrono>                 // Czas pracy wątków
+#include <thread>                 // Wątki areny
+#include <mutex>                  // Stan partii areny
+#include <condition_variable>     // Budzenie wątków areny i oczekiwanie na koniec partii
+#ifdef __has_include
+#if __has_include(<execution>)
+#include <execution>              // std::execution::par (C++17; libstdc++ wymaga TBB przy linkowaniu)
+#endif
+#endif
+
+namespace {
+
+// Sekwencyjny i pula wątków
+// =========================
+
+class BackendSekwencyjny : public BackendRownolegly {
+public:
+    const char* nazwa() const override { return "sekwencyjnie"; }
+    size_t liczba_watkow() const override { return 1; }
+
+    void wykonaj(size_t liczba_zadan, const std::function<void(size_t, size_t)>& zadanie) override {
+        for (size_t i = 0; i < liczba_zadan; ++i) zadanie(i, 0);
+    }
+    void na_kazdym_watku(const std::function<void(size_t)>& zadanie) override { zadanie(0); }
+};
+
+class BackendPuli : public BackendRownolegly {
+public:
+    BackendPuli(size_t liczba_watkow, bool numa) : pula_(PulaWatkow::wspolna(liczba_watkow, numa)) {}
+
+    const char* nazwa() const override { return "std::thread (pula z podkradaniem)"; }
+    size_t liczba_watkow() const override { return pula_.liczba_watkow(); }
+    bool numa() const override { return pula_.numa(); }
+
+    void wykonaj(size_t liczba_zadan, const std::function<void(size_t, size_t)>& zadanie) override {
+        pula_.wykonaj(liczba_zadan, zadanie);
+    }
+    void na_kazdym_watku(const std::function<void(size_t)>& zadanie) override {
+        pula_.wykonaj(pula_.liczba_watkow(), [&](size_t, size_t watek) { zadanie(watek); });
+    }
+    std::vector<StatystykiWatku> statystyki() const override { return pula_.statystyki(); }
+
+private:
+    PulaWatkow& pula_;
+};
+
+// OpenMP
+// ======
+
+class BackendOpenMP : public BackendRownolegly {
+public:
+    BackendOpenMP(int liczba_watkow, bool numa) : liczba_(liczba_watkow), numa_(numa) {}
+
+    const char* nazwa() const override { return numa_ ? "OpenMP (bloki na wezlach NUMA)" : "OpenMP (schedule(static, 10))"; }
+    size_t liczba_watkow() const override { return static_cast<size_t>(liczba_); }
+    bool numa() const override { return numa_; }
+
+    void wykonaj(size_t liczba_zadan, const std::function<void(size_t, size_t)>& zadanie) override {
+        statystyki_.clear();
+        if (numa_) {
+            wykonaj_na_wezlach(liczba_zadan, zadanie);
+            return;
+        }
+        const long long liczba = static_cast<long long>(liczba_zadan);
+#pragma omp parallel for schedule(static, 10) num_threads(liczba_)
+        for (long long i = 0; i < liczba; ++i) {
+            zadanie(static_cast<size_t>(i), static_cast<size_t>(omp_get_thread_num()));
+        }
+    }
+
+    void na_kazdym_watku(const std::function<void(size_t)>& zadanie) override {
+        statystyki_.clear();
+#pragma omp parallel num_threads(liczba_)
+        {
+            zadanie(static_cast<size_t>(omp_get_thread_num()));
+        }
+    }
+
+    std::vector<StatystykiWatku> statystyki() const override { return statystyki_; }
+
+private:
+    // Te same ciągłe bloki co przy rozmieszczaniu stron na puli - wątek przypięty do węzła wykonuje zadania,
+    // których dane leżą w pamięci tego węzła (bez podkradania, jak schedule(static))
+    void wykonaj_na_wezlach(size_t liczba_zadan, const std::function<void(size_t, size_t)>& zadanie) {
+        const TopologiaNUMA& topologia = TopologiaNUMA::systemowa();
+        statystyki_.assign(static_cast<size_t>(liczba_), StatystykiWatku{});
+#pragma omp parallel num_threads(liczba_)
+        {
+            const size_t watek = static_cast<size_t>(omp_get_thread_num());
+            const size_t zespol = static_cast<size_t>(omp_get_num_threads());
+            const size_t na_watek = (liczba_zadan + zespol - 1) / zespol;
+            topologia.przypnij_watek(watek, zespol);
+            const auto poczatek = std::chrono::steady_clock::now();
+            StatystykiWatku& statystyki = statystyki_[watek];
+            for (size_t i = watek * na_watek; i < liczba_zadan && i < (watek + 1) * na_watek; ++i) {
+                zadanie(i, watek);
+                ++statystyki.zadania;
+            }
+            statystyki.praca = std::chrono::duration<double>(std::chrono::steady_clock::now() - poczatek).count();
+            statystyki.wezel = topologia.wezel_watku(watek, zespol);
+            topologia.odepnij_watek();  // Wątki OpenMP są współdzielone z pozostałymi wersjami
+        }
+    }
+
+    int liczba_;
+    bool numa_;
+    std::vector<StatystykiWatku> statystyki_;  // Tylko tryb NUMA - czas pracy i węzeł wątku
+};
+
+// Zadania OpenMP: jeden wątek zespołu tworzy zadanie na każdy numer, wolne wątki zabierają je z puli zadań
+// środowiska OpenMP. Zadania wymagają OpenMP 3.0 - starsze (np. /openmp w MSVC, wersja 2.0) dostają
+// równoważny podział dynamiczny pętli.
+class BackendOpenMPZadania : public BackendRownolegly {
+public:
+    explicit BackendOpenMPZadania(int liczba_watkow) : liczba_(liczba_watkow) {}
+
+#if defined(_OPENMP) && _OPENMP >= 200805
+    const char* nazwa() const override { return "OpenMP (task)"; }
+#else
+    const char* nazwa() const override { return "OpenMP (schedule(dynamic, 1) - brak task w OpenMP 2.0)"; }
+#endif
+    size_t liczba_watkow() const override { return static_cast<size_t>(liczba_); }
+
+    void wykonaj(size_t liczba_zadan, const std::function<void(size_t, size_t)>& zadanie) override {
+        const long long liczba = static_cast<long long>(liczba_zadan);
+#if defined(_OPENMP) && _OPENMP >= 200805
+#pragma omp parallel num_threads(liczba_)
+#pragma omp single
+        {
+            for (long long i = 0; i < liczba; ++i) {
+#pragma omp task firstprivate(i)
+                zadanie(static_cast<size_t>(i), static_cast<size_t>(omp_get_thread_num()));
+            }
+        }  // Niejawna bariera single - czeka na wszystkie zadania
+#else
+#pragma omp parallel for schedule(dynamic, 1) num_threads(liczba_)
+        for (long long i = 0; i < liczba; ++i) {
+            zadanie(static_cast<size_t>(i), static_cast<size_t>(omp_get_thread_num()));
+        }
+#endif
+    }
+
+    void na_kazdym_watku(const std::function<void(size_t)>& zadanie) override {
+#pragma omp parallel num_threads(liczba_)
+        {
+            zadanie(static_cast<size_t>(omp_get_thread_num()));
+        }
+    }
+
+private:
+    int liczba_;
+};
+
+// std::execution
+// ==============
+
+// Algorytmy równoległe nie podają numeru wątku ani nie pozwalają ustawić liczby wątków (pulę wybiera
+// implementacja: pula systemowa w MSVC, TBB w libstdc++). Zadania są więc dzielone na BLOKI_NA_WATEK
+// ciągłych bloków na żądany wątek - blok jest elementem algorytmu, a jego numer miejscem wyników cząstkowych.
+class BackendStdExecution : public BackendRownolegly {
+public:
+    static constexpr size_t BLOKI_NA_WATEK = 4;  // Kilka bloków na wątek - implementacja może wyrównać obciążenie
+
+    explicit BackendStdExecution(size_t liczba_watkow) : watki_(liczba_watkow) {}
+
+#ifdef __cpp_lib_execution
+    const char* nazwa() const override { return "std::execution::par"; }
+#else
+    const char* nazwa() const override { return "std::for_each (brak std::execution - sekwencyjnie)"; }
+#endif
+    size_t liczba_watkow() const override { return watki_; }
+    size_t liczba_miejsc() const override { return watki_ * BLOKI_NA_WATEK; }
+
+    void wykonaj(size_t liczba_zadan, const std::function<void(size_t, size_t)>& zadanie) override {
+        std::vector<size_t> bloki(std::min(liczba_miejsc(), liczba_zadan));
+        std::iota(bloki.begin(), bloki.end(), size_t{ 0 });
+        const size_t liczba_blokow = bloki.size();
+        // Tylko par, bez unseq: zadania alokują (bufory pozycji i odczytu, stany leniwego DFA), a w trybie
+        // pozycyjnym czytają plik - wywołania niebezpieczne dla wektoryzacji są przy unseq niezdefiniowane
+        auto blok = [&](size_t b) {
+            for (size_t i = b * liczba_zadan / liczba_blokow; i < (b + 1) * liczba_zadan / liczba_blokow; ++i) zadanie(i, b);
+        };
+#ifdef __cpp_lib_execution
+        std::for_each(std::execution::par, bloki.begin(), bloki.end(), blok);
+#else
+        std::for_each(bloki.begin(), bloki.end(), blok);
+#endif
+    }
+
+    // Zadania kolejek blokują się na muteksie czytnika - też par
+    void na_kazdym_watku(const std::function<void(size_t)>& zadanie) override {
+        std::vector<size_t> watki(watki_);
+        std::iota(watki.begin(), watki.end(), size_t{ 0 });
+#ifdef __cpp_lib_execution
+        std::for_each(std::execution::par, watki.begin(), watki.end(), [&](size_t watek) { zadanie(watek); });
+#else
+        std::for_each(watki.begin(), watki.end(), [&](size_t watek) { zadanie(watek); });
+#endif
+    }
+
+private:
+    size_t watki_;
+};
+
+// Arena zadań
+// ===========
+
+/**
+ * Stały zbiór wątków, do którego na czas partii dołącza wątek wywołujący (jak task_arena w TBB)
+ * @brief W odróżnieniu od PulaWatkow nie ma kolejek ani kradzieży: uczestnicy pobierają porcje numerów
+ *        zadań ze wspólnego licznika atomowego (fetch_add), więc rozdział pracy kosztuje jedną operację
+ *        atomową na porcję, a szybszy wątek po prostu pobiera więcej porcji.
+ */
+class ArenaZadan {
+public:
+    explicit ArenaZadan(size_t liczba_watkow) {
+        if (liczba_watkow == 0) liczba_watkow = 1;
+        for (size_t id = 1; id < liczba_watkow; ++id) watki_.emplace_back(&ArenaZadan::petla, this, id);  // 0 - wywołujący
+    }
+
+    ~ArenaZadan() {
+        {
+            std::lock_guard<std::mutex> blokada(mutex_);
+            zatrzymaj_ = true;
+        }
+        nowa_partia_.notify_all();
+        for (auto& t : watki_) t.join();
+    }
+
+    ArenaZadan(const ArenaZadan&) = delete;
+    ArenaZadan& operator=(const ArenaZadan&) = delete;
+
+    size_t liczba_watkow() const { return watki_.size() + 1; }
+
+    // Wywołuje praca(id) raz na każdym uczestniku (id 0 - wątek wywołujący) i czeka, aż wszyscy skończą
+    void uruchom(const std::function<void(size_t)>& praca) {
+        std::lock_guard<std::mutex> wywolanie(wywolanie_);
+        {
+            std::lock_guard<std::mutex> blokada(mutex_);
+            praca_ = &praca;
+            aktywne_ = watki_.size();
+            ++partia_;
+        }
+        nowa_partia_.notify_all();
+        praca(0);
+        std::unique_lock<std::mutex> blokada(mutex_);
+        koniec_partii_.wait(blokada, [&] { return aktywne_ == 0; });
+        praca_ = nullptr;
+    }
+
+    // Arena współdzielona przez wszystkie wywołania - tworzona od nowa tylko przy zmianie liczby wątków
+    static ArenaZadan& wspolna(size_t liczba_watkow) {
+        static std::mutex mutex;
+        static std::unique_ptr<ArenaZadan> arena;
+        std::lock_guard<std::mutex> blokada(mutex);
+        if (liczba_watkow == 0) liczba_watkow = 1;
+        if (!arena || arena->liczba_watkow() != liczba_watkow) {
+            arena.reset();  // Najpierw zatrzymaj stare wątki
+            arena = std::make_unique<ArenaZadan>(liczba_watkow);
+        }
+        return *arena;
+    }
+
+private:
+    void petla(size_t id) {
+        size_t ostatnia_partia = 0;
+        for (;;) {
+            const std::function<void(size_t)>* praca;
+            {
+                std::unique_lock<std::mutex> blokada(mutex_);
+                nowa_partia_.wait(blokada, [&] { return zatrzymaj_ || partia_ != ostatnia_partia; });
+                if (zatrzymaj_) return;
+                ostatnia_partia = partia_;
+                praca = praca_;
+            }
+            (*praca)(id);
+            std::lock_guard<std::mutex> blokada(mutex_);
+            if (--aktywne_ == 0) koniec_partii_.notify_one();
+        }
+    }
+
+    std::vector<std::thread> watki_;
+    const std::function<void(size_t)>* praca_ = nullptr;  // Praca bieżącej partii
+    size_t partia_ = 0;                                   // Numer partii - zmiana budzi wątki
+    size_t aktywne_ = 0;                                  // Wątki robocze, które nie skończyły bieżącej partii
+    bool zatrzymaj_ = false;
+    std::mutex mutex_;
+    std::condition_variable nowa_partia_;
+    std::condition_variable koniec_partii_;
+    std::mutex wywolanie_;                                // Serializuje wywołania uruchom()
+};
+
+class BackendAreny : public BackendRownolegly {
+public:
+    static constexpr size_t PORCJE_NA_WATEK = 8;  // Mniejsze porcje - lepsze wyrównanie, więcej operacji na liczniku
+
+    explicit BackendAreny(size_t liczba_watkow) : arena_(ArenaZadan::wspolna(liczba_watkow)) {}
+
+    const char* nazwa() const override { return "arena zadan (wspolny licznik)"; }
+    size_t liczba_watkow() const override { return arena_.liczba_watkow(); }
+
+    void wykonaj(size_t liczba_zadan, const std::function<void(size_t, size_t)>& zadanie) override {
+        const size_t n = arena_.liczba_watkow();
+        const size_t porcja = std::max<size_t>(1, liczba_zadan / (n * PORCJE_NA_WATEK));
+        std::atomic<size_t> nastepne{ 0 };
+        statystyki_.assign(n, StatystykiWatku{});
+
+        const auto poczatek = std::chrono::steady_clock::now();
+        arena_.uruchom([&](size_t id) {
+            StatystykiWatku& statystyki = statystyki_[id];
+            for (;;) {
+                const size_t od = nastepne.fetch_add(porcja, std::memory_order_relaxed);
+                if (od >= liczba_zadan) break;
+                const size_t do_ = std::min(od + porcja, liczba_zadan);
+                const auto start = std::chrono::steady_clock::now();
+                for (size_t i = od; i < do_; ++i) zadanie(i, id);
+                statystyki.praca += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                statystyki.zadania += do_ - od;
+            }
+            });
+        const double czas_partii = std::chrono::duration<double>(std::chrono::steady_clock::now() - poczatek).count();
+        for (auto& statystyki : statystyki_) statystyki.bezczynnosc = std::max(0.0, czas_partii - statystyki.praca);
+    }
+
+    void na_kazdym_watku(const std::function<void(size_t)>& zadanie) override {
+        statystyki_.clear();
+        arena_.uruchom(zadanie);
+    }
+
+    std::vector<StatystykiWatku> statystyki() const override { return statystyki_; }
+
+private:
+    ArenaZadan& arena_;
+    std::vector<StatystykiWatku> statystyki_;
+};
+
+} // namespace
+
+// Fabryka
+// =======
+
+std::unique_ptr<BackendRownolegly> utworz_backend(RodzajBackendu rodzaj, int liczba_watkow, bool numa) {
+    const size_t watki = liczba_watkow > 0 ? static_cast<size_t>(liczba_watkow) : 1;
+    switch (rodzaj) {
+    case RodzajBackendu::PulaWatkow: return std::make_unique<BackendPuli>(watki, numa);
+    case RodzajBackendu::OpenMP: return std::make_unique<BackendOpenMP>(static_cast<int>(watki), numa);
+    case RodzajBackendu::OpenMPZadania: return std::make_unique<BackendOpenMPZadania>(static_cast<int>(watki));
+    case RodzajBackendu::StdExecution: return std::make_unique<BackendStdExecution>(watki);
+    case RodzajBackendu::ArenaZadan: return std::make_unique<BackendAreny>(watki);
+    case RodzajBackendu::Sekwencyjny: break;
+    }
+    return std::make_unique<BackendSekwencyjny>();
+}
@@ -0,0 +1,58 @@
+#pragma once               // Dyrektywa kompilatora zapobiegająca wielokrotnemu dołączaniu
+#ifndef BACKENDY_ROWNOLEGLE_H  // Tradycyjne zabezpieczenie przed podwójnym include
+#define BACKENDY_ROWNOLEGLE_H
+
+#include <cstddef>         // Definicje standardowe (np. size_t)
+#include <vector>          // Statystyki wątków
+#include <functional>      // std::function dla zadania
+#include <memory>          // std::unique_ptr z utworz_backend
+#include "pula_watkow.h"   // StatystykiWatku
+
+// Model wykonania równoległego, którym wersja zliczania rozdziela fragmenty
+enum class RodzajBackendu {
+    Sekwencyjny,    // Jeden wątek (wywołujący), zadania po kolei
+    PulaWatkow,     // std::thread - długo żyjąca pula z podkradaniem zadań (PulaWatkow::wspolna)
+    OpenMP,         // #pragma omp parallel for schedule(static, 10)
+    OpenMPZadania,  // Zadania OpenMP (task) tworzone przez jeden wątek i pobierane przez wolne wątki zespołu
+    StdExecution,   // std::for_each(std::execution::par) po blokach zadań (C++17)
+    ArenaZadan      // Własna arena: wątki (z wywołującym) pobierają porcje zadań ze wspólnego licznika
+};
+
+/**
+ * Sposób wykonania partii niezależnych zadań - jedyne miejsce, w którym wersje zliczania się różnią
+ * @brief Zadania dostają numer wątku (miejsca) mniejszy od liczba_miejsc(), więc wyniki cząstkowe,
+ *        bufory odczytu i bufory pozycji są zwykłymi wektorami indeksowanymi tym numerem - zadania
+ *        z tym samym numerem nigdy nie działają równocześnie.
+ */
+class BackendRownolegly {
+public:
+    virtual ~BackendRownolegly() = default;
+
+    virtual const char* nazwa() const = 0;
+    virtual size_t liczba_watkow() const = 0;                       // Wątki wykonujące zadania
+    virtual size_t liczba_miejsc() const { return liczba_watkow(); }  // Numery wątków przekazywane zadaniom: 0..liczba_miejsc()-1
+    virtual bool numa() const { return false; }                    // Wątki przypięte do węzłów, zadania rozdzielane ciągłymi blokami
+
+    /**
+     * Wykonuje zadanie(numer_zadania, numer_watku) dla numerów 0..liczba_zadan-1 i czeka na koniec partii
+     */
+    virtual void wykonaj(size_t liczba_zadan, const std::function<void(size_t, size_t)>& zadanie) = 0;
+
+    /**
+     * Wykonuje zadanie(numer_watku) raz na każdym wątku - dla trybów, w których wątki same pobierają
+     * pracę z kolejki (pierścień strumienia, czytnik asynchroniczny), dopóki ta się nie skończy
+     */
+    virtual void na_kazdym_watku(const std::function<void(size_t)>& zadanie) = 0;
+
+    // Zadania, kradzieże i czas pracy wątków z ostatniej partii - puste, gdy backend ich nie zbiera
+    virtual std::vector<StatystykiWatku> statystyki() const { return {}; }
+};
+
+/**
+ * Tworzy backend danego rodzaju
+ * @param liczba_watkow Żądana liczba wątków (Sekwencyjny - zawsze 1)
+ * @param numa Przypięcie wątków do węzłów NUMA - tylko PulaWatkow i OpenMP, pozostałe rodzaje je pomijają
+ */
+std::unique_ptr<BackendRownolegly> utworz_backend(RodzajBackendu rodzaj, int liczba_watkow, bool numa = false);
+
+#endif // BACKENDY_ROWNOLEGLE_H
@@ -0,0 +1,529 @@
+// Sekcja includów - dołączanie niezbędnych bibliotek
+#include "czytnik_asynchroniczny.h"  // Deklaracja czytnika
+#include <algorithm>                 // std::min, std::max
+#include <chrono>                    // Czas odczytu z urządzenia
+#include <new>                       // std::align_val_t - wyrównane bufory
+#include <cstring>                   // memset
+#include <utility>                   // std::pair - odłożone zakończenia
+
+#ifdef _WIN32
+#define NOMINMAX                     // Wyłącz makra min/max z windows.h
+#include <windows.h>                 // CreateFile, ReadFile, CreateIoCompletionPort
+#else
+#include <fcntl.h>                   // open, O_DIRECT
+#include <sys/stat.h>                // fstat
+#include <unistd.h>                  // pread, close
+#include <cerrno>                    // EINTR
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>          // Struktury pierścieni io_uring
+#include <sys/syscall.h>             // __NR_io_uring_setup / _enter / _register
+#include <sys/mman.h>                // Mapowanie pierścieni
+#include <sys/uio.h>                 // iovec - rejestracja buforów
+#if defined(__NR_io_uring_setup)
+#define CZYTNIK_IO_URING 1
+#endif
+#endif
+#endif
+
+// Interfejs mechanizmu odczytu
+// ============================
+
+// Odczyty są zgłaszane i odbierane wyłącznie przez wątek czytnika
+class CzytnikAsynchroniczny::Mechanizm {
+public:
+    virtual ~Mechanizm() = default;
+
+    /**
+     * Otwiera plik
+     * @param bez_pamieci_podrecznej[in,out] Zerowane, gdy system plików nie pozwala pominąć pamięci podręcznej
+     * @param rozmiar[out] Rozmiar pliku
+     */
+    virtual bool otworz(const std::string& sciezka, bool& bez_pamieci_podrecznej, uint64_t& rozmiar) = 0;
+    virtual void zarejestruj(const std::vector<char*>& /*bufory*/, size_t /*rozmiar_bufora*/) {}
+    virtual std::string opis() const = 0;
+
+    virtual void zglos(size_t slot, char* cel, size_t dlugosc, uint64_t od) = 0;  // Dodaje odczyt do kolejki
+    virtual bool wyslij() = 0;                                                    // Przekazuje zgłoszenia systemowi
+    virtual bool odbierz(size_t& slot, long long& wynik) = 0;  // Czeka na zakończenie; wynik < 0 - błąd, 0 - koniec pliku
+};
+
+namespace {
+
+#ifdef _WIN32
+
+// Mechanizm Windows: ReadFile z OVERLAPPED, zakończenia odbierane z portu IOCP
+class MechanizmIOCP : public CzytnikAsynchroniczny::Mechanizm {
+public:
+    explicit MechanizmIOCP(size_t liczba_buforow) : zadania_(liczba_buforow) {}
+    ~MechanizmIOCP() override {
+        if (port_) CloseHandle(port_);
+        if (plik_ != INVALID_HANDLE_VALUE) CloseHandle(plik_);
+    }
+
+    bool otworz(const std::string& sciezka, bool& bez_pamieci_podrecznej, uint64_t& rozmiar) override {
+        const DWORD flagi = FILE_FLAG_OVERLAPPED | FILE_ATTRIBUTE_NORMAL;
+        if (bez_pamieci_podrecznej) {
+            plik_ = CreateFileA(sciezka.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                OPEN_EXISTING, flagi | FILE_FLAG_NO_BUFFERING, nullptr);
+            if (plik_ == INVALID_HANDLE_VALUE) bez_pamieci_podrecznej = false;
+        }
+        if (plik_ == INVALID_HANDLE_VALUE) {
+            plik_ = CreateFileA(sciezka.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                OPEN_EXISTING, flagi | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        }
+        if (plik_ == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER wielkosc;
+        if (!GetFileSizeEx(plik_, &wielkosc)) return false;
+        rozmiar = static_cast<uint64_t>(wielkosc.QuadPart);
+
+        port_ = CreateIoCompletionPort(plik_, nullptr, 0, 1);
+        bez_bufora_ = bez_pamieci_podrecznej;
+        return port_ != nullptr;
+    }
+
+    std::string opis() const override {
+        return bez_bufora_ ? "ReadFile OVERLAPPED + IOCP (FILE_FLAG_NO_BUFFERING)" : "ReadFile OVERLAPPED + IOCP";
+    }
+
+    void zglos(size_t slot, char* cel, size_t dlugosc, uint64_t od) override {
+        OVERLAPPED& zadanie = zadania_[slot];
+        zadanie = OVERLAPPED{};
+        zadanie.Offset = static_cast<DWORD>(od);
+        zadanie.OffsetHigh = static_cast<DWORD>(od >> 32);
+        if (!ReadFile(plik_, cel, static_cast<DWORD>(dlugosc), nullptr, &zadanie)) {
+            const DWORD kod = GetLastError();
+            // Odczyt zakończony błędem od razu nie trafia do portu - zakończenie jest odkładane tutaj
+            if (kod != ERROR_IO_PENDING) natychmiastowe_.push_back({ slot, kod == ERROR_HANDLE_EOF ? 0 : -1 });
+        }
+    }
+
+    bool wyslij() override { return true; }  // ReadFile zgłasza odczyt od razu
+
+    bool odbierz(size_t& slot, long long& wynik) override {
+        if (!natychmiastowe_.empty()) {
+            slot = natychmiastowe_.front().first;
+            wynik = natychmiastowe_.front().second;
+            natychmiastowe_.pop_front();
+            return true;
+        }
+        DWORD bajty = 0;
+        ULONG_PTR klucz = 0;
+        OVERLAPPED* zadanie = nullptr;
+        const BOOL ok = GetQueuedCompletionStatus(port_, &bajty, &klucz, &zadanie, INFINITE);
+        if (!zadanie) return false;  // Błąd samego portu
+        slot = static_cast<size_t>(zadanie - zadania_.data());
+        wynik = ok ? static_cast<long long>(bajty) : (GetLastError() == ERROR_HANDLE_EOF ? 0 : -1);
+        return true;
+    }
+
+private:
+    HANDLE plik_ = INVALID_HANDLE_VALUE;
+    HANDLE port_ = nullptr;
+    bool bez_bufora_ = false;
+    std::vector<OVERLAPPED> zadania_;                      // Jedno na bufor - adres identyfikuje slot
+    std::deque<std::pair<size_t, long long>> natychmiastowe_;
+};
+
+#else
+
+// Otwiera plik (z O_DIRECT, jeśli się da) i odczytuje jego rozmiar
+int otworz_plik(const std::string& sciezka, bool& bez_pamieci_podrecznej, uint64_t& rozmiar) {
+    int fd = -1;
+#ifdef O_DIRECT
+    if (bez_pamieci_podrecznej) fd = open(sciezka.c_str(), O_RDONLY | O_DIRECT);
+#endif
+    if (fd < 0) {
+        bez_pamieci_podrecznej = false;  // Np. tmpfs nie obsługuje O_DIRECT
+        fd = open(sciezka.c_str(), O_RDONLY);
+    }
+    if (fd < 0) return -1;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return -1;
+    }
+    rozmiar = static_cast<uint64_t>(info.st_size);
+    return fd;
+}
+
+// Mechanizm zastępczy: zwykły pread w wątku czytnika (bez równoległych odczytów)
+class MechanizmPread : public CzytnikAsynchroniczny::Mechanizm {
+public:
+    ~MechanizmPread() override {
+        if (plik_ >= 0) close(plik_);
+    }
+
+    bool otworz(const std::string& sciezka, bool& bez_pamieci_podrecznej, uint64_t& rozmiar) override {
+        plik_ = otworz_plik(sciezka, bez_pamieci_podrecznej, rozmiar);
+        bez_bufora_ = bez_pamieci_podrecznej;
+        return plik_ >= 0;
+    }
+
+    std::string opis() const override { return bez_bufora_ ? "pread (O_DIRECT)" : "pread"; }
+
+    void zglos(size_t slot, char* cel, size_t dlugosc, uint64_t od) override {
+        ssize_t wynik;
+        do {
+            wynik = pread(plik_, cel, dlugosc, static_cast<off_t>(od));
+        } while (wynik < 0 && errno == EINTR);
+        zakonczone_.push_back({ slot, static_cast<long long>(wynik) });
+    }
+
+    bool wyslij() override { return true; }
+
+    bool odbierz(size_t& slot, long long& wynik) override {
+        if (zakonczone_.empty()) return false;
+        slot = zakonczone_.front().first;
+        wynik = zakonczone_.front().second;
+        zakonczone_.pop_front();
+        return true;
+    }
+
+private:
+    int plik_ = -1;
+    bool bez_bufora_ = false;
+    std::deque<std::pair<size_t, long long>> zakonczone_;
+};
+
+#ifdef CZYTNIK_IO_URING
+
+// Mechanizm Linux: io_uring bez liburing - pierścienie zgłoszeń i zakończeń mapowane z jądra
+class MechanizmUring : public CzytnikAsynchroniczny::Mechanizm {
+public:
+    explicit MechanizmUring(size_t glebokosc) : glebokosc_(glebokosc) {}
+    ~MechanizmUring() override {
+        if (sqe_) munmap(sqe_, rozmiar_sqe_);
+        if (cq_ && cq_ != sq_) munmap(cq_, rozmiar_cq_);
+        if (sq_) munmap(sq_, rozmiar_sq_);
+        if (pierscien_ >= 0) close(pierscien_);  // Zamknięcie pierścienia czeka na odczyty w locie
+        if (plik_ >= 0) close(plik_);
+    }
+
+    bool otworz(const std::string& sciezka, bool& bez_pamieci_podrecznej, uint64_t& rozmiar) override {
+        io_uring_params parametry;
+        std::memset(&parametry, 0, sizeof(parametry));
+        pierscien_ = static_cast<int>(syscall(__NR_io_uring_setup, static_cast<unsigned>(glebokosc_), &parametry));
+        if (pierscien_ < 0) return false;  // Jądro bez io_uring lub wywołanie zablokowane
+
+        rozmiar_sq_ = parametry.sq_off.array + parametry.sq_entries * sizeof(unsigned);
+        rozmiar_cq_ = parametry.cq_off.cqes + parametry.cq_entries * sizeof(io_uring_cqe);
+        const bool jedno_mapowanie = (parametry.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (jedno_mapowanie) rozmiar_sq_ = rozmiar_cq_ = std::max(rozmiar_sq_, rozmiar_cq_);
+
+        sq_ = mapuj(rozmiar_sq_, IORING_OFF_SQ_RING);
+        if (!sq_) return false;
+        cq_ = jedno_mapowanie ? sq_ : mapuj(rozmiar_cq_, IORING_OFF_CQ_RING);
+        if (!cq_) return false;
+        rozmiar_sqe_ = parametry.sq_entries * sizeof(io_uring_sqe);
+        sqe_ = static_cast<io_uring_sqe*>(static_cast<void*>(mapuj(rozmiar_sqe_, IORING_OFF_SQES)));
+        if (!sqe_) return false;
+
+        sq_ogon_ = reinterpret_cast<unsigned*>(sq_ + parametry.sq_off.tail);
+        sq_maska_ = *reinterpret_cast<unsigned*>(sq_ + parametry.sq_off.ring_mask);
+        sq_tablica_ = reinterpret_cast<unsigned*>(sq_ + parametry.sq_off.array);
+        cq_glowa_ = reinterpret_cast<unsigned*>(cq_ + parametry.cq_off.head);
+        cq_ogon_ = reinterpret_cast<unsigned*>(cq_ + parametry.cq_off.tail);
+        cq_maska_ = *reinterpret_cast<unsigned*>(cq_ + parametry.cq_off.ring_mask);
+        cqe_ = reinterpret_cast<io_uring_cqe*>(cq_ + parametry.cq_off.cqes);
+
+        plik_ = otworz_plik(sciezka, bez_pamieci_podrecznej, rozmiar);
+        bez_bufora_ = bez_pamieci_podrecznej;
+        return plik_ >= 0;
+    }
+
+    // Bufory zarejestrowane raz - jądro nie przypina stron przy każdym odczycie (IORING_OP_READ_FIXED)
+    void zarejestruj(const std::vector<char*>& bufory, size_t rozmiar_bufora) override {
+        std::vector<iovec> wektory(bufory.size());
+        for (size_t i = 0; i < bufory.size(); ++i) wektory[i] = iovec{ bufory[i], rozmiar_bufora };
+        // Niepowodzenie (np. limit RLIMIT_MEMLOCK) - zwykłe IORING_OP_READ na tych samych buforach
+        zarejestrowane_ = syscall(__NR_io_uring_register, pierscien_, IORING_REGISTER_BUFFERS,
+            wektory.data(), static_cast<unsigned>(wektory.size())) == 0;
+    }
+
+    std::string opis() const override {
+        std::string wynik = "io_uring";
+        if (zarejestrowane_) wynik += ", bufory zarejestrowane";
+        if (bez_bufora_) wynik += ", O_DIRECT";
+        return wynik;
+    }
+
+    void zglos(size_t slot, char* cel, size_t dlugosc, uint64_t od) override {
+        const unsigned ogon = *sq_ogon_;  // Tylko wątek czytnika przesuwa ogon
+        const unsigned indeks = ogon & sq_maska_;
+        io_uring_sqe& zgloszenie = sqe_[indeks];
+        std::memset(&zgloszenie, 0, sizeof(zgloszenie));
+        zgloszenie.opcode = zarejestrowane_ ? IORING_OP_READ_FIXED : IORING_OP_READ;
+        zgloszenie.fd = plik_;
+        zgloszenie.addr = reinterpret_cast<uint64_t>(cel);
+        zgloszenie.len = static_cast<unsigned>(dlugosc);
+        zgloszenie.off = od;
+        if (zarejestrowane_) zgloszenie.buf_index = static_cast<uint16_t>(slot);
+        zgloszenie.user_data = slot;
+        sq_tablica_[indeks] = indeks;
+        __atomic_store_n(sq_ogon_, ogon + 1, __ATOMIC_RELEASE);  // Jądro widzi wpis dopiero po zapisie ogona
+        ++do_wyslania_;
+    }
+
+    bool wyslij() override {
+        while (do_wyslania_ > 0) {
+            const long wynik = syscall(__NR_io_uring_enter, pierscien_, do_wyslania_, 0u, 0u, nullptr, 0);
+            if (wynik < 0) {
+                if (errno == EINTR || errno == EAGAIN) continue;
+                return false;
+            }
+            do_wyslania_ -= static_cast<unsigned>(wynik);
+        }
+        return true;
+    }
+
+    bool odbierz(size_t& slot, long long& wynik) override {
+        while (true) {
+            const unsigned glowa = *cq_glowa_;
+            if (glowa != __atomic_load_n(cq_ogon_, __ATOMIC_ACQUIRE)) {
+                const io_uring_cqe& zakonczenie = cqe_[glowa & cq_maska_];
+                slot = static_cast<size_t>(zakonczenie.user_data);
+                wynik = zakonczenie.res;
+                __atomic_store_n(cq_glowa_, glowa + 1, __ATOMIC_RELEASE);  // Zwolnij wpis dla jądra
+                return true;
+            }
+            // Brak zakończeń - uśpij wątek do pierwszego z nich
+            if (syscall(__NR_io_uring_enter, pierscien_, 0u, 1u, IORING_ENTER_GETEVENTS, nullptr, 0) < 0
+                && errno != EINTR) return false;
+        }
+    }
+
+private:
+    char* mapuj(size_t rozmiar, long long przesuniecie) {
+        void* adres = mmap(nullptr, rozmiar, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+            pierscien_, przesuniecie);
+        return adres == MAP_FAILED ? nullptr : static_cast<char*>(adres);
+    }
+
+    size_t glebokosc_;
+    int pierscien_ = -1;
+    int plik_ = -1;
+    bool zarejestrowane_ = false;
+    bool bez_bufora_ = false;
+    unsigned do_wyslania_ = 0;
+
+    char* sq_ = nullptr;
+    char* cq_ = nullptr;
+    io_uring_sqe* sqe_ = nullptr;
+    size_t rozmiar_sq_ = 0;
+    size_t rozmiar_cq_ = 0;
+    size_t rozmiar_sqe_ = 0;
+    unsigned* sq_ogon_ = nullptr;
+    unsigned sq_maska_ = 0;
+    unsigned* sq_tablica_ = nullptr;
+    unsigned* cq_glowa_ = nullptr;
+    unsigned* cq_ogon_ = nullptr;
+    unsigned cq_maska_ = 0;
+    io_uring_cqe* cqe_ = nullptr;
+};
+
+#endif // CZYTNIK_IO_URING
+#endif // _WIN32
+
+size_t wyrownaj(size_t n) {
+    return (n + CzytnikAsynchroniczny::WYROWNANIE - 1) / CzytnikAsynchroniczny::WYROWNANIE
+        * CzytnikAsynchroniczny::WYROWNANIE;
+}
+
+} // namespace
+
+// Otwarcie i zamknięcie
+// =====================
+
+CzytnikAsynchroniczny::CzytnikAsynchroniczny(const std::string& sciezka, size_t rozmiar_fragmentu, size_t nakladka,
+    size_t glebokosc_kolejki, size_t liczba_odbiorcow, bool bez_pamieci_podrecznej)
+    : sciezka_(sciezka), rozmiar_fragmentu_(std::max<size_t>(1, rozmiar_fragmentu)), nakladka_(nakladka),
+      glebokosc_(std::max<size_t>(1, glebokosc_kolejki)) {
+    // Przesunięcia porcji (k * rozmiar_fragmentu) muszą być wyrównane, inaczej O_DIRECT odrzuci odczyt
+    bez_pamieci_podrecznej_ = bez_pamieci_podrecznej && rozmiar_fragmentu_ % WYROWNANIE == 0;
+
+    const size_t liczba_buforow_max = glebokosc_ + std::max<size_t>(1, liczba_odbiorcow);
+#ifdef _WIN32
+    odczyt_ = std::make_unique<MechanizmIOCP>(liczba_buforow_max);
+    if (!odczyt_->otworz(sciezka_, bez_pamieci_podrecznej_, rozmiar_pliku_)) return;
+#else
+#ifdef CZYTNIK_IO_URING
+    odczyt_ = std::make_unique<MechanizmUring>(glebokosc_);
+    bool bez_bufora = bez_pamieci_podrecznej_;
+    if (odczyt_->otworz(sciezka_, bez_bufora, rozmiar_pliku_)) {
+        bez_pamieci_podrecznej_ = bez_bufora;
+    } else
+#endif
+    {
+        odczyt_ = std::make_unique<MechanizmPread>();
+        if (!odczyt_->otworz(sciezka_, bez_pamieci_podrecznej_, rozmiar_pliku_)) return;
+    }
+#endif
+    otwarty_ = true;
+    liczba_porcji_ = (rozmiar_pliku_ + rozmiar_fragmentu_ - 1) / rozmiar_fragmentu_;
+
+    // Kolejka pełna + po jednym buforze w rękach każdego wątku roboczego
+    const size_t liczba_buforow = static_cast<size_t>(std::min<uint64_t>(liczba_buforow_max, liczba_porcji_));
+    rozmiar_bufora_ = wyrownaj(rozmiar_fragmentu_ + nakladka_);
+    bufory_.resize(liczba_buforow);
+    poczatki_.assign(liczba_buforow, 0);
+    ostatnie_.assign(liczba_buforow, 0);
+    std::vector<char*> adresy(liczba_buforow);
+    for (size_t i = 0; i < liczba_buforow; ++i) {
+        bufory_[i].dane = static_cast<char*>(::operator new(rozmiar_bufora_, std::align_val_t(WYROWNANIE)));
+        adresy[i] = bufory_[i].dane;
+        wolne_.push_back(i);
+    }
+    if (liczba_buforow > 0) odczyt_->zarejestruj(adresy, rozmiar_bufora_);
+    mechanizm_ = odczyt_->opis();
+
+    czytnik_ = std::thread(&CzytnikAsynchroniczny::czytaj, this);
+}
+
+CzytnikAsynchroniczny::~CzytnikAsynchroniczny() {
+    {
+        std::lock_guard<std::mutex> blokada(mutex_);
+        zatrzymaj_ = true;
+    }
+    jest_wolny_.notify_all();
+    if (czytnik_.joinable()) czytnik_.join();
+    odczyt_.reset();  // Najpierw pierścień / port, potem bufory, do których mogło jeszcze pisać jądro
+    for (Bufor& bufor : bufory_) ::operator delete(bufor.dane, std::align_val_t(WYROWNANIE));
+}
+
+// Wątek czytnika
+// ==============
+
+void CzytnikAsynchroniczny::zglos(size_t slot, uint64_t porcja) {
+    Bufor& bufor = bufory_[slot];
+    bufor.od = porcja * rozmiar_fragmentu_;
+    bufor.oczekiwane = static_cast<size_t>(std::min<uint64_t>(rozmiar_fragmentu_ + nakladka_, rozmiar_pliku_ - bufor.od));
+    bufor.wczytane = 0;
+    poczatki_[slot] = bufor.od;
+    ostatnie_[slot] = bufor.od + bufor.oczekiwane >= rozmiar_pliku_;
+    odczyt_->zglos(slot, bufor.dane,
+        bez_pamieci_podrecznej_ ? wyrownaj(bufor.oczekiwane) : bufor.oczekiwane, bufor.od);
+}
+
+void CzytnikAsynchroniczny::czytaj() {
+    using zegar = std::chrono::steady_clock;
+    const auto start = zegar::now();
+    uint64_t nastepna = 0;  // Pierwsza porcja, której odczyt nie został jeszcze zgłoszony
+    size_t w_locie = 0;
+    uint64_t urzadzenie = 0;
+    uint64_t wczytano = 0;
+    bool zatrzymany = false;
+    std::vector<size_t> do_zgloszenia;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> blokada(mutex_);
+            if (w_locie == 0) {
+                // Nic w locie - czekaj na zwolnienie bufora przez wątek roboczy
+                jest_wolny_.wait(blokada, [&] { return zatrzymaj_ || !wolne_.empty() || nastepna == liczba_porcji_; });
+            }
+            zatrzymany = zatrzymaj_;
+            while (!zatrzymany && !wolne_.empty() && w_locie + do_zgloszenia.size() < glebokosc_ && nastepna < liczba_porcji_) {
+                do_zgloszenia.push_back(wolne_.front());
+                wolne_.pop_front();
+                ++nastepna;
+            }
+        }
+        const uint64_t pierwsza = nastepna - do_zgloszenia.size();
+        for (size_t i = 0; i < do_zgloszenia.size(); ++i) zglos(do_zgloszenia[i], pierwsza + i);
+        w_locie += do_zgloszenia.size();
+        bool blad = !do_zgloszenia.empty() && !odczyt_->wyslij();
+        do_zgloszenia.clear();
+
+        if (w_locie == 0) {
+            if (zatrzymany || nastepna == liczba_porcji_) break;
+            continue;
+        }
+
+        size_t slot = 0;
+        long long wynik = 0;
+        if (blad || !odczyt_->odbierz(slot, wynik)) {
+            std::lock_guard<std::mutex> blokada(mutex_);
+            blad_ = true;
+            break;
+        }
+
+        Bufor& bufor = bufory_[slot];
+        if (wynik > 0) {
+            urzadzenie += static_cast<uint64_t>(wynik);
+            bufor.wczytane += static_cast<size_t>(wynik);
+            if (bufor.wczytane < bufor.oczekiwane) {
+                // Krótki odczyt - dokończ porcję od miejsca, w którym się zatrzymał
+                const size_t reszta = bufor.oczekiwane - bufor.wczytane;
+                odczyt_->zglos(slot, bufor.dane + bufor.wczytane,
+                    bez_pamieci_podrecznej_ ? wyrownaj(reszta) : reszta, bufor.od + bufor.wczytane);
+                if (odczyt_->wyslij()) continue;
+                wynik = -1;
+            }
+        }
+        bufor.wczytane = std::min(bufor.wczytane, bufor.oczekiwane);  // O_DIRECT czyta do pełnych bloków
+        wczytano += std::min(bufor.wczytane, rozmiar_fragmentu_);
+        --w_locie;
+        {
+            std::lock_guard<std::mutex> blokada(mutex_);
+            if (wynik < 0) blad_ = true;
+            gotowe_.push_back(slot);
+        }
+        jest_gotowy_.notify_one();
+    }
+
+    {
+        std::lock_guard<std::mutex> blokada(mutex_);
+        koniec_ = true;
+        wczytano_ = wczytano;
+        bajty_urzadzenia_ = urzadzenie;
+        czas_odczytu_ = std::chrono::duration<double>(zegar::now() - start).count();
+    }
+    jest_gotowy_.notify_all();
+}
+
+// Wątki robocze
+// =============
+
+bool CzytnikAsynchroniczny::pobierz(std::string_view& fragment, size_t& slot) {
+    if (!otwarty_) return false;  // Nieotwarty plik - wątek czytnika nie ruszył, więc koniec_ nigdy nie zostałby ustawiony
+    std::unique_lock<std::mutex> blokada(mutex_);
+    jest_gotowy_.wait(blokada, [&] { return !gotowe_.empty() || koniec_; });
+    if (gotowe_.empty()) return false;
+    slot = gotowe_.front();
+    gotowe_.pop_front();
+    fragment = std::string_view(bufory_[slot].dane, bufory_[slot].wczytane);
+    return true;
+}
+
+void CzytnikAsynchroniczny::zwolnij(size_t slot) {
+    {
+        std::lock_guard<std::mutex> blokada(mutex_);
+        wolne_.push_back(slot);
+    }
+    jest_wolny_.notify_one();
+}
+
+// Statystyki (ważne po rozdaniu wszystkich porcji)
+// ================================================
+
+uint64_t CzytnikAsynchroniczny::wczytano_bajtow() const {
+    std::lock_guard<std::mutex> blokada(mutex_);
+    return wczytano_;
+}
+
+uint64_t CzytnikAsynchroniczny::bajty_urzadzenia() const {
+    std::lock_guard<std::mutex> blokada(mutex_);
+    return bajty_urzadzenia_;
+}
+
+double CzytnikAsynchroniczny::czas_odczytu() const {
+    std::lock_guard<std::mutex> blokada(mutex_);
+    return czas_odczytu_;
+}
+
+bool CzytnikAsynchroniczny::blad() const {
+    std::lock_guard<std::mutex> blokada(mutex_);
+    return blad_;
+}
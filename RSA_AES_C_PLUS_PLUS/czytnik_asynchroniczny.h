@@ -0,0 +1,111 @@
+#pragma once               // Dyrektywa kompilatora zapobiegająca wielokrotnemu dołączaniu
+#ifndef CZYTNIK_ASYNCHRONICZNY_H  // Tradycyjne zabezpieczenie przed podwójnym include
+#define CZYTNIK_ASYNCHRONICZNY_H
+
+#include <string>              // Ścieżka pliku
+#include <string_view>         // Widok na wczytaną porcję
+#include <cstddef>             // Definicje standardowe (np. size_t)
+#include <cstdint>             // uint64_t - przesunięcia w pliku
+#include <vector>              // Stan buforów
+#include <deque>               // Kolejki numerów buforów
+#include <thread>              // Wątek zgłaszający odczyty
+#include <mutex>               // Synchronizacja czytnika i wątków roboczych
+#include <condition_variable>  // Oczekiwanie na wolny / wczytany bufor
+#include <memory>              // std::unique_ptr dla mechanizmu odczytu
+
+/**
+ * Asynchroniczne wczytywanie pliku z kolejką odczytów w locie (io_uring / IOCP / pread)
+ * @brief Wątek czytnika utrzymuje do `glebokosc_kolejki` jednoczesnych odczytów kolejnych porcji pliku
+ *        i oddaje wczytane porcje wątkom roboczym, więc dysk czyta następne porcje, gdy wcześniejsze
+ *        są skanowane. Porcja k to bajty [k * rozmiar_fragmentu, (k + 1) * rozmiar_fragmentu + nakladka) -
+ *        jak fragment z podziel_na_fragmenty - więc porcje są niezależne i mogą być gotowe w dowolnej kolejności.
+ * @details Mechanizm odczytu:
+ *          - Linux: io_uring (wywołania systemowe bez liburing), bufory zarejestrowane w jądrze
+ *            (IORING_OP_READ_FIXED - bez mapowania stron przy każdym odczycie), opcjonalnie O_DIRECT,
+ *          - Windows: ReadFile z OVERLAPPED i portem zakończeń (IOCP), opcjonalnie FILE_FLAG_NO_BUFFERING,
+ *          - w pozostałych przypadkach (brak io_uring w jądrze, blokada przez seccomp) - pread w wątku czytnika.
+ *          Odczyt z pominięciem pamięci podręcznej wymaga rozmiaru fragmentu będącego wielokrotnością 4 KB;
+ *          w przeciwnym razie (albo gdy system plików go nie obsługuje) plik jest czytany zwyczajnie.
+ */
+class CzytnikAsynchroniczny {
+public:
+    static constexpr size_t WYROWNANIE = 4096;  // Wyrównanie buforów, przesunięć i długości przy O_DIRECT
+
+    /**
+     * Otwiera plik i uruchamia wątek czytnika
+     * @param rozmiar_fragmentu Część właściwa porcji
+     * @param nakladka Bajty za częścią właściwą (długość wzorca - 1)
+     * @param glebokosc_kolejki Maksymalna liczba odczytów w locie
+     * @param liczba_odbiorcow Wątki robocze - każdy może trzymać jeden bufor, gdy kolejka jest pełna
+     * @param bez_pamieci_podrecznej true - O_DIRECT / FILE_FLAG_NO_BUFFERING
+     */
+    CzytnikAsynchroniczny(const std::string& sciezka, size_t rozmiar_fragmentu, size_t nakladka,
+        size_t glebokosc_kolejki, size_t liczba_odbiorcow, bool bez_pamieci_podrecznej);
+    ~CzytnikAsynchroniczny();  // Czeka na odczyty w locie i dołącza wątek czytnika
+
+    CzytnikAsynchroniczny(const CzytnikAsynchroniczny&) = delete;
+    CzytnikAsynchroniczny& operator=(const CzytnikAsynchroniczny&) = delete;
+
+    /**
+     * Pobiera wczytaną porcję (blokuje, dopóki któryś odczyt się nie zakończy)
+     * @return false, gdy wszystkie porcje zostały już rozdane
+     */
+    bool pobierz(std::string_view& fragment, size_t& slot);
+    void zwolnij(size_t slot);  // Oddaje bufor czytnikowi - może od razu trafić do kolejnego odczytu
+
+    uint64_t poczatek(size_t slot) const { return poczatki_[slot]; }   // Przesunięcie porcji w pliku
+    bool koniec_pliku(size_t slot) const { return ostatnie_[slot] != 0; }
+    size_t rozmiar_fragmentu() const { return rozmiar_fragmentu_; }
+
+    bool otwarty() const { return otwarty_; }
+    const std::string& mechanizm() const { return mechanizm_; }       // Np. "io_uring (bufory zarejestrowane, O_DIRECT)"
+    size_t pamiec_buforow() const { return bufory_.size() * rozmiar_bufora_; }
+    uint64_t wczytano_bajtow() const;   // Części właściwe porcji (bez nakładek) - do przepustowości skanowania
+    uint64_t bajty_urzadzenia() const;  // Wszystkie bajty odczytane z urządzenia (z nakładkami i wyrównaniem)
+    double czas_odczytu() const;        // Od pierwszego zgłoszenia do ostatniego zakończenia odczytu (s)
+    bool blad() const;                  // Któryś odczyt się nie powiódł - wynik może być niepełny
+
+    class Mechanizm;  // Interfejs mechanizmu odczytu (definicje w .cpp)
+
+private:
+    void czytaj();                          // Pętla wątku czytnika
+    void zglos(size_t slot, uint64_t porcja);  // Zgłasza odczyt porcji do bufora
+
+    // Bufor wyrównany do WYROWNANIE (O_DIRECT wymaga wyrównanego adresu)
+    struct Bufor {
+        char* dane = nullptr;
+        uint64_t od = 0;        // Przesunięcie w pliku bieżącego odczytu
+        size_t oczekiwane = 0;  // Bajty do wczytania (bez wyrównania)
+        size_t wczytane = 0;
+    };
+
+    std::string sciezka_;
+    size_t rozmiar_fragmentu_;
+    size_t nakladka_;
+    size_t glebokosc_;
+    size_t rozmiar_bufora_ = 0;
+    uint64_t rozmiar_pliku_ = 0;
+    uint64_t liczba_porcji_ = 0;
+    bool bez_pamieci_podrecznej_ = false;
+    std::string mechanizm_;
+    std::unique_ptr<Mechanizm> odczyt_;
+
+    std::vector<Bufor> bufory_;
+    std::vector<uint64_t> poczatki_;    // Przesunięcie porcji w każdym buforze
+    std::vector<char> ostatnie_;        // 1 - porcja kończy się na końcu pliku
+    std::deque<size_t> wolne_;          // Bufory gotowe do kolejnego odczytu
+    std::deque<size_t> gotowe_;         // Wczytane porcje czekające na wątek roboczy
+    uint64_t wczytano_ = 0;
+    uint64_t bajty_urzadzenia_ = 0;
+    double czas_odczytu_ = 0.0;
+    bool koniec_ = false;
+    bool blad_ = false;
+    bool zatrzymaj_ = false;
+    bool otwarty_ = false;
+    mutable std::mutex mutex_;
+    std::condition_variable jest_wolny_;
+    std::condition_variable jest_gotowy_;
+    std::thread czytnik_;
+};
+
+#endif // CZYTNIK_ASYNCHRONICZNY_H
@@ -0,0 +1,56 @@
+// Sekcja includów - dołączanie niezbędnych bibliotek
+#include "filtr_ngramow.h"  // Deklaracja filtra
+#include <algorithm>        // std::sort, std::unique, std::min
+#include <omp.h>            // Równoległa budowa streszczeń
+
+// Budowa streszczeń
+// =================
+
+// Skrót multiplikatywny 3-gramu - starsze bity iloczynu wybierają bit w zbiorze fragmentu
+uint32_t FiltrNgramow::bit(const unsigned char* p) const {
+    const uint64_t ngram = p[0] | (static_cast<uint64_t>(p[1]) << 8) | (static_cast<uint64_t>(p[2]) << 16);
+    return static_cast<uint32_t>((ngram * 0x9E3779B97F4A7C15ull) >> przesuniecie_skrotu_);
+}
+
+FiltrNgramow::FiltrNgramow(std::string_view dane, size_t rozmiar_fragmentu) {
+    if (rozmiar_fragmentu == 0 || dane.empty()) return;
+    liczba_fragmentow_ = (dane.size() + rozmiar_fragmentu - 1) / rozmiar_fragmentu;
+
+    // Około 1 bit na 4 bajty fragmentu (najmniej 4096) - streszczenia zajmują ~3% korpusu
+    size_t bity_na_fragment = 4096;
+    przesuniecie_skrotu_ = 64 - 12;
+    while (bity_na_fragment < rozmiar_fragmentu / 4 && bity_na_fragment < (1u << 24)) {
+        bity_na_fragment *= 2;
+        --przesuniecie_skrotu_;
+    }
+    slow_na_fragment_ = bity_na_fragment / 64;
+    bity_.assign(liczba_fragmentow_ * slow_na_fragment_, 0);
+
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(dane.data());
+    const long long liczba = static_cast<long long>(liczba_fragmentow_);
+#pragma omp parallel for schedule(dynamic, 4)
+    for (long long k = 0; k < liczba; ++k) {
+        uint64_t* zbior = bity_.data() + static_cast<size_t>(k) * slow_na_fragment_;
+        const size_t poczatek = static_cast<size_t>(k) * rozmiar_fragmentu;
+        const size_t koniec = std::min(poczatek + rozmiar_fragmentu + MARGINES, dane.size());  // Koniec 3-gramów
+        for (size_t p = poczatek; p + N <= koniec; ++p) {
+            const uint32_t b = bit(s + p);
+            zbior[b >> 6] |= 1ull << (b & 63);
+        }
+    }
+}
+
+// Zapytania
+// =========
+
+std::vector<uint32_t> FiltrNgramow::bity_wzorca(std::string_view wzorzec) const {
+    std::vector<uint32_t> wynik;
+    if (wzorzec.size() < N || liczba_fragmentow_ == 0) return wynik;
+
+    // Okno całych słów zaczyna się 2 bajty przed słowem, więc słowo może zacząć się do 2 bajtów za częścią właściwą
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(wzorzec.data());
+    for (size_t j = 0; j + N <= wzorzec.size() && j + 3 < MARGINES; ++j) wynik.push_back(bit(p + j));
+    std::sort(wynik.begin(), wynik.end());
+    wynik.erase(std::unique(wynik.begin(), wynik.end()), wynik.end());
+    return wynik;
+}
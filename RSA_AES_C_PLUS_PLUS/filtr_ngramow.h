@@ -0,0 +1,59 @@
+#pragma once          // Dyrektywa kompilatora zapobiegająca wielokrotnemu dołączaniu
+#ifndef FILTR_NGRAMOW_H  // Tradycyjne zabezpieczenie przed podwójnym include
+#define FILTR_NGRAMOW_H
+
+#include <string_view>  // Korpus i wzorzec
+#include <vector>       // Zbiory bitów fragmentów
+#include <cstddef>      // Definicje standardowe (np. size_t)
+#include <cstdint>      // uint64_t
+
+/**
+ * Streszczenie fragmentów korpusu: zbiór skrótów 3-gramów każdego fragmentu zapisany jako tablica bitów
+ * @brief Budowane raz na korpus i rozmiar fragmentu. Przed skanowaniem fragmentu sprawdzane są bity
+ *        3-gramów wzorca - jeśli któregoś brakuje, fragment nie może zawierać wystąpienia i jest pomijany.
+ *        Fałszywe trafienia (kolizje skrótów) powodują tylko zbędne skanowanie, nigdy pominięcie wystąpienia.
+ * @details Fragment k obejmuje 3-gramy zaczynające się w [k * rozmiar, (k + 1) * rozmiar + MARGINES),
+ *          więc sprawdzane są tylko 3-gramy wzorca leżące w pierwszych MARGINES bajtach wystąpienia
+ *          (z zapasem na okno trybu całych słów, które może zacząć się 2 bajty przed słowem).
+ *          Wzorce krótsze niż 3 bajty nie są filtrowane.
+ */
+class FiltrNgramow {
+public:
+    static constexpr size_t N = 3;            // Długość n-gramu
+    static constexpr size_t MARGINES = 64;    // Bajty za częścią właściwą objęte streszczeniem fragmentu
+
+    /**
+     * Buduje streszczenia wszystkich fragmentów (równolegle, OpenMP)
+     * @param dane Cała zawartość korpusu
+     * @param rozmiar_fragmentu Rozmiar części właściwej fragmentów - jak w podziel_na_fragmenty
+     */
+    FiltrNgramow(std::string_view dane, size_t rozmiar_fragmentu);
+
+    /**
+     * Bity 3-gramów wzorca (bez powtórzeń) - liczone raz na zapytanie
+     * @return Pusty wektor dla wzorców krótszych niż N - wtedy każdy fragment jest skanowany
+     */
+    std::vector<uint32_t> bity_wzorca(std::string_view wzorzec) const;
+
+    // Czy fragment może zawierać wystąpienie zaczynające się w jego części właściwej
+    bool moze_zawierac(size_t fragment, const std::vector<uint32_t>& bity) const {
+        const uint64_t* zbior = bity_.data() + fragment * slow_na_fragment_;
+        for (uint32_t bit : bity) {
+            if (!(zbior[bit >> 6] & (1ull << (bit & 63)))) return false;
+        }
+        return true;
+    }
+
+    size_t liczba_fragmentow() const { return liczba_fragmentow_; }
+    size_t pamiec() const { return bity_.size() * sizeof(uint64_t); }  // Rozmiar streszczeń w bajtach
+
+private:
+    uint32_t bit(const unsigned char* p) const;  // Numer bitu 3-gramu zaczynającego się w p
+
+    size_t liczba_fragmentow_ = 0;
+    size_t slow_na_fragment_ = 0;       // Słowa 64-bitowe na fragment
+    unsigned przesuniecie_skrotu_ = 0;  // 64 - log2(liczba bitów na fragment)
+    std::vector<uint64_t> bity_;        // Zbiory kolejnych fragmentów, jeden za drugim
+};
+
+#endif // FILTR_NGRAMOW_H
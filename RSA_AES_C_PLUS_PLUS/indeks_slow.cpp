@@ -0,0 +1,205 @@
+// Sekcja includów - dołączanie niezbędnych bibliotek
+#include "indeks_slow.h"           // Deklaracja indeksu
+#include "mapa_slow.h"             // Tokenizacja i mapy słów fragmentów
+#include <unordered_map>           // Scalanie list wystąpień podczas budowy
+#include <fstream>                 // Zapis pliku indeksu
+#include <filesystem>              // Podmiana pliku tymczasowego
+#include <cstring>                 // memcmp, memcpy
+#include <algorithm>               // std::min
+
+// Format pliku
+// ============
+
+// Nagłówek pliku indeksu - wszystkie sekcje mają wyrównanie 8 bajtów (format natywny, little-endian)
+struct IndeksSlow::Naglowek {
+    char magia[8];                // "INDSLOW1" - rodzaj i wersja formatu
+    uint64_t rozmiar_pliku;       // Stan korpusu, dla którego zbudowano indeks
+    int64_t modyfikacja;
+    uint64_t rozmiar_fragmentu;   // Numery fragmentów w listach wystąpień odnoszą się do tego podziału
+    uint64_t liczba_terminow;
+    uint64_t liczba_tokenow;
+    uint64_t pojemnosc;           // Liczba wpisów tablicy słownika (potęga 2, zajętość <= 50%)
+    uint64_t poczatek_tekstow;    // Przesunięcie sekcji tekstów terminów od początku pliku
+    uint64_t poczatek_wystapien;  // Przesunięcie sekcji list wystąpień
+    uint64_t rozmiar_indeksu;     // Rozmiar całego pliku - wykrywa plik obcięty przy zapisie
+};
+
+// Wpis tablicy słownika z adresowaniem otwartym (próbkowanie liniowe); dlugosc == 0 oznacza pusty wpis
+struct IndeksSlow::WpisSlownika {
+    uint64_t skrot;               // FNV-1a tekstu terminu
+    uint64_t tekst;               // Przesunięcie tekstu w sekcji tekstów
+    uint64_t liczba;              // Wszystkie wystąpienia terminu
+    uint64_t wystapienia;         // Numer pierwszej pary (fragment, liczba) w sekcji wystąpień
+    uint32_t dlugosc;             // Długość tekstu terminu w bajtach
+    uint32_t liczba_fragmentow;   // Liczba par w liście wystąpień
+};
+
+static const char MAGIA_INDEKSU[8] = { 'I', 'N', 'D', 'S', 'L', 'O', 'W', '1' };
+
+// Funkcje pomocnicze
+// ==================
+
+static size_t wyrownaj_do_8(size_t rozmiar) {
+    return (rozmiar + 7) & ~static_cast<size_t>(7);
+}
+
+// Budowa indeksu
+// ==============
+
+bool IndeksSlow::jest_slowem(std::string_view tekst) {
+    if (tekst.empty()) return false;
+    for (size_t i = 0; i < tekst.size(); ++i) {
+        if (!bajt_slowa(tekst.data(), i)) return false;
+    }
+    return true;
+}
+
+bool IndeksSlow::zbuduj(std::string_view dane, const std::vector<std::string_view>& fragmenty, size_t rozmiar_fragmentu,
+    const std::string& sciezka_indeksu, uint64_t rozmiar_pliku, int64_t modyfikacja, PulaWatkow& pula) {
+    const char* s = dane.data();
+    const size_t n = dane.size();
+
+    // Tokenizacja: każdy fragment zlicza tokeny zaczynające się w jego części właściwej (token może sięgać
+    // za fragment - korpus jest w całości w pamięci). Klucze to widoki na korpus - bez alokacji na token.
+    std::vector<MapaSlow> lokalne(fragmenty.size(), MapaSlow(64));
+    pula.wykonaj(fragmenty.size(), [&](size_t zadanie, size_t) {
+        const size_t poczatek = static_cast<size_t>(fragmenty[zadanie].data() - s);
+        zlicz_slowa(dane, poczatek, std::min(poczatek + rozmiar_fragmentu, n), lokalne[zadanie]);
+    });
+
+    // Scalanie w kolejności fragmentów - listy wystąpień są od razu posortowane
+    struct Termin {
+        uint64_t liczba = 0;
+        std::vector<WystapieniaWeFragmencie> wystapienia;
+    };
+    std::unordered_map<std::string_view, Termin> terminy;
+    uint64_t liczba_tokenow = 0;
+    for (size_t k = 0; k < lokalne.size(); ++k) {
+        for (const auto& wpis : lokalne[k].wpisy()) {
+            if (!wpis.tekst) continue;
+            Termin& termin = terminy[std::string_view(wpis.tekst, wpis.dlugosc)];
+            termin.liczba += wpis.liczba;
+            termin.wystapienia.push_back({ static_cast<uint32_t>(k), static_cast<uint32_t>(wpis.liczba) });
+            liczba_tokenow += wpis.liczba;
+        }
+        lokalne[k] = MapaSlow(0);  // Zwolnij pamięć od razu
+    }
+
+    // Układ pliku: nagłówek, tablica słownika, teksty terminów, listy wystąpień
+    uint64_t pojemnosc = 16;
+    while (pojemnosc < 2 * terminy.size()) pojemnosc *= 2;
+    std::vector<WpisSlownika> slownik(pojemnosc, WpisSlownika{});
+    std::string teksty;
+    std::vector<WystapieniaWeFragmencie> wystapienia;
+    for (const auto& [slowo, termin] : terminy) {
+        WpisSlownika wpis{};
+        wpis.skrot = skrot_slowa(slowo);
+        wpis.tekst = teksty.size();
+        wpis.liczba = termin.liczba;
+        wpis.wystapienia = wystapienia.size();
+        wpis.dlugosc = static_cast<uint32_t>(slowo.size());
+        wpis.liczba_fragmentow = static_cast<uint32_t>(termin.wystapienia.size());
+        teksty.append(slowo);
+        wystapienia.insert(wystapienia.end(), termin.wystapienia.begin(), termin.wystapienia.end());
+
+        uint64_t indeks = wpis.skrot & (pojemnosc - 1);
+        while (slownik[indeks].dlugosc != 0) indeks = (indeks + 1) & (pojemnosc - 1);
+        slownik[indeks] = wpis;
+    }
+
+    Naglowek naglowek{};
+    memcpy(naglowek.magia, MAGIA_INDEKSU, sizeof(MAGIA_INDEKSU));
+    naglowek.rozmiar_pliku = rozmiar_pliku;
+    naglowek.modyfikacja = modyfikacja;
+    naglowek.rozmiar_fragmentu = rozmiar_fragmentu;
+    naglowek.liczba_terminow = terminy.size();
+    naglowek.liczba_tokenow = liczba_tokenow;
+    naglowek.pojemnosc = pojemnosc;
+    naglowek.poczatek_tekstow = sizeof(Naglowek) + pojemnosc * sizeof(WpisSlownika);
+    naglowek.poczatek_wystapien = wyrownaj_do_8(naglowek.poczatek_tekstow + teksty.size());
+    naglowek.rozmiar_indeksu = naglowek.poczatek_wystapien + wystapienia.size() * sizeof(WystapieniaWeFragmencie);
+
+    // Zapis do pliku tymczasowego i podmiana - przerwany zapis nie zostawia uszkodzonego indeksu
+    const std::string tymczasowy = sciezka_indeksu + ".tmp";
+    {
+        std::ofstream plik(tymczasowy, std::ios::binary | std::ios::trunc);
+        if (!plik) return false;
+        teksty.resize(naglowek.poczatek_wystapien - naglowek.poczatek_tekstow, '\0');  // Wyrównanie sekcji wystąpień
+        plik.write(reinterpret_cast<const char*>(&naglowek), sizeof(naglowek));
+        plik.write(reinterpret_cast<const char*>(slownik.data()), static_cast<std::streamsize>(slownik.size() * sizeof(WpisSlownika)));
+        plik.write(teksty.data(), static_cast<std::streamsize>(teksty.size()));
+        plik.write(reinterpret_cast<const char*>(wystapienia.data()), static_cast<std::streamsize>(wystapienia.size() * sizeof(WystapieniaWeFragmencie)));
+        if (!plik) return false;
+    }
+    std::error_code blad;
+    std::filesystem::rename(tymczasowy, sciezka_indeksu, blad);
+    return !blad;
+}
+
+// Zapytania
+// =========
+
+bool IndeksSlow::otworz(const std::string& sciezka_indeksu, uint64_t rozmiar_pliku, int64_t modyfikacja) {
+    naglowek_ = nullptr;
+    slownik_ = nullptr;
+    plik_ = MapowanyPlik(sciezka_indeksu);
+    const std::string_view dane = plik_.dane();
+    const Naglowek* naglowek = reinterpret_cast<const Naglowek*>(dane.data());
+    const bool poprawny = dane.size() >= sizeof(Naglowek)
+        && memcmp(naglowek->magia, MAGIA_INDEKSU, sizeof(MAGIA_INDEKSU)) == 0
+        && naglowek->rozmiar_indeksu == dane.size()
+        && naglowek->pojemnosc != 0 && (naglowek->pojemnosc & (naglowek->pojemnosc - 1)) == 0
+        && naglowek->poczatek_tekstow == sizeof(Naglowek) + naglowek->pojemnosc * sizeof(WpisSlownika)
+        && naglowek->poczatek_tekstow <= naglowek->poczatek_wystapien
+        && naglowek->poczatek_wystapien <= dane.size();
+    if (!poprawny || naglowek->rozmiar_pliku != rozmiar_pliku || naglowek->modyfikacja != modyfikacja) {
+        // Inny plik, uszkodzony indeks albo zmieniony korpus - zwolnij mapowanie, bo wywołujący
+        // zbuduje indeks od nowa, a otwartego pliku nie da się podmienić na Windows
+        plik_ = MapowanyPlik();
+        return false;
+    }
+
+    naglowek_ = naglowek;
+    slownik_ = reinterpret_cast<const WpisSlownika*>(dane.data() + sizeof(Naglowek));
+    return true;
+}
+
+const IndeksSlow::WpisSlownika* IndeksSlow::znajdz(std::string_view slowo) const {
+    if (!naglowek_ || slowo.empty()) return nullptr;
+    const char* dane = plik_.dane().data();
+    const uint64_t skrot = skrot_slowa(slowo);
+    const uint64_t maska = naglowek_->pojemnosc - 1;
+    for (uint64_t indeks = skrot & maska;; indeks = (indeks + 1) & maska) {  // Tablica ma zawsze wolne wpisy
+        const WpisSlownika& wpis = slownik_[indeks];
+        if (wpis.dlugosc == 0) return nullptr;
+        if (wpis.skrot == skrot && wpis.dlugosc == slowo.size()
+            && naglowek_->poczatek_tekstow + wpis.tekst + wpis.dlugosc <= naglowek_->poczatek_wystapien
+            && memcmp(dane + naglowek_->poczatek_tekstow + wpis.tekst, slowo.data(), slowo.size()) == 0) {
+            return &wpis;
+        }
+    }
+}
+
+uint64_t IndeksSlow::liczba(std::string_view slowo) const {
+    const WpisSlownika* wpis = znajdz(slowo);
+    return wpis ? wpis->liczba : 0;
+}
+
+std::vector<WystapieniaWeFragmencie> IndeksSlow::wystapienia(std::string_view slowo) const {
+    const WpisSlownika* wpis = znajdz(slowo);
+    if (!wpis) return {};
+    const std::string_view dane = plik_.dane();
+    const uint64_t poczatek = naglowek_->poczatek_wystapien + wpis->wystapienia * sizeof(WystapieniaWeFragmencie);
+    if (poczatek + wpis->liczba_fragmentow * sizeof(WystapieniaWeFragmencie) > dane.size()) return {};
+    std::vector<WystapieniaWeFragmencie> wynik(wpis->liczba_fragmentow);
+    memcpy(wynik.data(), dane.data() + poczatek, wynik.size() * sizeof(WystapieniaWeFragmencie));
+    return wynik;
+}
+
+uint64_t IndeksSlow::liczba_terminow() const {
+    return naglowek_ ? naglowek_->liczba_terminow : 0;
+}
+
+uint64_t IndeksSlow::liczba_tokenow() const {
+    return naglowek_ ? naglowek_->liczba_tokenow : 0;
+}
@@ -0,0 +1,73 @@
+#pragma once          // Dyrektywa kompilatora zapobiegająca wielokrotnemu dołączaniu
+#ifndef INDEKS_SLOW_H    // Tradycyjne zabezpieczenie przed podwójnym include
+#define INDEKS_SLOW_H
+
+#include <string>              // Biblioteka do obsługi ciągów znaków (std::string)
+#include <string_view>         // Widoki na słowa i fragmenty
+#include <vector>              // Lista fragmentów i wystąpień
+#include <cstddef>             // Definicje standardowe (np. size_t)
+#include <cstdint>             // Typy o stałej szerokości w formacie pliku
+#include "wczytywanie_pliku.h" // MapowanyPlik - indeks jest czytany bez kopiowania
+#include "pula_watkow.h"       // Równoległa tokenizacja fragmentów
+
+// Liczba wystąpień słowa w jednym fragmencie korpusu (lista wystąpień terminu)
+struct WystapieniaWeFragmencie {
+    uint32_t fragment;  // Numer fragmentu z podziel_na_fragmenty
+    uint32_t liczba;    // Wystąpienia słowa zaczynające się w tym fragmencie
+};
+
+/**
+ * Trwały indeks odwrócony słów korpusu (plik obok korpusu, mapowany w pamięci)
+ * @brief Słowo (token) to maksymalny ciąg liter/cyfr ASCII i 2-bajtowych liter UTF-8 - te same znaki słowa,
+ *        co w trybie całych słów, więc liczba(slowo) jest równa wynikowi licz_cale_slowa dla poprawnego UTF-8.
+ *        Plik zawiera nagłówek z rozmiarem i czasem modyfikacji korpusu, słownik terminów w postaci tablicy
+ *        z adresowaniem otwartym, teksty terminów oraz listy (fragment, liczba) dla każdego terminu.
+ *        Zapytanie to jedno wyszukanie w tablicy zmapowanego pliku - mikrosekundy zamiast skanowania korpusu.
+ */
+class IndeksSlow {
+public:
+    IndeksSlow() = default;
+
+    IndeksSlow(const IndeksSlow&) = delete;
+    IndeksSlow& operator=(const IndeksSlow&) = delete;
+
+    /**
+     * Tokenizuje korpus równolegle i zapisuje indeks
+     * @param dane Cała zawartość korpusu
+     * @param fragmenty Fragmenty z podziel_na_fragmenty - token należy do fragmentu, w którym się zaczyna
+     * @param rozmiar_fragmentu Rozmiar części właściwej fragmentów (zapisywany w nagłówku)
+     * @param sciezka_indeksu Plik wynikowy - zapisywany pod nazwą tymczasową i podmieniany po zapisaniu całości
+     * @param rozmiar_pliku, modyfikacja Stan korpusu, dla którego indeks jest ważny
+     * @param pula Pula wątków tokenizujących fragmenty
+     * @return false, gdy nie udało się zapisać pliku
+     */
+    static bool zbuduj(std::string_view dane, const std::vector<std::string_view>& fragmenty, size_t rozmiar_fragmentu,
+        const std::string& sciezka_indeksu, uint64_t rozmiar_pliku, int64_t modyfikacja, PulaWatkow& pula);
+
+    /**
+     * Mapuje plik indeksu
+     * @return false, gdy pliku nie ma, jest uszkodzony albo opisuje inny stan korpusu (rozmiar / czas modyfikacji)
+     */
+    bool otworz(const std::string& sciezka_indeksu, uint64_t rozmiar_pliku, int64_t modyfikacja);
+
+    uint64_t liczba(std::string_view slowo) const;                                      // Wystąpienia słowa (0 - brak w słowniku)
+    std::vector<WystapieniaWeFragmencie> wystapienia(std::string_view slowo) const;     // Lista wystąpień we fragmentach
+    uint64_t liczba_terminow() const;                                                   // Różne słowa w korpusie
+    uint64_t liczba_tokenow() const;                                                    // Wszystkie słowa w korpusie
+    bool otwarty() const { return naglowek_ != nullptr; }
+
+    // Czy tekst jest pojedynczym słowem w rozumieniu indeksu (inaczej trzeba skanować korpus)
+    static bool jest_slowem(std::string_view tekst);
+
+private:
+    struct Naglowek;
+    struct WpisSlownika;
+
+    const WpisSlownika* znajdz(std::string_view slowo) const;  // Wpis słownika lub nullptr
+
+    MapowanyPlik plik_;
+    const Naglowek* naglowek_ = nullptr;
+    const WpisSlownika* slownik_ = nullptr;
+};
+
+#endif // INDEKS_SLOW_H
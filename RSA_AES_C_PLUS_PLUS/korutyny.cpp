@@ -0,0 +1,118 @@
+// Sekcja includów - dołączanie niezbędnych bibliotek
+#include "korutyny.h"  // Deklaracje wykonawcy, semafora i usługi odczytu
+#include <memory>      // std::unique_ptr dla wspólnego wykonawcy
+
+// Wykonawca
+// =========
+
+static thread_local size_t numer_watku_wykonawcy = SIZE_MAX;
+
+Wykonawca::Wykonawca(size_t liczba_watkow) {
+    if (liczba_watkow == 0) liczba_watkow = 1;
+    for (size_t id = 0; id < liczba_watkow; ++id) watki_.emplace_back(&Wykonawca::petla, this, id);
+}
+
+Wykonawca::~Wykonawca() {
+    {
+        std::lock_guard<std::mutex> blokada(mutex_);
+        zatrzymaj_ = true;
+    }
+    jest_gotowa_.notify_all();
+    for (auto& t : watki_) t.join();
+}
+
+void Wykonawca::wznow(std::coroutine_handle<> korutyna) {
+    {
+        std::lock_guard<std::mutex> blokada(mutex_);
+        gotowe_.push_back(korutyna);
+    }
+    jest_gotowa_.notify_one();
+}
+
+size_t Wykonawca::numer_watku() {
+    return numer_watku_wykonawcy;
+}
+
+Wykonawca& Wykonawca::wspolny(size_t liczba_watkow) {
+    static std::mutex mutex;
+    static std::unique_ptr<Wykonawca> wykonawca;
+    std::lock_guard<std::mutex> blokada(mutex);
+    if (liczba_watkow == 0) liczba_watkow = 1;
+    if (!wykonawca || wykonawca->liczba_watkow() != liczba_watkow) {
+        wykonawca.reset();  // Najpierw zatrzymaj stare wątki
+        wykonawca = std::make_unique<Wykonawca>(liczba_watkow);
+    }
+    return *wykonawca;
+}
+
+void Wykonawca::petla(size_t id) {
+    numer_watku_wykonawcy = id;
+    for (;;) {
+        std::coroutine_handle<> korutyna;
+        {
+            std::unique_lock<std::mutex> blokada(mutex_);
+            jest_gotowa_.wait(blokada, [&] { return zatrzymaj_ || !gotowe_.empty(); });
+            if (zatrzymaj_) return;
+            korutyna = gotowe_.front();
+            gotowe_.pop_front();
+        }
+        korutyna.resume();  // Do następnego co_await albo końca korutyny
+    }
+}
+
+// Semafor
+// =======
+
+void SemaforKorutyn::zwolnij() {
+    std::coroutine_handle<> nastepna;
+    {
+        std::lock_guard<std::mutex> blokada(mutex_);
+        if (czekajace_.empty()) {
+            ++wolne_;
+            return;
+        }
+        nastepna = czekajace_.front();  // Miejsce przechodzi na czekającą bez zwiększania wolne_
+        czekajace_.pop_front();
+    }
+    wykonawca_.wznow(nastepna);
+}
+
+// Usługa odczytu
+// ==============
+
+UslugaOdczytu::UslugaOdczytu(Wykonawca& wykonawca, size_t liczba_watkow) : wykonawca_(wykonawca) {
+    if (liczba_watkow == 0) liczba_watkow = 1;
+    for (size_t i = 0; i < liczba_watkow; ++i) watki_.emplace_back(&UslugaOdczytu::petla, this);
+}
+
+UslugaOdczytu::~UslugaOdczytu() {
+    {
+        std::lock_guard<std::mutex> blokada(mutex_);
+        zatrzymaj_ = true;
+    }
+    jest_zgloszenie_.notify_all();
+    for (auto& t : watki_) t.join();
+}
+
+void UslugaOdczytu::zglos(Zgloszenie* zgloszenie) {
+    // Powiadomienie pod blokadą: odczyt może się zakończyć, a ostatnia korutyna - zwolnić wywołującego,
+    // który niszczy usługę, zanim ten wątek wyszedłby z notify_one() wywołanego po zwolnieniu blokady
+    std::lock_guard<std::mutex> blokada(mutex_);
+    kolejka_.push_back(zgloszenie);
+    jest_zgloszenie_.notify_one();
+}
+
+void UslugaOdczytu::petla() {
+    for (;;) {
+        Zgloszenie* zgloszenie;
+        {
+            std::unique_lock<std::mutex> blokada(mutex_);
+            jest_zgloszenie_.wait(blokada, [&] { return zatrzymaj_ || !kolejka_.empty(); });
+            if (kolejka_.empty()) return;  // Zatrzymanie dopiero po obsłużeniu zgłoszeń - korutyny czekają na wznowienie
+            zgloszenie = kolejka_.front();
+            kolejka_.pop_front();
+        }
+        zgloszenie->wczytane = zgloszenie->plik->odczytaj(zgloszenie->od, zgloszenie->cel, zgloszenie->ile);
+        wykonawca_.wznow(zgloszenie->korutyna);  // Po tym zgłoszenie może już nie istnieć
+    }
+}
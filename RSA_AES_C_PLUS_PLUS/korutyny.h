@@ -0,0 +1,183 @@
+#pragma once        // Dyrektywa kompilatora zapobiegająca wielokrotnemu dołączaniu
+#ifndef KORUTYNY_H  // Tradycyjne zabezpieczenie przed podwójnym include
+#define KORUTYNY_H
+
+#include <cstddef>             // Definicje standardowe (np. size_t)
+#include <cstdint>             // uint64_t - przesunięcie odczytu
+#include <coroutine>           // std::coroutine_handle, std::suspend_never (C++20)
+#include <vector>              // Wątki wykonawcy i usługi odczytu
+#include <deque>               // Kolejki gotowych korutyn i odczytów
+#include <thread>              // Wątki robocze
+#include <mutex>               // Ochrona kolejek
+#include <condition_variable>  // Budzenie wątków
+#include <exception>           // std::terminate
+#include "wczytywanie_pliku.h" // PlikPozycyjny - odczyt zakresu pliku
+
+/**
+ * Korutyna uruchamiana i zapominana - ramka zwalnia się sama po co_return
+ * @brief Wywołujący czeka na koniec przez własny licznik (np. std::latch zmniejszany na końcu ciała),
+ *        więc typ nie przechowuje wyniku ani kontynuacji. Wyjątek w ciele kończy program - jądra zliczające
+ *        nie zgłaszają wyjątków, a przerwana korutyna nigdy nie zmniejszyłaby licznika.
+ */
+struct KorutynaWolna {
+    struct promise_type {
+        KorutynaWolna get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }  // Ciało rusza od razu - pierwszy co_await przenosi je do wykonawcy
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+/**
+ * Stała liczba wątków wznawiających korutyny z jednej kolejki gotowych
+ * @brief Korutyna nie blokuje wątku: czekając na odczyt albo miejsce, zawiesza się, a wątek bierze kolejną
+ *        gotową korutynę. Tysiące zapytań (pliki x słowa x fragmenty) dzielą więc kilka wątków.
+ */
+class Wykonawca {
+public:
+    explicit Wykonawca(size_t liczba_watkow);
+    ~Wykonawca();  // Zatrzymuje i dołącza wątki (korutyny w kolejce nie są wznawiane)
+
+    Wykonawca(const Wykonawca&) = delete;
+    Wykonawca& operator=(const Wykonawca&) = delete;
+
+    void wznow(std::coroutine_handle<> korutyna);  // Dodaje korutynę do kolejki gotowych
+
+    // co_await wykonawca.przejdz() - dalsza część korutyny wykona się na wątku wykonawcy
+    auto przejdz() {
+        struct Oczekiwanie {
+            Wykonawca& wykonawca;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> korutyna) { wykonawca.wznow(korutyna); }
+            void await_resume() const noexcept {}
+        };
+        return Oczekiwanie{ *this };
+    }
+
+    size_t liczba_watkow() const { return watki_.size(); }
+    static size_t numer_watku();  // Numer bieżącego wątku wykonawcy (0..liczba_watkow-1); SIZE_MAX poza wykonawcą
+
+    // Wykonawca współdzielony przez wszystkie wywołania - tworzony od nowa tylko przy zmianie liczby wątków
+    static Wykonawca& wspolny(size_t liczba_watkow);
+
+private:
+    void petla(size_t id);
+
+    std::vector<std::thread> watki_;
+    std::deque<std::coroutine_handle<>> gotowe_;
+    bool zatrzymaj_ = false;
+    std::mutex mutex_;
+    std::condition_variable jest_gotowa_;
+};
+
+/**
+ * Semafor, na którym korutyna czeka bez blokowania wątku (co_await semafor.zajmij())
+ * @brief Miejsce zwolnione przy czekających przechodzi od razu na najstarszą z nich, wznawianą przez
+ *        wykonawcę - ogranicza liczbę fragmentów w toku (bufory w pamięci), a nie liczbę wątków.
+ */
+class SemaforKorutyn {
+public:
+    SemaforKorutyn(Wykonawca& wykonawca, size_t miejsca) : wykonawca_(wykonawca), wolne_(miejsca) {}
+
+    auto zajmij() {
+        struct Oczekiwanie {
+            SemaforKorutyn& semafor;
+            bool await_ready() const noexcept { return false; }
+            bool await_suspend(std::coroutine_handle<> korutyna) {
+                std::lock_guard<std::mutex> blokada(semafor.mutex_);
+                if (semafor.wolne_ > 0) {
+                    --semafor.wolne_;
+                    return false;  // Wolne miejsce - korutyna działa dalej bez zawieszania
+                }
+                semafor.czekajace_.push_back(korutyna);
+                return true;
+            }
+            void await_resume() const noexcept {}
+        };
+        return Oczekiwanie{ *this };
+    }
+
+    void zwolnij();
+
+private:
+    Wykonawca& wykonawca_;
+    size_t wolne_;
+    std::deque<std::coroutine_handle<>> czekajace_;
+    std::mutex mutex_;
+};
+
+/**
+ * Licznik korutyn w toku - wywołujący (spoza wykonawcy) czeka, aż wszystkie zgłoszą koniec
+ * @note Powiadomienie pod blokadą: wywołujący może zniszczyć licznik zaraz po czekaj(), a ostatnia
+ *       korutyna nie dotyka go już po zwolnieniu blokady
+ */
+class LicznikZakonczen {
+public:
+    explicit LicznikZakonczen(size_t liczba) : pozostale_(liczba) {}
+
+    void zakoncz() {
+        std::lock_guard<std::mutex> blokada(mutex_);
+        if (--pozostale_ == 0) wszystkie_.notify_all();
+    }
+    void czekaj() {
+        std::unique_lock<std::mutex> blokada(mutex_);
+        wszystkie_.wait(blokada, [&] { return pozostale_ == 0; });
+    }
+
+private:
+    size_t pozostale_;
+    std::mutex mutex_;
+    std::condition_variable wszystkie_;
+};
+
+/**
+ * Odczyty zakresów pliku wykonywane przez osobne wątki - korutyna czeka na nie przez co_await
+ * @brief Wątek wykonawcy nigdy nie czeka na dysk: zgłoszenie trafia do kolejki usługi, a po odczycie
+ *        korutyna wraca do kolejki gotowych wykonawcy. Liczba wątków usługi to liczba odczytów w locie.
+ */
+class UslugaOdczytu {
+public:
+    UslugaOdczytu(Wykonawca& wykonawca, size_t liczba_watkow);
+    ~UslugaOdczytu();
+
+    UslugaOdczytu(const UslugaOdczytu&) = delete;
+    UslugaOdczytu& operator=(const UslugaOdczytu&) = delete;
+
+    // size_t wczytane = co_await usluga.odczytaj(plik, od, cel, ile) - liczba wczytanych bajtów (0 przy błędzie)
+    auto odczytaj(const PlikPozycyjny& plik, uint64_t od, char* cel, size_t ile) {
+        struct Oczekiwanie {
+            UslugaOdczytu& usluga;
+            Zgloszenie zgloszenie;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> korutyna) {
+                zgloszenie.korutyna = korutyna;
+                usluga.zglos(&zgloszenie);  // Oczekiwanie żyje w ramce zawieszonej korutyny do wznowienia
+            }
+            size_t await_resume() const noexcept { return zgloszenie.wczytane; }
+        };
+        return Oczekiwanie{ *this, Zgloszenie{ &plik, od, cel, ile, 0, {} } };
+    }
+
+private:
+    struct Zgloszenie {
+        const PlikPozycyjny* plik = nullptr;
+        uint64_t od = 0;
+        char* cel = nullptr;
+        size_t ile = 0;
+        size_t wczytane = 0;
+        std::coroutine_handle<> korutyna;
+    };
+
+    void zglos(Zgloszenie* zgloszenie);
+    void petla();
+
+    Wykonawca& wykonawca_;
+    std::vector<std::thread> watki_;
+    std::deque<Zgloszenie*> kolejka_;
+    bool zatrzymaj_ = false;
+    std::mutex mutex_;
+    std::condition_variable jest_zgloszenie_;
+};
+
+#endif // KORUTYNY_H
@@ -1,345 +1,2096 @@
-// Sekcja includw - doczanie niezbdnych bibliotek
-#include "liczenie_slow.h"  // Nasz wasny nagwek z deklaracjami funkcji i struktur
-#include <iostream>         // Operacje wejcia/wyjcia (cout, cin)
-#include <fstream>          // Operacje na plikach (ifstream)
-#include <vector>           // Kontener vector do przechowywania fragmentw
-#include <string>           // Klasa string do obsugi napisw
-#include <thread>           // Biblioteka wtkw (std::thread)
-#include <chrono>           // Pomiar czasu (high_resolution_clock)
-#include <omp.h>            // Biblioteka OpenMP do rwnolegoci
-#include <string_view>      // Lekka reprezentacja fragmentw stringw
-#include <windows.h>        // Funkcje specyficzne dla Windows
-#include <psapi.h>          // API do monitorowania zasobw systemowych
-
-#pragma comment(lib, "psapi.lib")  // Linkowanie z bibliotek psapi
-
-// Stae kontrolujce prac programu
-constexpr size_t ROZMIAR_FRAGMENTU = 2 * 1024 * 1024; // Rozmiar fragmentu pliku (2MB)
-constexpr size_t OVERLAP_SIZE = 256;  // Rozmiar nakadki midzy fragmentami (zapobiega przeoczeniu sw na granicach)
-
-// Struktura przechowujca preprocesowane informacje dla algorytmu KMP
-struct KMP_Preprocessed {
-    std::vector<int> lps;    // Tablica najduszych prefiksw-sufiksw (Longest Prefix Suffix)
-    std::string pattern;     // Szukany wzorzec (sowo)
-};
-
-// Funkcje pomocnicze do monitorowania zasobw (Windows-specific)
-// =============================================================
-
-// Zwraca czas CPU zuyty przez proces w sekundach
-static double get_cpu_time() {
-    FILETIME createTime, exitTime, kernelTime, userTime;
-    if (GetProcessTimes(GetCurrentProcess(), &createTime, &exitTime, &kernelTime, &userTime)) {
-        ULARGE_INTEGER user, kernel;
-        user.LowPart = userTime.dwLowDateTime;
-        user.HighPart = userTime.dwHighDateTime;
-        kernel.LowPart = kernelTime.dwLowDateTime;
-        kernel.HighPart = kernelTime.dwHighDateTime;
-        return (user.QuadPart + kernel.QuadPart) * 1e-7; // Konwersja 100-nanosekundowych jednostek na sekundy
-    }
-    return 0.0;
-}
-
-// Zwraca zuycie pamici prywatnej procesu w bajtach
-static size_t get_memory_usage() {
-    PROCESS_MEMORY_COUNTERS_EX pmc;
-    if (GetProcessMemoryInfo(GetCurrentProcess(), (PROCESS_MEMORY_COUNTERS*)&pmc, sizeof(pmc))) {
-        return pmc.PrivateUsage;  // Pami prywatna alokowana przez proces
-    }
-    return 0;
-}
-
-
-// Funkcje pomocnicze do przetwarzania plikw
-// ==========================================
-
-// Odczytuje ca zawarto pliku do pojedynczego stringa
-std::string odczytaj_caly_plik(const std::string& sciezka) {
-    std::ifstream file(sciezka, std::ios::binary | std::ios::ate);  // Otwrz plik od koca
-    if (!file) return "";  // Bd otwarcia pliku
-
-    std::streamsize size = file.tellg();  // Pobierz rozmiar pliku
-    file.seekg(0, std::ios::beg);         // Przewi na pocztek
-
-    std::string buffer(size, '\0');       // Alokuj bufor na cay plik
-    file.read(buffer.data(), size);       // Wczytaj ca zawarto
-    return buffer;
-}
-
-// Dzieli bufor na fragmenty z nakadkami (overlap)
-std::vector<std::string_view> podziel_na_fragmenty(const std::string& buffer) {
-    std::vector<std::string_view> fragmenty;
-    size_t poz = 0;
-    while (poz < buffer.size()) {
-        // Oblicz zakres fragmentu z uwzgldnieniem nakadki
-        size_t start = (poz > OVERLAP_SIZE) ? (poz - OVERLAP_SIZE) : 0;
-        size_t end = min(poz + ROZMIAR_FRAGMENTU, buffer.size());
-        fragmenty.emplace_back(buffer.data() + start, end - start);// Dodaj widok fragmentu (bez kopiowania danych)
-        poz = end;// Przesu pozycj koca fragmentu
-    }
-    return fragmenty;
-}
-
-// Implementacja algorytmu KMP (Knuth-Morris-Pratt)
-// ================================================
-
-// Przygotowuje struktur KMP dla zadanego wzorca
-
-KMP_Preprocessed przygotuj_wzorzec(const std::string& slowo) {
-    KMP_Preprocessed result;
-    result.pattern = slowo;
-    size_t m = slowo.size();
-    result.lps.resize(m, 0);// Inicjalizacja tablicy LPS zerami
-
-    // Budowa tablicy LPS
-    for (size_t i = 1, len = 0; i < m;) {
-        if (slowo[i] == slowo[len]) {
-            result.lps[i++] = ++len;// Dopasowanie - zwiksz dugo prefiksu
-        }
-        else {
-            if (len != 0) len = result.lps[len - 1];// Cofnij si w tablicy LPS
-            else result.lps[i++] = 0;// Brak dopasowania - zerujemy
-        }
-    }
-    return result;
-}
-
-// Zlicza wystpienia wzorca we fragmencie tekstu uywajc KMP
-int liczba_slow_we_fragmencie(std::string_view fragment, const KMP_Preprocessed& wzorzec) {
-    if (wzorzec.pattern.empty()) return 0;  // Zabezpieczenie przed pustym wzorcem
-
-    int count = 0;  // Licznik wystpie
-    const size_t m = wzorzec.pattern.size();
-    const size_t n = fragment.size();
-    size_t i = 0, j = 0;  // Indeksy dla tekstu (i) i wzorca (j)
-
-    while (i < n) {
-        if (wzorzec.pattern[j] == fragment[i]) {// Dopasowanie znakw
-            ++i;
-            ++j;
-        }
-
-        if (j == m) {// Cae sowo dopasowane
-            ++count;
-            j = wzorzec.lps[j - 1];// Kontynuuj szukanie od pozycji w LPS
-        }
-        else if (i < n && wzorzec.pattern[j] != fragment[i]) {
-            // Brak dopasowania - wykorzystaj tablic LPS do optymalnego przesunicia
-            j ? j = wzorzec.lps[j - 1] : ++i;
-        }
-    }
-    return count;
-}
-
-// Implementacje rnych wersji zliczania
-// ======================================
-
-// Wersja sekwencyjna
-Metrics liczba_slow_sekwencyjny(const std::string& sciezka_pliku, const std::string& slowo) {
-    // Rozpocznij pomiary
-    auto start_cpu = get_cpu_time();
-    auto start_time = std::chrono::high_resolution_clock::now();
-    size_t start_mem = get_memory_usage();
-
-    // Gwne przetwarzanie
-    std::string buffer = odczytaj_caly_plik(sciezka_pliku);
-    auto fragmenty = podziel_na_fragmenty(buffer);
-    auto wzorzec = przygotuj_wzorzec(slowo);
-
-    int total = 0;
-    for (const auto& fragment : fragmenty) {// Przetwarzaj fragment po fragmencie
-        total += liczba_slow_we_fragmencie(fragment, wzorzec);
-    }
-
-    // Zakocz pomiary
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto end_cpu = get_cpu_time();
-    size_t end_mem = get_memory_usage();
-
-    // Oblicz metryki
-    double czas = std::chrono::duration<double>(end_time - start_time).count();
-    SYSTEM_INFO sysInfo;
-    GetSystemInfo(&sysInfo);
-    int num_cpus = sysInfo.dwNumberOfProcessors;  // Pobierz liczb rdzeni
-
-    double cpu_usage = (end_cpu - start_cpu) / (czas * num_cpus) * 100.0;  // Uwzgldnij liczb rdzeni
-    size_t ram_usage = end_mem - start_mem;
-
-    return { total, czas, cpu_usage, ram_usage };
-}
-
-// Wersja z uyciem std::thread
-Metrics liczba_slow_Thread(const std::string& sciezka_pliku, const std::string& slowo, int liczba_watkow) {
-    // Rozpocznij pomiary
-    auto start_cpu = get_cpu_time();
-    auto start_time = std::chrono::high_resolution_clock::now();
-    size_t start_mem = get_memory_usage();
-
-    // Przygotuj dane
-    std::string buffer = odczytaj_caly_plik(sciezka_pliku);
-    auto fragmenty = podziel_na_fragmenty(buffer);
-    auto wzorzec = przygotuj_wzorzec(slowo);
-
-    // Inicjalizacja struktur dla wtkw
-    std::vector<std::thread> watki;
-    std::vector<int> wyniki(liczba_watkow, 0);// Wyniki czstkowe
-    const size_t frag_na_watek = (fragmenty.size() + liczba_watkow - 1) / liczba_watkow;// Podzia pracy
-
-    // Funkcja robocza dla wtkw
-    auto worker = [&](int id) {
-        size_t start = id * frag_na_watek;
-        size_t end = min(start + frag_na_watek, fragmenty.size());
-        int local_count = 0;
-
-        for (size_t i = start; i < end; ++i) {// Przetwarzaj przypisane fragmenty
-            local_count += liczba_slow_we_fragmencie(fragmenty[i], wzorzec);
-        }
-        wyniki[id] = local_count;// Zapisz wynik czstkowy
-        };
-
-    // Uruchom wtki
-    for (int i = 0; i < liczba_watkow; ++i) {
-        watki.emplace_back(worker, i);  // Kady wtek dostaje swj ID
-    }
-
-    // Czekaj na zakoczenie wtkw
-    for (auto& t : watki) {
-        t.join();
-    }
-
-    // Sumuj wyniki
-    int total = 0;
-    for (int x : wyniki) {
-        total += x;
-    }
-
-    // Zakocz pomiary
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto end_cpu = get_cpu_time();
-    size_t end_mem = get_memory_usage();
-
-    // Oblicz metryki
-    double czas = std::chrono::duration<double>(end_time - start_time).count();
-
-    SYSTEM_INFO sysInfo;
-    GetSystemInfo(&sysInfo);
-    int num_cpus = sysInfo.dwNumberOfProcessors;  // Pobierz liczb rdzeni
-
-    double cpu_usage = (end_cpu - start_cpu) / (czas * num_cpus) * 100.0;  // Uwzgldnij liczb rdzeni
-    size_t ram_usage = end_mem - start_mem;
-
-    return { total, czas, cpu_usage, ram_usage };
-}
-
-// Wersja z uyciem OpenMP
-Metrics liczba_slow_OpenMP(const std::string& sciezka_pliku, const std::string& slowo, int liczba_watkow) {
-    // Rozpocznij pomiary
-    auto start_cpu = get_cpu_time();
-    auto start_time = std::chrono::high_resolution_clock::now();
-    size_t start_mem = get_memory_usage();
-
-    // Przygotuj dane
-    std::string buffer = odczytaj_caly_plik(sciezka_pliku);
-    auto fragmenty = podziel_na_fragmenty(buffer);
-    auto wzorzec = przygotuj_wzorzec(slowo);
-
-    int total = 0;
-    omp_set_num_threads(liczba_watkow);// Ustaw liczb wtkw
-
-    // Rwnolega ptla z redukcj wyniku
-#pragma omp parallel for reduction(+:total) schedule(static, 10)
-    for (int i = 0; i < static_cast<int>(fragmenty.size()); ++i) {
-        total += liczba_slow_we_fragmencie(fragmenty[i], wzorzec);
-    }
-
-    // Zakocz pomiary
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto end_cpu = get_cpu_time();
-    size_t end_mem = get_memory_usage();
-
-    // Oblicz metryki
-    double czas = std::chrono::duration<double>(end_time - start_time).count();
-
-    SYSTEM_INFO sysInfo;
-    GetSystemInfo(&sysInfo);
-    int num_cpus = sysInfo.dwNumberOfProcessors;  // Pobierz liczb rdzeni
-
-    double cpu_usage = (end_cpu - start_cpu) / (czas * num_cpus) * 100.0;  // Uwzgldnij liczb rdzeni
-    size_t ram_usage = end_mem - start_mem;
-
-    return { total, czas, cpu_usage, ram_usage };
-}
-
-// Gwna funkcja interfejsu uytkownika
-// =====================================
-
-void liczenie_slow() {
-    // Ustawienie kodowania UTF-8 dla konsoli
-    system("chcp 65001");
-
-    // Pobierz dane od uytkownika
-    std::string nazwa_uzytkownika;
-    std::cout << "Podaj nazwe uzytkownika: ";
-    std::cin >> nazwa_uzytkownika;
-
-    int liczba_watkow;
-    std::cout << "Podaj ilosc watkow: ";
-    std::cin >> liczba_watkow;
-
-    int liczba_slow;
-    std::cout << "Podaj ilosc slow do sprawdzenia: ";
-    std::cin >> liczba_slow;
-
-    std::vector<std::string> slowa(liczba_slow);
-    for (int i = 0; i < liczba_slow; ++i) {
-        std::cout << "Podaj " << i + 1 << ". slowo: ";
-        std::cin >> slowa[i];
-    }
-
-    // Skonstruuj pen ciek do pliku
-    std::string sciezka_pliku;
-    std::cout << "Podaj sciezke do pliku: ";
-    std::cin >> sciezka_pliku;
-    sciezka_pliku = "C:\\Users\\" + nazwa_uzytkownika + "\\Desktop\\" + sciezka_pliku;
-
-    // Zmienne do podsumowania
-    int total_seq = 0, total_thr = 0, total_omp = 0;
-    double time_seq = 0, time_thr = 0, time_omp = 0;
-    double cpu_seq = 0, cpu_thr = 0, cpu_omp = 0;
-    size_t ram_seq = 0, ram_thr = 0, ram_omp = 0;
-
-    for (const auto& slowo : slowa) {
-        // Wywoaj wszystkie implementacje
-        auto result_seq = liczba_slow_sekwencyjny(sciezka_pliku, slowo);
-        auto result_thr = liczba_slow_Thread(sciezka_pliku, slowo, liczba_watkow);
-        auto result_omp = liczba_slow_OpenMP(sciezka_pliku, slowo, liczba_watkow);
-
-        // Wywietl wyniki dla biecego sowa
-        std::cout << "\nSlowo: " << slowo
-            << "\nSekwencyjnie: " << result_seq.count << " (czas: " << result_seq.czas << "s, CPU: " << result_seq.cpu_usage << "%, RAM: " << result_seq.ram_usage << " B)"
-            << "\nThreading: " << result_thr.count << " (czas: " << result_thr.czas << "s, CPU: " << result_thr.cpu_usage << "%, RAM: " << result_thr.ram_usage << " B)"
-            << "\nOpenMP: " << result_omp.count << " (czas: " << result_omp.czas << "s, CPU: " << result_omp.cpu_usage << "%, RAM: " << result_omp.ram_usage << " B)\n";
-
-        // Aktualizuj statystyki podsumowujce
-        total_seq += result_seq.count;
-        total_thr += result_thr.count;
-        total_omp += result_omp.count;
-
-        time_seq += result_seq.czas;
-        time_thr += result_thr.czas;
-        time_omp += result_omp.czas;
-
-        cpu_seq += result_seq.cpu_usage;
-        cpu_thr += result_thr.cpu_usage;
-        cpu_omp += result_omp.cpu_usage;
-
-        ram_seq += result_seq.ram_usage;
-        ram_thr += result_thr.ram_usage;
-        ram_omp += result_omp.ram_usage;
-    }
-    // Wywietl podsumowanie globalne
-    std::cout << "\nPodsumowanie:"
-        << "\nSekwencyjnie: " << total_seq << " (czas: " << time_seq << "s, rednie CPU: " << cpu_seq / slowa.size() << "%, RAM: " << ram_seq << " B)"
-        << "\nThreading: " << total_thr << " (czas: " << time_thr << "s, rednie CPU: " << cpu_thr / slowa.size() << "%, RAM: " << ram_thr << " B)"
-        << "\nOpenMP: " << total_omp << " (czas: " << time_omp << "s, rednie CPU: " << cpu_omp / slowa.size() << "%, RAM: " << ram_omp << " B)\n";
-}
+// Sekcja includów - dołączanie niezbędnych bibliotek
+#include "liczenie_slow.h"  // Nasz własny nagłówek z deklaracjami funkcji i struktur
+#include "wczytywanie_pliku.h"  // Mapowanie pliku w pamięci (mmap / MapViewOfFile), pliki katalogu
+#include "silniki_wyszukiwania.h"  // Wektorowe jądro wyszukiwania (AVX2/SSE2)
+#include "aho_corasick.h"  // Automat zliczający wiele słów w jednym przebiegu
+#include "pula_watkow.h"   // Pula wątków z podkradaniem zadań
+#include "indeks_slow.h"   // Trwały indeks słów dla powtarzanych zapytań
+#include "mapa_slow.h"     // Mapy słów z adresowaniem otwartym (histogram)
+#include "filtr_ngramow.h" // Pomijanie fragmentów bez 3-gramów słowa
+#include "wyrazenia_regularne.h"  // Tryb wyrażeń regularnych (leniwy DFA)
+#include "czytnik_asynchroniczny.h"  // Kolejka odczytów w locie (io_uring / IOCP)
+#include "topologia_numa.h"  // Węzły NUMA (statystyki węzłów, opis), strony bez dotykania
+#include "pozycje_dopasowan.h"  // Bufory pozycji wątków i strumień różnic varint
+#include "backendy_rownolegle.h"  // Modele wykonania wersji zliczania słowo po słowie
+#include "korutyny.h"       // Wykonawca korutyn, semafor i usługa odczytu (C++20)
+#include "zasoby_systemowe.h"  // Pomiar czasu CPU, pamięci i liczników jądra (Linux / Windows)
+#include <iostream>         // Operacje wejścia/wyjścia (cout, cin)
+#include <fstream>          // Operacje na plikach (ifstream)
+#include <vector>           // Kontener vector do przechowywania fragmentów
+#include <string>           // Klasa string do obsługi napisów
+#include <thread>           // Biblioteka wątków (std::thread)
+#include <chrono>           // Pomiar czasu (high_resolution_clock)
+#include <omp.h>            // Biblioteka OpenMP do równoległości
+#include <string_view>      // Lekka reprezentacja fragmentów stringów
+#include <memory>           // std::unique_ptr dla strumienia
+#include <cstdint>          // SIZE_MAX
+#include <sstream>          // Opis wyboru silnika
+#include <iomanip>          // std::setprecision
+#include <map>              // Pamięć podręczna korpusów i podziałów na fragmenty
+#include <tuple>            // Klucz pamięci podręcznej korpusów
+#include <atomic>           // Błąd odczytu w wątkach wczytujących korpus NUMA
+#include <mutex>            // Ochrona pamięci podręcznej
+#include <filesystem>       // Rozmiar i czas modyfikacji pliku (klucz pamięci podręcznej)
+#include <algorithm>        // std::partial_sort (najczęstsze słowa), std::sort (pliki katalogu)
+#include <cmath>            // std::sqrt - odchylenie standardowe mikrobenchmarku, std::ldexp - próg gęstości
+#include <set>              // Pliki wielu zapytań korutyn (bajty każdego pliku liczone raz)
+
+// Struktura przechowująca preprocesowane informacje dla algorytmu KMP
+struct KMP_Preprocessed {
+    std::vector<int> lps;    // Tablica najdłuższych prefiksów-sufiksów (Longest Prefix Suffix)
+    std::string pattern;     // Szukany wzorzec (słowo)
+    SilnikWyszukiwania silnik = SilnikWyszukiwania::KMP;  // Jądro używane przez liczba_slow_we_fragmencie
+    std::vector<uint32_t> przesuniecia;  // Tablica przesunięć Horspoola (tylko silnik Horspool)
+    std::string opis;        // Nazwa silnika (i uzasadnienie wyboru automatycznego) do Metrics::silnik
+    bool cale_slowa = false; // Tylko wystąpienia będące całym słowem (licz_cale_slowa zamiast silnika)
+    bool bez_diakrytykow = false;  // Bez rozróżniania wielkości liter i znaków diakrytycznych (licz_bez_diakrytykow)
+    std::string zlozony;     // Wzorzec po zloz_znaki() - tylko w trybie bez diakrytyków
+    std::shared_ptr<const WyrazenieRegularne> wyrazenie;  // Tylko silnik Regex - skompilowany wzorzec
+};
+
+// Funkcje pomocnicze do przetwarzania plików
+// ==========================================
+
+// Odczytuje całą zawartość pliku do pojedynczego stringa
+std::string odczytaj_caly_plik(const std::string& sciezka) {
+    std::ifstream file(sciezka, std::ios::binary | std::ios::ate);  // Otwórz plik od końca
+    if (!file) return "";  // Błąd otwarcia pliku
+
+    std::streamsize size = file.tellg();  // Pobierz rozmiar pliku
+    file.seekg(0, std::ios::beg);         // Przewiń na początek
+
+    std::string buffer(size, '\0');       // Alokuj bufor na cały plik
+    file.read(buffer.data(), size);       // Wczytaj całą zawartość
+    return buffer;
+}
+
+// Zawartość pliku przygotowana do skanowania - kopia w std::string, kopia rozmieszczona na węzłach NUMA albo mapowanie pliku
+struct DaneKorpusu {
+    std::string bufor;      // Używany w trybie CalyPlik
+    PamiecStron strony;     // Używany w trybie CalyPlik z rozmieszczeniem NUMA
+    MapowanyPlik mapowanie; // Używany w trybie Mmap
+
+    // Widok na zawartość niezależnie od trybu
+    std::string_view dane() const {
+        if (mapowanie.otwarty()) return mapowanie.dane();
+        if (strony.dane()) return std::string_view(strony.dane(), strony.rozmiar());
+        return std::string_view(bufor);
+    }
+
+    // Podział na fragmenty dla danej nakładki i rozmiaru - liczony raz i współdzielony przez wszystkie wersje
+    const std::vector<std::string_view>& fragmenty(size_t dlugosc_wzorca, size_t rozmiar_fragmentu) const;
+
+    // Streszczenia 3-gramów fragmentów danego rozmiaru - budowane przy pierwszym użyciu, niezależne od nakładki
+    const FiltrNgramow& filtr(size_t rozmiar_fragmentu) const;
+
+private:
+    mutable std::mutex mutex_podzialow;
+    mutable std::map<std::pair<size_t, size_t>, std::vector<std::string_view>> podzialy;  // (nakładka, rozmiar) -> fragmenty
+    mutable std::map<size_t, std::unique_ptr<FiltrNgramow>> filtry;                     // rozmiar -> streszczenia
+};
+
+// Dzieli bufor na fragmenty z nakładkami (overlap)
+// Każdy fragment obejmuje rozmiar_fragmentu bajtów części właściwej oraz nakładkę dlugosc_wzorca - 1
+// bajtów z początku następnego fragmentu. Dopasowanie zaczynające się w części właściwej mieści się
+// w całości we fragmencie, a dopasowanie zaczynające się dalej już nie - każde wystąpienie jest więc
+// liczone dokładnie raz, w fragmencie, w którym się zaczyna, niezależnie od rozmiaru fragmentu.
+std::vector<std::string_view> podziel_na_fragmenty(std::string_view buffer, size_t dlugosc_wzorca, size_t rozmiar_fragmentu) {
+    std::vector<std::string_view> fragmenty;
+    if (rozmiar_fragmentu == 0) rozmiar_fragmentu = ROZMIAR_FRAGMENTU;  // Zabezpieczenie przed pętlą nieskończoną
+    const size_t nakladka = dlugosc_wzorca ? dlugosc_wzorca - 1 : 0;
+
+    for (size_t poz = 0; poz < buffer.size(); poz += rozmiar_fragmentu) {
+        size_t end = std::min(poz + rozmiar_fragmentu + nakladka, buffer.size());  // Część właściwa + nakładka
+        fragmenty.emplace_back(buffer.data() + poz, end - poz);// Dodaj widok fragmentu (bez kopiowania danych)
+    }
+    return fragmenty;
+}
+
+const std::vector<std::string_view>& DaneKorpusu::fragmenty(size_t dlugosc_wzorca, size_t rozmiar_fragmentu) const {
+    if (rozmiar_fragmentu == 0) rozmiar_fragmentu = ROZMIAR_FRAGMENTU;
+    const size_t nakladka = dlugosc_wzorca ? dlugosc_wzorca - 1 : 0;  // Słowa o tej samej długości dzielą podział
+    std::lock_guard<std::mutex> blokada(mutex_podzialow);
+    auto it = podzialy.find({ nakladka, rozmiar_fragmentu });
+    if (it == podzialy.end()) {
+        it = podzialy.emplace(std::make_pair(nakladka, rozmiar_fragmentu), podziel_na_fragmenty(dane(), nakladka + 1, rozmiar_fragmentu)).first;
+    }
+    return it->second;  // Elementy std::map nie zmieniają adresu przy dodawaniu kolejnych
+}
+
+const FiltrNgramow& DaneKorpusu::filtr(size_t rozmiar_fragmentu) const {
+    if (rozmiar_fragmentu == 0) rozmiar_fragmentu = ROZMIAR_FRAGMENTU;
+    std::lock_guard<std::mutex> blokada(mutex_podzialow);
+    auto& wynik = filtry[rozmiar_fragmentu];
+    if (!wynik) wynik = std::make_unique<FiltrNgramow>(dane(), rozmiar_fragmentu);
+    return *wynik;
+}
+
+// Pamięć podręczna korpusów
+// =========================
+
+// Wpis pamięci podręcznej - korpus jest ważny, dopóki plik ma ten sam rozmiar i czas modyfikacji
+struct WpisKorpusu {
+    uintmax_t rozmiar = 0;
+    std::filesystem::file_time_type modyfikacja;
+    std::shared_ptr<const DaneKorpusu> korpus;
+};
+
+static std::mutex mutex_korpusow;
+// (ścieżka, mmap, rozmiar fragmentu i liczba wątków rozmieszczenia NUMA - 0, 0 bez niego) -> korpus
+static std::map<std::tuple<std::string, bool, size_t, int>, WpisKorpusu> pamiec_korpusow;
+
+// Czy korpus wersji z liczba_watkow wątkami jest rozmieszczany na węzłach NUMA
+static bool rozmieszczenie_numa(const OpcjeSkanowania& opcje, int liczba_watkow) {
+    return opcje.numa && opcje.wczytywanie == TrybWczytywania::CalyPlik && liczba_watkow > 1;
+}
+
+// Wczytuje plik do stron bez dotykania na puli NUMA - fragment i (bez nakładki) zapisuje wątek, który dostał
+// zadanie i, więc jego strony trafiają do pamięci węzła tego wątku. Skanowanie rozdziela zadania tymi samymi
+// ciągłymi blokami (pula i OpenMP w trybie NUMA), więc każdy wątek czyta fragmenty z pamięci swojego węzła.
+static bool wczytaj_na_wezlach(DaneKorpusu& korpus, const std::string& sciezka, size_t rozmiar_fragmentu, int liczba_watkow) {
+    PlikPozycyjny plik(sciezka);
+    if (!plik.otwarty() || plik.rozmiar() == 0) return false;
+    korpus.strony = PamiecStron(static_cast<size_t>(plik.rozmiar()));
+    if (!korpus.strony.dane()) return false;
+
+    if (rozmiar_fragmentu == 0) rozmiar_fragmentu = ROZMIAR_FRAGMENTU;
+    const size_t liczba = static_cast<size_t>((plik.rozmiar() + rozmiar_fragmentu - 1) / rozmiar_fragmentu);
+    std::atomic<bool> blad{ false };
+    PulaWatkow::wspolna(static_cast<size_t>(liczba_watkow), true).wykonaj(liczba, [&](size_t i, size_t) {
+        const uint64_t od = static_cast<uint64_t>(i) * rozmiar_fragmentu;
+        const size_t ile = static_cast<size_t>(std::min<uint64_t>(rozmiar_fragmentu, plik.rozmiar() - od));
+        if (plik.odczytaj(od, korpus.strony.dane() + od, ile) != ile) blad = true;
+        });
+    if (blad) korpus.strony = PamiecStron();  // Plik zmienił się w trakcie - dane() nie może zwrócić niepełnej kopii
+    return !blad;
+}
+
+// Wczytuje plik zgodnie z wybranym trybem - przy włączonej pamięci podręcznej tylko raz na wszystkie
+// wersje, słowa i wywołania (ponownie dopiero po zmianie rozmiaru lub czasu modyfikacji pliku)
+static std::shared_ptr<const DaneKorpusu> wczytaj_korpus(const std::string& sciezka, const OpcjeSkanowania& opcje, int liczba_watkow = 1) {
+    const bool numa = rozmieszczenie_numa(opcje, liczba_watkow);
+    auto wczytaj = [&] {
+        auto korpus = std::make_shared<DaneKorpusu>();
+        if (opcje.wczytywanie == TrybWczytywania::Mmap) {
+            korpus->mapowanie = MapowanyPlik(sciezka, opcje.wstepne_wczytanie);  // Fragmenty wskażą bezpośrednio na strony pliku
+        }
+        else if (numa && wczytaj_na_wezlach(*korpus, sciezka, opcje.rozmiar_fragmentu, liczba_watkow)) {
+            // Strony rozmieszczone przez wątki, które będą je skanować
+        }
+        else {
+            korpus->bufor = odczytaj_caly_plik(sciezka);
+        }
+        return std::shared_ptr<const DaneKorpusu>(std::move(korpus));
+    };
+    if (!opcje.pamiec_podreczna) return wczytaj();
+
+    std::error_code blad;
+    const uintmax_t rozmiar = std::filesystem::file_size(sciezka, blad);
+    const auto modyfikacja = std::filesystem::last_write_time(sciezka, blad);
+    if (blad) return wczytaj();  // Brak pliku - nie zapamiętuj pustego korpusu
+
+    std::lock_guard<std::mutex> blokada(mutex_korpusow);
+    WpisKorpusu& wpis = pamiec_korpusow[{ sciezka, opcje.wczytywanie == TrybWczytywania::Mmap,
+        numa ? opcje.rozmiar_fragmentu : 0, numa ? liczba_watkow : 0 }];
+    if (!wpis.korpus || wpis.rozmiar != rozmiar || wpis.modyfikacja != modyfikacja) {
+        wpis.korpus.reset();  // Zwolnij nieaktualną kopię przed wczytaniem nowej
+        wpis.korpus = wczytaj();
+        wpis.rozmiar = rozmiar;
+        wpis.modyfikacja = modyfikacja;
+    }
+    return wpis.korpus;
+}
+
+// Korpus podzielony na fragmenty, przygotowany przed pomiarem obliczeń
+struct PrzygotowanyKorpus {
+    std::shared_ptr<const DaneKorpusu> dane;               // Puste w trybie strumieniowym
+    const std::vector<std::string_view>* fragmenty = nullptr;
+    const FiltrNgramow* filtr = nullptr;                   // Tylko przy OpcjeSkanowania::filtr_ngramow
+    double czas_wczytywania = 0.0;                         // Wczytanie + podział (prawie 0 przy trafieniu w pamięć podręczną)
+};
+
+// Wczytuje i dzieli korpus poza pomiarem obliczeń, żeby czas wersji nie zawierał odczytu z dysku.
+// W trybie strumieniowym nic nie robi - tam czytanie z założenia przeplata się z obliczeniami.
+static PrzygotowanyKorpus przygotuj_korpus(const std::string& sciezka, size_t dlugosc_wzorca, const OpcjeSkanowania& opcje,
+    int liczba_watkow = 1) {
+    PrzygotowanyKorpus wynik;
+    if (opcje.wczytywanie == TrybWczytywania::Strumieniowy) return wynik;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    wynik.dane = wczytaj_korpus(sciezka, opcje, liczba_watkow);
+    wynik.fragmenty = &wynik.dane->fragmenty(dlugosc_wzorca, opcje.rozmiar_fragmentu);
+    if (opcje.filtr_ngramow && !opcje.bez_diakrytykow && opcje.silnik != SilnikWyszukiwania::Regex) wynik.filtr = &wynik.dane->filtr(opcje.rozmiar_fragmentu);  // Składanie zmienia bajty - 3-gramy nie pasują
+    wynik.czas_wczytywania = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    return wynik;
+}
+
+// Długość najdłuższego słowa - wyznacza nakładkę fragmentów w trybie wielu słów
+static size_t najdluzsze_slowo(const std::vector<std::string>& slowa) {
+    size_t wynik = 0;
+    for (const auto& slowo : slowa) {
+        if (slowo.size() > wynik) wynik = slowo.size();
+    }
+    return wynik;
+}
+
+// Dobór silnika wyszukiwania
+// ==========================
+
+// Próbka pliku do statystyk bajtów - 4 porcje po 16 KB z równo rozłożonych miejsc,
+// żeby nagłówek pliku nie zdominował statystyk. Tylko dla silnika automatycznego.
+// Pobierana przed pomiarem: z korpusu w pamięci, a w trybach czytających plik w trakcie skanowania - z dysku;
+// czas trafia do kolumny wczytywania.
+static std::string probka_korpusu(const std::string& sciezka, const OpcjeSkanowania& opcje, PrzygotowanyKorpus& korpus) {
+    if (opcje.silnik != SilnikWyszukiwania::Automatyczny || opcje.bez_diakrytykow) return "";
+    constexpr size_t PORCJA = 16 * 1024;
+    constexpr size_t LICZBA_PORCJI = 4;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::string probka;
+    if (korpus.dane) {
+        const std::string_view dane = korpus.dane->dane();
+        for (size_t i = 0; i < LICZBA_PORCJI; ++i) {
+            size_t poczatek = dane.size() / LICZBA_PORCJI * i;
+            probka.append(dane.substr(poczatek, PORCJA));
+        }
+    }
+    else {
+        std::ifstream plik(sciezka, std::ios::binary | std::ios::ate);
+        if (!plik) return "";
+        const size_t rozmiar = static_cast<size_t>(plik.tellg());
+        for (size_t i = 0; i < LICZBA_PORCJI; ++i) {
+            size_t poczatek = rozmiar / LICZBA_PORCJI * i;
+            size_t dlugosc = std::min(PORCJA, rozmiar - poczatek);
+            size_t stary = probka.size();
+            probka.resize(stary + dlugosc);
+            plik.seekg(poczatek);
+            plik.read(&probka[stary], dlugosc);
+        }
+    }
+    korpus.czas_wczytywania += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    return probka;
+}
+
+// Nazwa silnika do raportów
+static std::string nazwa_silnika(SilnikWyszukiwania silnik) {
+    switch (silnik) {
+    case SilnikWyszukiwania::SIMD: return std::string("SIMD (") + nazwa_simd(wykryj_simd()) + ")";
+    case SilnikWyszukiwania::Horspool: return "Horspool";
+    case SilnikWyszukiwania::Bajt: return std::string("Bajt (") + nazwa_simd(wykryj_simd()) + ")";
+    case SilnikWyszukiwania::Regex: return "Wyrazenie regularne (leniwy DFA)";
+    default: return "KMP";
+    }
+}
+
+// Wybiera silnik na podstawie długości wzorca i częstości bajtów w próbce pliku.
+// Koszt każdego silnika jest szacowany w przybliżonych cyklach na bajt tekstu (stałe zmierzone na x64):
+//  - KMP: kilka cykli na każdy bajt (pętla z nieprzewidywalnymi skokami),
+//  - SIMD: blok (16/32 bajty) na kilka instrukcji + weryfikacja kandydatów (~10 cykli), których odsetek to
+//    częstość pierwszego bajtu wzorca razy częstość ostatniego,
+//  - Horspool: ~10 cykli na okno (błędne przewidywanie skoku), a okno przesuwa się średnio
+//    o sumę częstość(bajt) * przesunięcie(bajt) - wygrywa z SIMD tylko przy bardzo długich wzorcach.
+// Opis zawiera oszacowania, żeby można było sprawdzić heurystykę na własnych danych.
+static SilnikWyszukiwania wybierz_silnik(const std::string& slowo, std::string_view probka, std::string& opis) {
+    const size_t m = slowo.size();
+    if (m <= 1) {  // Jeden znak - zliczanie bajtu bez weryfikacji kandydatów
+        opis = nazwa_silnika(SilnikWyszukiwania::Bajt) + " [auto: wzorzec 1-bajtowy]";
+        return SilnikWyszukiwania::Bajt;
+    }
+
+    // Częstości bajtów z wygładzeniem - pusta próbka daje rozkład równomierny
+    size_t histogram[256] = {};
+    for (unsigned char c : probka) ++histogram[c];
+    double czestosc[256];
+    for (int c = 0; c < 256; ++c) czestosc[c] = (histogram[c] + 1.0) / (probka.size() + 256.0);
+    auto f = [&](char c) { return czestosc[static_cast<unsigned char>(c)]; };
+
+    const double koszt_kmp = 5.0;
+
+    const PoziomSIMD poziom = wykryj_simd();
+    double koszt_simd;
+    if (poziom == PoziomSIMD::Skalarny) {
+        koszt_simd = 0.1 + f(slowo[0]) * 10.0;  // memchr zatrzymuje się na każdym pierwszym bajcie
+    }
+    else {
+        const double szerokosc = (poziom == PoziomSIMD::AVX2) ? 32.0 : 16.0;
+        koszt_simd = 2.0 / szerokosc + f(slowo[0]) * f(slowo[m - 1]) * 10.0;
+    }
+
+    const auto przesuniecia = tablica_horspool(slowo);
+    double srednie_przesuniecie = 0.0;
+    for (int c = 0; c < 256; ++c) srednie_przesuniecie += czestosc[c] * przesuniecia[c];
+    const double koszt_horspool = 10.0 / srednie_przesuniecie;
+
+    SilnikWyszukiwania wybor = SilnikWyszukiwania::KMP;
+    double najmniejszy = koszt_kmp;
+    if (koszt_simd < najmniejszy) { wybor = SilnikWyszukiwania::SIMD; najmniejszy = koszt_simd; }
+    if (koszt_horspool < najmniejszy) { wybor = SilnikWyszukiwania::Horspool; najmniejszy = koszt_horspool; }
+
+    std::ostringstream tekst;
+    tekst << std::fixed << std::setprecision(3) << nazwa_silnika(wybor)
+        << " [auto: szac. cykli/B KMP " << koszt_kmp << ", SIMD " << koszt_simd << ", Horspool " << koszt_horspool
+        << "; sr. przesuniecie " << std::setprecision(1) << srednie_przesuniecie << "; probka " << probka.size() << " B]";
+    opis = tekst.str();
+    return wybor;
+}
+
+// Implementacja algorytmu KMP (Knuth-Morris-Pratt)
+// ================================================
+
+// Przygotowuje wzorzec dla wybranego silnika (tablica LPS jest budowana zawsze - KMP jest silnikiem odniesienia)
+// probka - fragment pliku do statystyk bajtów, używany tylko przez silnik automatyczny
+// cale_slowa - granice słów sprawdza wektorowe jądro licz_cale_slowa, niezależnie od wybranego silnika
+// bez_diakrytykow - wzorzec jest składany, a zlicza jądro licz_bez_diakrytykow (również z całymi słowami)
+// Silnik Regex kompiluje słowo jako wyrażenie regularne (oba tryby są wtedy ignorowane); niepoprawne
+// wyrażenie daje pusty wzorzec (0 wystąpień) i opis błędu w Metrics::silnik
+KMP_Preprocessed przygotuj_wzorzec(const std::string& slowo, SilnikWyszukiwania silnik, std::string_view probka = {},
+    bool cale_slowa = false, bool bez_diakrytykow = false) {
+    KMP_Preprocessed result;
+    result.pattern = slowo;
+    if (silnik == SilnikWyszukiwania::Regex) {
+        std::string blad;
+        result.silnik = silnik;
+        result.wyrazenie = WyrazenieRegularne::kompiluj(slowo, blad);
+        if (!result.wyrazenie) {
+            result.pattern.clear();
+            result.opis = "Niepoprawne wyrazenie regularne: " + blad;
+            return result;
+        }
+        result.opis = result.wyrazenie->opis();
+        return result;
+    }
+    result.cale_slowa = cale_slowa;
+    result.bez_diakrytykow = bez_diakrytykow;
+    if (bez_diakrytykow) {
+        silnik = SilnikWyszukiwania::SIMD;
+        result.zlozony = zloz_znaki(slowo);
+        result.opis = std::string("Bez diakrytykow \"") + result.zlozony + "\" (" + nazwa_simd(wykryj_simd()) + (cale_slowa ? ", cale slowa)" : ")");
+    }
+    else if (cale_slowa) {
+        silnik = SilnikWyszukiwania::SIMD;
+        result.opis = std::string("Cale slowa (") + nazwa_simd(wykryj_simd()) + ")";
+    }
+    else if (silnik == SilnikWyszukiwania::Automatyczny) {
+        silnik = wybierz_silnik(slowo, probka, result.opis);
+    }
+    else {
+        if (silnik == SilnikWyszukiwania::Bajt && slowo.size() != 1) silnik = SilnikWyszukiwania::SIMD;  // Bajt obsługuje tylko jeden znak
+        result.opis = nazwa_silnika(silnik);
+    }
+    result.silnik = silnik;
+    if (silnik == SilnikWyszukiwania::Horspool && !slowo.empty()) result.przesuniecia = tablica_horspool(slowo);
+    size_t m = slowo.size();
+    result.lps.resize(m, 0);// Inicjalizacja tablicy LPS zerami
+
+    // Budowa tablicy LPS
+    for (size_t i = 1, len = 0; i < m;) {
+        if (slowo[i] == slowo[len]) {
+            result.lps[i++] = ++len;// Dopasowanie - zwiększ długość prefiksu
+        }
+        else {
+            if (len != 0) len = result.lps[len - 1];// Cofnij się w tablicy LPS
+            else result.lps[i++] = 0;// Brak dopasowania - zerujemy
+        }
+    }
+    return result;
+}
+
+// Zlicza wystąpienia wzorca we fragmencie tekstu używając KMP (lub silnika wybranego w przygotuj_wzorzec)
+// polozenie - gdzie w pliku leży fragment; potrzebne tylko w trybach całych słów i bez diakrytyków
+// pozycje - opcjonalnie: początki policzonych wystąpień względem początku fragmentu, rosnąco
+// Wynik jest 64-bitowy - rozmiar fragmentu nie jest ograniczony (tryb katalogu skanuje małe pliki w całości)
+uint64_t liczba_slow_we_fragmencie(std::string_view fragment, const KMP_Preprocessed& wzorzec, const PolozenieFragmentu& polozenie = {},
+    std::vector<size_t>* pozycje = nullptr) {
+    if (wzorzec.pattern.empty()) return 0;  // Zabezpieczenie przed pustym wzorcem
+    if (wzorzec.wyrazenie) return wzorzec.wyrazenie->licz(fragment, polozenie, pozycje);
+    if (wzorzec.bez_diakrytykow) return licz_bez_diakrytykow(fragment, wzorzec.zlozony, polozenie, wzorzec.cale_slowa, pozycje);
+    if (wzorzec.cale_slowa) return licz_cale_slowa(fragment, wzorzec.pattern, polozenie, pozycje);
+    switch (wzorzec.silnik) {  // Alternatywy dla pętli KMP
+    case SilnikWyszukiwania::SIMD: return licz_simd(fragment, wzorzec.pattern, pozycje);
+    case SilnikWyszukiwania::Horspool: return licz_horspool(fragment, wzorzec.pattern, wzorzec.przesuniecia.data(), pozycje);
+    case SilnikWyszukiwania::Bajt: return licz_bajt(fragment, wzorzec.pattern[0], pozycje);
+    default: break;
+    }
+
+    uint64_t count = 0;  // Licznik wystąpień
+    const size_t m = wzorzec.pattern.size();
+    const size_t n = fragment.size();
+    size_t i = 0, j = 0;  // Indeksy dla tekstu (i) i wzorca (j)
+
+    while (i < n) {
+        if (wzorzec.pattern[j] == fragment[i]) {// Dopasowanie znaków
+            ++i;
+            ++j;
+        }
+
+        if (j == m) {// Całe słowo dopasowane
+            ++count;
+            if (pozycje) pozycje->push_back(i - m);
+            j = wzorzec.lps[j - 1];// Kontynuuj szukanie od pozycji w LPS
+        }
+        else if (i < n && wzorzec.pattern[j] != fragment[i]) {
+            // Brak dopasowania - wykorzystaj tablicę LPS do optymalnego przesunięcia
+            j ? j = wzorzec.lps[j - 1] : ++i;
+        }
+    }
+    return count;
+}
+
+// Długość okna wyznaczającego nakładkę fragmentów - w trybie całych słów z kontekstem wokół słowa,
+// bez diakrytyków - najdłuższe możliwe dopasowanie (każdy złożony znak może mieć w tekście 2 bajty),
+// dla wyrażenia regularnego - jego najdłuższe dopasowanie
+static size_t dlugosc_okna(const std::string& slowo, const OpcjeSkanowania& opcje) {
+    if (slowo.empty()) return 0;
+    if (opcje.silnik == SilnikWyszukiwania::Regex) {
+        std::string blad;
+        const auto wyrazenie = WyrazenieRegularne::kompiluj(slowo, blad);
+        return wyrazenie ? wyrazenie->max_dlugosc() : 1;
+    }
+    const size_t dlugosc = opcje.bez_diakrytykow ? 2 * zloz_znaki(slowo).size() : slowo.size();
+    return opcje.cale_slowa ? dlugosc + KONTEKST_CALYCH_SLOW : dlugosc;
+}
+
+// Położenie fragmentu z podziel_na_fragmenty w pliku
+static PolozenieFragmentu polozenie_fragmentu(const PrzygotowanyKorpus& korpus, std::string_view fragment, const OpcjeSkanowania& opcje) {
+    const std::string_view plik = korpus.dane->dane();
+    const size_t rozmiar = opcje.rozmiar_fragmentu ? opcje.rozmiar_fragmentu : ROZMIAR_FRAGMENTU;
+    PolozenieFragmentu polozenie;
+    polozenie.poczatek_pliku = fragment.data() == plik.data();
+    polozenie.koniec_pliku = fragment.data() + fragment.size() == plik.data() + plik.size();
+    polozenie.wlasciwa = std::min(rozmiar, fragment.size());
+    return polozenie;
+}
+
+// Położenie bufora strumienia w pliku - pierwszy bufor nie ma nakładki
+static PolozenieFragmentu polozenie_bufora(const StrumienFragmentow& strumien, std::string_view fragment, size_t slot) {
+    PolozenieFragmentu polozenie;
+    polozenie.poczatek_pliku = strumien.nakladka(slot) == 0;
+    polozenie.koniec_pliku = strumien.koniec_pliku(slot);
+    polozenie.wlasciwa = fragment.size();
+    polozenie.nakladka = strumien.nakladka(slot);  // Okna krótsze niż nakładka (bez diakrytyków) mogły już zostać policzone
+    return polozenie;
+}
+
+// Czy fragment i trzeba skanować - false, gdy streszczenie 3-gramów wyklucza w nim wystąpienie słowa
+static bool skanuj_fragment(const PrzygotowanyKorpus& korpus, const std::vector<uint32_t>& bity, size_t i) {
+    return !korpus.filtr || korpus.filtr->moze_zawierac(i, bity);
+}
+
+// Zlicza fragment numer `numer` leżący w pliku od `poczatek`; w trybie pozycji (bufor wątku niepusty)
+// jego dopasowania trafiają jako odcinek do bufora wątku, który go skanował
+static uint64_t zlicz_fragment(std::string_view fragment, const KMP_Preprocessed& wzorzec, const PolozenieFragmentu& polozenie,
+    size_t numer, uint64_t poczatek, BuforPozycji* pozycje) {
+    if (!pozycje) return liczba_slow_we_fragmencie(fragment, wzorzec, polozenie);
+    const uint64_t liczba = liczba_slow_we_fragmencie(fragment, wzorzec, polozenie, &pozycje->biezace());
+    pozycje->zamknij_fragment(numer, poczatek);
+    return liczba;
+}
+
+// Bufory pozycji dla `watki` wątków - puste poza trybem pozycji i w trybie strumieniowym
+// (bufor strumienia nie jest fragmentem o stałym numerze, więc odcinków nie dałoby się uporządkować)
+static std::vector<BuforPozycji> bufory_pozycji(const OpcjeSkanowania& opcje, size_t watki) {
+    const bool z_pozycjami = opcje.pozycje && opcje.wczytywanie != TrybWczytywania::Strumieniowy;
+    return std::vector<BuforPozycji>(z_pozycjami ? watki : 0);
+}
+
+// Bufor pozycji wątku albo nullptr poza trybem pozycji
+static BuforPozycji* bufor_watku(std::vector<BuforPozycji>& bufory, size_t watek) {
+    return bufory.empty() ? nullptr : &bufory[watek];
+}
+
+// Fragment korpusu w pamięci: numer i przesunięcie w pliku
+static uint64_t zlicz_fragment_korpusu(const PrzygotowanyKorpus& korpus, size_t i, const KMP_Preprocessed& wzorzec,
+    const PolozenieFragmentu& polozenie, BuforPozycji* pozycje) {
+    const std::string_view fragment = (*korpus.fragmenty)[i];
+    return zlicz_fragment(fragment, wzorzec, polozenie, i, static_cast<uint64_t>(fragment.data() - korpus.dane->dane().data()), pozycje);
+}
+
+// Otwiera strumieniowe wczytywanie pliku dla wzorca o podanej długości
+// Pierścień ma stały rozmiar: (liczba odbiorców + 2) bufory po rozmiar_fragmentu bajtów,
+// a nakładka przenoszona między porcjami to długość wzorca - 1 (jak w podziel_na_fragmenty)
+static std::unique_ptr<StrumienFragmentow> otworz_strumien(const std::string& sciezka, size_t dlugosc_wzorca,
+    int liczba_odbiorcow, const OpcjeSkanowania& opcje) {
+    size_t nakladka = dlugosc_wzorca ? dlugosc_wzorca - 1 : 0;
+    size_t rozmiar = opcje.rozmiar_fragmentu ? opcje.rozmiar_fragmentu : ROZMIAR_FRAGMENTU;
+    size_t liczba_buforow = static_cast<size_t>(liczba_odbiorcow) + 2;  // Każdy wątek przetwarza jeden bufor, czytnik wypełnia kolejne
+    return std::make_unique<StrumienFragmentow>(sciezka, rozmiar, nakladka, liczba_buforow);
+}
+
+// Otwiera asynchroniczne wczytywanie pliku - porcje są fragmentami jak z podziel_na_fragmenty,
+// w locie jest do glebokosc_kolejki odczytów, a każdy odbiorca może trzymać jeszcze jeden bufor
+static std::unique_ptr<CzytnikAsynchroniczny> otworz_czytnik(const std::string& sciezka, size_t dlugosc_wzorca,
+    int liczba_odbiorcow, const OpcjeSkanowania& opcje) {
+    size_t nakladka = dlugosc_wzorca ? dlugosc_wzorca - 1 : 0;
+    size_t rozmiar = opcje.rozmiar_fragmentu ? opcje.rozmiar_fragmentu : ROZMIAR_FRAGMENTU;
+    return std::make_unique<CzytnikAsynchroniczny>(sciezka, rozmiar, nakladka, opcje.glebokosc_kolejki,
+        static_cast<size_t>(liczba_odbiorcow), opcje.bez_pamieci_podrecznej);
+}
+
+// Położenie porcji czytnika asynchronicznego - jak fragmentu korpusu
+static PolozenieFragmentu polozenie_porcji(const CzytnikAsynchroniczny& czytnik, std::string_view fragment, size_t slot) {
+    PolozenieFragmentu polozenie;
+    polozenie.poczatek_pliku = czytnik.poczatek(slot) == 0;
+    polozenie.koniec_pliku = czytnik.koniec_pliku(slot);
+    polozenie.wlasciwa = std::min(czytnik.rozmiar_fragmentu(), fragment.size());
+    return polozenie;
+}
+
+// Skanuje porcje, dopóki czytnik je dostarcza - zwraca czas samego skanowania (bez czekania na odczyt)
+static double skanuj_porcje(CzytnikAsynchroniczny& czytnik, const KMP_Preprocessed& wzorzec, uint64_t& total, BuforPozycji* pozycje) {
+    double czas = 0.0;
+    std::string_view fragment;
+    size_t slot;
+    while (czytnik.pobierz(fragment, slot)) {
+        auto start = std::chrono::high_resolution_clock::now();
+        const uint64_t poczatek = czytnik.poczatek(slot);
+        total += zlicz_fragment(fragment, wzorzec, polozenie_porcji(czytnik, fragment, slot),
+            static_cast<size_t>(poczatek / czytnik.rozmiar_fragmentu()), poczatek, pozycje);
+        czas += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        czytnik.zwolnij(slot);  // Bufor od razu wraca do kolejki odczytów
+    }
+    return czas;
+}
+
+// Uzupełnia metryki o przepustowość urządzenia i skanowania w trybie asynchronicznym
+static void uzupelnij_wynik_odczytu(Metrics& wynik, const CzytnikAsynchroniczny& czytnik, double czas_skanowania,
+    int liczba_watkow, const OpcjeSkanowania& opcje) {
+    wynik.bajty = czytnik.wczytano_bajtow();
+    wynik.odczyt = czytnik.mechanizm() + ", kolejka " + std::to_string(opcje.glebokosc_kolejki);
+    if (czytnik.blad()) wynik.odczyt += ", BLAD ODCZYTU - wynik niepelny";
+    wynik.bajty_urzadzenia = czytnik.bajty_urzadzenia();
+    wynik.czas_odczytu = czytnik.czas_odczytu();
+    wynik.czas_skanowania = czas_skanowania / (liczba_watkow > 0 ? liczba_watkow : 1);
+}
+
+// Tryby zliczania słowo po słowie, w których plik jest czytany w trakcie skanowania (bez korpusu w pamięci)
+static bool odczyt_w_trakcie_skanowania(const OpcjeSkanowania& opcje) {
+    return opcje.wczytywanie == TrybWczytywania::Asynchroniczny || opcje.wczytywanie == TrybWczytywania::Pozycyjny;
+}
+
+// Liczba fragmentów pliku w trybie pozycyjnym - jak w podziel_na_fragmenty
+static size_t liczba_fragmentow_pliku(const PlikPozycyjny& plik, const OpcjeSkanowania& opcje) {
+    const size_t rozmiar = opcje.rozmiar_fragmentu ? opcje.rozmiar_fragmentu : ROZMIAR_FRAGMENTU;
+    return static_cast<size_t>((plik.rozmiar() + rozmiar - 1) / rozmiar);
+}
+
+// Położenie fragmentu i wczytanego z pliku (wczytane - część właściwa z nakładką, mniej przy końcu pliku)
+static PolozenieFragmentu polozenie_zakresu(const PlikPozycyjny& plik, size_t i, size_t wczytane, const OpcjeSkanowania& opcje) {
+    const size_t rozmiar = opcje.rozmiar_fragmentu ? opcje.rozmiar_fragmentu : ROZMIAR_FRAGMENTU;
+    PolozenieFragmentu polozenie;
+    polozenie.poczatek_pliku = i == 0;
+    polozenie.koniec_pliku = static_cast<uint64_t>(i) * rozmiar + wczytane >= plik.rozmiar();
+    polozenie.wlasciwa = std::min(rozmiar, wczytane);
+    return polozenie;
+}
+
+// Tryb pozycyjny: fragment i (część właściwa + nakładka) czyta do swojego bufora wątek, który go skanuje -
+// strony bufora dotyka po raz pierwszy ten sam wątek, więc leżą w pamięci jego węzła NUMA
+static uint64_t zlicz_fragment_pozycyjnie(const PlikPozycyjny& plik, size_t i, size_t dlugosc_wzorca, const OpcjeSkanowania& opcje,
+    const KMP_Preprocessed& wzorzec, std::vector<char>& bufor, BuforPozycji* pozycje) {
+    const size_t rozmiar = opcje.rozmiar_fragmentu ? opcje.rozmiar_fragmentu : ROZMIAR_FRAGMENTU;
+    const size_t nakladka = dlugosc_wzorca ? dlugosc_wzorca - 1 : 0;
+    const uint64_t od = static_cast<uint64_t>(i) * rozmiar;
+    const std::string_view fragment = plik.odczytaj(od, rozmiar + nakladka, bufor);
+    return zlicz_fragment(fragment, wzorzec, polozenie_zakresu(plik, i, fragment.size(), opcje), i, od, pozycje);
+}
+
+// Implementacje różnych wersji zliczania
+// ======================================
+
+// Sumuje bajty i czas pracy wątków według węzłów NUMA (wezly[w] - węzeł wątku w)
+static std::vector<StatystykiWezla> zbierz_wezly(const std::vector<size_t>& wezly, const std::vector<uint64_t>& bajty,
+    const std::vector<double>& praca, const std::vector<size_t>& kradzieze_zdalne) {
+    std::vector<StatystykiWezla> wynik(TopologiaNUMA::systemowa().liczba_wezlow());
+    for (size_t w = 0; w < wezly.size(); ++w) {
+        StatystykiWezla& wezel = wynik[wezly[w]];
+        ++wezel.watki;
+        wezel.bajty += bajty[w];
+        wezel.praca += praca[w];
+        if (w < kradzieze_zdalne.size()) wezel.kradzieze_zdalne += kradzieze_zdalne[w];
+    }
+    return wynik;
+}
+
+// Wspólny przebieg wszystkich wersji: wczytanie, pomiar, tryby odczytu i zebranie wyników - backend decyduje
+// tylko o tym, który wątek wykonuje które zadanie (fragment albo pętlę pobierającą z kolejki)
+Metrics liczba_slow_backend(const std::string& sciezka_pliku, const std::string& slowo, BackendRownolegly& backend, const OpcjeSkanowania& opcje) {
+    const int liczba_watkow = static_cast<int>(backend.liczba_watkow());
+
+    // Wczytanie pliku poza pomiarem - osobna kolumna czasu (poza trybami czytającymi plik w trakcie skanowania)
+    // Strony rozmieszczone na węzłach NUMA tylko dla backendu, który skanuje tymi samymi blokami
+    auto korpus = odczyt_w_trakcie_skanowania(opcje) ? PrzygotowanyKorpus{}
+        : przygotuj_korpus(sciezka_pliku, dlugosc_okna(slowo, opcje), opcje, backend.numa() ? liczba_watkow : 1);
+    const std::string probka = probka_korpusu(sciezka_pliku, opcje, korpus);
+
+    // Rozpocznij pomiary
+    Pomiar pomiar = rozpocznij_pomiar();
+
+    // Przygotuj dane
+    auto wzorzec = przygotuj_wzorzec(slowo, opcje.silnik, probka, opcje.cale_slowa, opcje.bez_diakrytykow);
+    std::unique_ptr<StrumienFragmentow> strumien;  // Pierścień buforów żyje do końca pomiaru pamięci
+    std::unique_ptr<CzytnikAsynchroniczny> czytnik;  // Bufory kolejki odczytów - jak pierścień
+    std::unique_ptr<PlikPozycyjny> plik;  // Tryb pozycyjny - jeden deskryptor na wszystkie wątki
+    double czas_skanowania = 0.0;
+    const std::vector<uint32_t> bity = korpus.filtr ? korpus.filtr->bity_wzorca(slowo) : std::vector<uint32_t>{};  // 3-gramy słowa
+
+    const size_t miejsca = backend.liczba_miejsc();
+    std::vector<uint64_t> wyniki(miejsca, 0);// Wyniki cząstkowe - jeden licznik na wątek
+    std::vector<size_t> pominiete(miejsca, 0);  // Fragmenty odrzucone przez filtr n-gramów
+    std::vector<uint64_t> bajty_watkow(miejsca, 0);  // Tryb NUMA: części właściwe przeskanowanych fragmentów
+    std::vector<BuforPozycji> pozycje = bufory_pozycji(opcje, miejsca);  // Tryb pozycji: bufor na wątek
+
+    if (opcje.wczytywanie == TrybWczytywania::Strumieniowy) {// Każdy wątek pobiera bufory, dopóki czytnik je dostarcza
+        strumien = otworz_strumien(sciezka_pliku, dlugosc_okna(slowo, opcje), liczba_watkow, opcje);
+        backend.na_kazdym_watku([&](size_t watek) {
+            std::string_view fragment;
+            size_t slot;
+            while (strumien->pobierz(fragment, slot)) {
+                wyniki[watek] += liczba_slow_we_fragmencie(fragment, wzorzec, polozenie_bufora(*strumien, fragment, slot));
+                strumien->zwolnij(slot);
+            }
+            });
+    }
+    else if (opcje.wczytywanie == TrybWczytywania::Asynchroniczny) {// Wątki skanują porcje w kolejności zakończenia odczytów
+        czytnik = otworz_czytnik(sciezka_pliku, dlugosc_okna(slowo, opcje), liczba_watkow, opcje);
+        std::vector<double> czasy(miejsca, 0.0);
+        backend.na_kazdym_watku([&](size_t watek) {
+            czasy[watek] += skanuj_porcje(*czytnik, wzorzec, wyniki[watek], bufor_watku(pozycje, watek));
+            });
+        for (double x : czasy) czas_skanowania += x;
+    }
+    else if (opcje.wczytywanie == TrybWczytywania::Pozycyjny) {// Jedno zadanie na fragment, czytany przez wątek, który je wykonuje
+        plik = std::make_unique<PlikPozycyjny>(sciezka_pliku);
+        std::vector<std::vector<char>> bufory(miejsca);  // Puste - każdy wątek alokuje swój przy pierwszym odczycie
+        const size_t dlugosc = dlugosc_okna(slowo, opcje);
+        backend.wykonaj(liczba_fragmentow_pliku(*plik, opcje), [&](size_t i, size_t watek) {
+            wyniki[watek] += zlicz_fragment_pozycyjnie(*plik, i, dlugosc, opcje, wzorzec, bufory[watek], bufor_watku(pozycje, watek));
+            });
+    }
+    else {// Jedno zadanie na fragment korpusu w pamięci
+        const auto& fragmenty = *korpus.fragmenty;
+        backend.wykonaj(fragmenty.size(), [&](size_t i, size_t watek) {
+            const PolozenieFragmentu polozenie = polozenie_fragmentu(korpus, fragmenty[i], opcje);
+            bajty_watkow[watek] += polozenie.wlasciwa;
+            if (!skanuj_fragment(korpus, bity, i)) {
+                ++pominiete[watek];
+                return;
+            }
+            wyniki[watek] += zlicz_fragment_korpusu(korpus, i, wzorzec, polozenie, bufor_watku(pozycje, watek));
+            });
+    }
+
+    // Sumuj wyniki
+    uint64_t total = 0;
+    for (uint64_t x : wyniki) {
+        total += x;
+    }
+    std::string wynik_pozycji = pozycje.empty() ? std::string() : scal_pozycje(pozycje);  // Odcinki wątków w kolejności pliku
+    size_t suma_pominietych = 0;
+    for (size_t x : pominiete) suma_pominietych += x;
+
+    // Zakończ pomiary
+    Metrics wynik = zakoncz_pomiar(pomiar);
+    wynik.count = total;
+    wynik.pominiete_fragmenty = suma_pominietych;
+    wynik.liczba_fragmentow = korpus.fragmenty ? korpus.fragmenty->size() : 0;
+    wynik.bajty = strumien ? strumien->wczytano_bajtow() : plik ? plik->rozmiar() : korpus.dane ? korpus.dane->dane().size() : 0;
+    if (czytnik) uzupelnij_wynik_odczytu(wynik, *czytnik, czas_skanowania, liczba_watkow, opcje);
+    wynik.czas_wczytywania = korpus.czas_wczytywania;
+    wynik.silnik = wzorzec.opis;
+    wynik.backend = backend.nazwa();
+    wynik.watki = backend.statystyki();
+    if (backend.numa() && korpus.fragmenty) {
+        std::vector<size_t> wezly, zdalne;
+        std::vector<double> praca;
+        for (const StatystykiWatku& watek : wynik.watki) {
+            wezly.push_back(watek.wezel);
+            praca.push_back(watek.praca);
+            zdalne.push_back(watek.kradzieze_zdalne);
+        }
+        wynik.wezly = zbierz_wezly(wezly, bajty_watkow, praca, zdalne);
+    }
+    wynik.pozycje = std::move(wynik_pozycji);
+    return wynik;
+}
+
+// Wersja sekwencyjna
+Metrics liczba_slow_sekwencyjny(const std::string& sciezka_pliku, const std::string& slowo, const OpcjeSkanowania& opcje) {
+    auto backend = utworz_backend(RodzajBackendu::Sekwencyjny, 1);
+    return liczba_slow_backend(sciezka_pliku, slowo, *backend, opcje);
+}
+
+// Wersja z użyciem std::thread (długo żyjąca pula wątków z podkradaniem zadań)
+// W trybie NUMA pula przypięta do węzłów - ta sama, która rozmieściła strony korpusu
+Metrics liczba_slow_Thread(const std::string& sciezka_pliku, const std::string& slowo, int liczba_watkow, const OpcjeSkanowania& opcje) {
+    auto backend = utworz_backend(RodzajBackendu::PulaWatkow, liczba_watkow, rozmieszczenie_numa(opcje, liczba_watkow));
+    return liczba_slow_backend(sciezka_pliku, slowo, *backend, opcje);
+}
+
+// Wersja z użyciem OpenMP
+// W trybie NUMA ciągłe bloki fragmentów na wątkach przypiętych do węzłów (jak przy rozmieszczaniu stron)
+Metrics liczba_slow_OpenMP(const std::string& sciezka_pliku, const std::string& slowo, int liczba_watkow, const OpcjeSkanowania& opcje) {
+    auto backend = utworz_backend(RodzajBackendu::OpenMP, liczba_watkow, rozmieszczenie_numa(opcje, liczba_watkow));
+    return liczba_slow_backend(sciezka_pliku, slowo, *backend, opcje);
+}
+
+// Potok korutyn (C++20)
+// =====================
+
+// Zapytanie potoku: słowo w jednym pliku z przygotowanym wzorcem i źródłem fragmentów
+struct ZapytanieKorutyn {
+    KMP_Preprocessed wzorzec;
+    size_t dlugosc = 0;                   // Okno słowa - wyznacza nakładkę fragmentów
+    PrzygotowanyKorpus korpus;            // CalyPlik/Mmap: fragmenty w pamięci
+    std::vector<uint32_t> bity;           // 3-gramy słowa (filtr n-gramów)
+    std::unique_ptr<PlikPozycyjny> plik;  // Pozostałe tryby: każda korutyna czyta swój zakres
+    size_t liczba_fragmentow = 0;
+    std::atomic<uint64_t> wynik{ 0 };
+    std::atomic<size_t> pominiete{ 0 };
+    std::vector<BuforPozycji> pozycje;    // Tryb pozycji: bufor na wątek wykonawcy
+};
+
+// Obiekty wspólne dla wszystkich korutyn jednego uruchomienia
+struct PotokKorutyn {
+    PotokKorutyn(Wykonawca& wykonawca_potoku, size_t miejsca_potoku, size_t watki_odczytu, size_t korutyny)
+        : wykonawca(wykonawca_potoku), miejsca(wykonawca_potoku, miejsca_potoku), odczyt(wykonawca_potoku, watki_odczytu), koniec(korutyny) {}
+
+    Wykonawca& wykonawca;
+    SemaforKorutyn miejsca;  // Fragmenty w toku (czytane albo skanowane) - ogranicza pamięć buforów
+    UslugaOdczytu odczyt;
+    LicznikZakonczen koniec;
+};
+
+// Korutyna fragmentu i zapytania: przechodzi na wykonawcę, czeka na miejsce w potoku, w trybach odczytu -
+// na wczytanie swojego zakresu, i zlicza go tak jak pozostałe wersje. Wątek wykonawcy nie czeka ani na
+// miejsce, ani na dysk - w tym czasie wznawia inne korutyny.
+static KorutynaWolna skanuj_fragment_korutyna(ZapytanieKorutyn& zapytanie, size_t i, const OpcjeSkanowania& opcje, PotokKorutyn& potok) {
+    co_await potok.wykonawca.przejdz();
+    co_await potok.miejsca.zajmij();
+    uint64_t liczba = 0;
+    if (zapytanie.plik) {
+        const size_t rozmiar = opcje.rozmiar_fragmentu ? opcje.rozmiar_fragmentu : ROZMIAR_FRAGMENTU;
+        const size_t nakladka = zapytanie.dlugosc ? zapytanie.dlugosc - 1 : 0;
+        const uint64_t od = static_cast<uint64_t>(i) * rozmiar;
+        const size_t dlugosc = static_cast<size_t>(std::min<uint64_t>(rozmiar + nakladka, zapytanie.plik->rozmiar() - od));
+        std::unique_ptr<char[]> bufor(new char[dlugosc]);  // Bez zerowania - odczyt i tak nadpisuje cały bufor
+        const size_t wczytane = co_await potok.odczyt.odczytaj(*zapytanie.plik, od, bufor.get(), dlugosc);
+        liczba = zlicz_fragment(std::string_view(bufor.get(), wczytane), zapytanie.wzorzec,
+            polozenie_zakresu(*zapytanie.plik, i, wczytane, opcje), i, od, bufor_watku(zapytanie.pozycje, Wykonawca::numer_watku()));
+    }
+    else if (skanuj_fragment(zapytanie.korpus, zapytanie.bity, i)) {
+        liczba = zlicz_fragment_korpusu(zapytanie.korpus, i, zapytanie.wzorzec, polozenie_fragmentu(zapytanie.korpus, (*zapytanie.korpus.fragmenty)[i], opcje),
+            bufor_watku(zapytanie.pozycje, Wykonawca::numer_watku()));
+    }
+    else {
+        ++zapytanie.pominiete;
+    }
+    potok.miejsca.zwolnij();
+    zapytanie.wynik += liczba;
+    potok.koniec.zakoncz();
+}
+
+// Przygotowuje zapytanie poza pomiarem: korpus w pamięci (CalyPlik/Mmap) albo plik, z którego korutyny
+// czytają swoje zakresy (pozostałe tryby - potok sam nakłada odczyt na skanowanie)
+static std::unique_ptr<ZapytanieKorutyn> przygotuj_zapytanie(const std::string& sciezka, const std::string& slowo, size_t watki,
+    const OpcjeSkanowania& opcje) {
+    auto zapytanie = std::make_unique<ZapytanieKorutyn>();
+    zapytanie->dlugosc = dlugosc_okna(slowo, opcje);
+    if (opcje.wczytywanie == TrybWczytywania::CalyPlik || opcje.wczytywanie == TrybWczytywania::Mmap) {
+        zapytanie->korpus = przygotuj_korpus(sciezka, zapytanie->dlugosc, opcje);
+        zapytanie->liczba_fragmentow = zapytanie->korpus.fragmenty->size();
+        if (zapytanie->korpus.filtr) zapytanie->bity = zapytanie->korpus.filtr->bity_wzorca(slowo);
+    }
+    else {
+        zapytanie->plik = std::make_unique<PlikPozycyjny>(sciezka);
+        zapytanie->liczba_fragmentow = liczba_fragmentow_pliku(*zapytanie->plik, opcje);
+    }
+    zapytanie->pozycje = bufory_pozycji(opcje, watki);
+    return zapytanie;
+}
+
+// Uruchamia korutyny wszystkich fragmentów wszystkich zapytań na jednym wykonawcy i czeka na ich koniec
+static void wykonaj_zapytania(std::vector<std::unique_ptr<ZapytanieKorutyn>>& zapytania, Wykonawca& wykonawca, const OpcjeSkanowania& opcje) {
+    size_t korutyny = 0;
+    for (const auto& zapytanie : zapytania) korutyny += zapytanie->liczba_fragmentow;
+    if (korutyny == 0) return;
+
+    // Miejsce na wątek skanujący i na każdy odczyt w locie
+    const size_t glebokosc = opcje.glebokosc_kolejki ? opcje.glebokosc_kolejki : 1;
+    PotokKorutyn potok(wykonawca, wykonawca.liczba_watkow() + glebokosc, glebokosc, korutyny);
+    for (auto& zapytanie : zapytania) {
+        for (size_t i = 0; i < zapytanie->liczba_fragmentow; ++i) skanuj_fragment_korutyna(*zapytanie, i, opcje, potok);
+    }
+    potok.koniec.czekaj();
+}
+
+// Wersja z korutynami C++20
+Metrics liczba_slow_korutyny(const std::string& sciezka_pliku, const std::string& slowo, int liczba_watkow, const OpcjeSkanowania& opcje) {
+    Wykonawca& wykonawca = Wykonawca::wspolny(static_cast<size_t>(liczba_watkow > 0 ? liczba_watkow : 1));
+    std::vector<std::unique_ptr<ZapytanieKorutyn>> zapytania;
+    zapytania.push_back(przygotuj_zapytanie(sciezka_pliku, slowo, wykonawca.liczba_watkow(), opcje));
+    ZapytanieKorutyn& zapytanie = *zapytania.front();
+    const std::string probka = probka_korpusu(sciezka_pliku, opcje, zapytanie.korpus);
+
+    // Rozpocznij pomiary
+    Pomiar pomiar = rozpocznij_pomiar();
+
+    zapytanie.wzorzec = przygotuj_wzorzec(slowo, opcje.silnik, probka, opcje.cale_slowa, opcje.bez_diakrytykow);
+    wykonaj_zapytania(zapytania, wykonawca, opcje);
+    std::string wynik_pozycji = zapytanie.pozycje.empty() ? std::string() : scal_pozycje(zapytanie.pozycje);  // Odcinki wątków w kolejności pliku
+
+    // Zakończ pomiary
+    Metrics wynik = zakoncz_pomiar(pomiar);
+    wynik.count = zapytanie.wynik;
+    wynik.pominiete_fragmenty = zapytanie.pominiete;
+    wynik.liczba_fragmentow = zapytanie.korpus.fragmenty ? zapytanie.korpus.fragmenty->size() : 0;
+    wynik.bajty = zapytanie.plik ? zapytanie.plik->rozmiar() : zapytanie.korpus.dane->dane().size();
+    wynik.czas_wczytywania = zapytanie.korpus.czas_wczytywania;
+    wynik.silnik = zapytanie.wzorzec.opis;
+    wynik.backend = "korutyny C++20 (" + std::to_string(wykonawca.liczba_watkow()) + " watkow)";
+    wynik.pozycje = std::move(wynik_pozycji);
+    return wynik;
+}
+
+// Wiele zapytań jednym potokiem korutyn
+Metrics zlicz_zapytania_korutynami(const std::vector<ZapytanieSkanu>& zapytania, int liczba_watkow, const OpcjeSkanowania& opcje) {
+    // Korpusy i próbki poza pomiarem - jak w pozostałych wersjach
+    Wykonawca& wykonawca = Wykonawca::wspolny(static_cast<size_t>(liczba_watkow > 0 ? liczba_watkow : 1));
+    OpcjeSkanowania bez_pozycji = opcje;
+    bez_pozycji.pozycje = false;
+    std::vector<std::unique_ptr<ZapytanieKorutyn>> stany;
+    std::vector<std::string> probki;
+    for (const auto& zapytanie : zapytania) {
+        stany.push_back(przygotuj_zapytanie(zapytanie.sciezka, zapytanie.slowo, wykonawca.liczba_watkow(), bez_pozycji));
+        probki.push_back(probka_korpusu(zapytanie.sciezka, opcje, stany.back()->korpus));
+    }
+
+    // Rozpocznij pomiary
+    Pomiar pomiar = rozpocznij_pomiar();
+
+    for (size_t i = 0; i < stany.size(); ++i) {
+        stany[i]->wzorzec = przygotuj_wzorzec(zapytania[i].slowo, opcje.silnik, probki[i], opcje.cale_slowa, opcje.bez_diakrytykow);
+    }
+    wykonaj_zapytania(stany, wykonawca, bez_pozycji);
+
+    // Zakończ pomiary
+    Metrics wynik = zakoncz_pomiar(pomiar);
+    std::set<std::string> pliki;  // Każdy plik liczony raz w bajtach, choć skanuje go kilka zapytań
+    for (size_t i = 0; i < stany.size(); ++i) {
+        const ZapytanieKorutyn& stan = *stany[i];
+        wynik.liczniki_slow.push_back(stan.wynik);
+        wynik.count += stan.wynik;
+        wynik.pominiete_fragmenty += stan.pominiete;
+        wynik.liczba_fragmentow += stan.korpus.fragmenty ? stan.korpus.fragmenty->size() : 0;
+        wynik.czas_wczytywania += stan.korpus.czas_wczytywania;
+        if (pliki.insert(zapytania[i].sciezka).second) wynik.bajty += stan.plik ? stan.plik->rozmiar() : stan.korpus.dane->dane().size();
+    }
+    if (!stany.empty()) wynik.silnik = stany.front()->wzorzec.opis;
+    wynik.backend = "korutyny C++20 (" + std::to_string(wykonawca.liczba_watkow()) + " watkow, " + std::to_string(stany.size()) + " zapytan)";
+    return wynik;
+}
+
+// Zliczanie z trwałego indeksu słów
+// =================================
+
+// Otwarty indeks - ważny, dopóki plik ma ten sam rozmiar i czas modyfikacji
+struct WpisIndeksu {
+    uintmax_t rozmiar = 0;
+    std::filesystem::file_time_type modyfikacja;
+    std::unique_ptr<IndeksSlow> indeks;
+    bool zbudowany = false;  // Indeks zbudowany w tym procesie (a nie wczytany z dysku)
+};
+
+static std::mutex mutex_indeksow;
+static std::map<std::string, WpisIndeksu> otwarte_indeksy;  // Ścieżka korpusu -> zmapowany indeks
+
+// Zwraca indeks korpusu: z pamięci, z pliku <sciezka>.indeks albo budując go od nowa na puli wątków
+static const WpisIndeksu* otworz_indeks(const std::string& sciezka, int liczba_watkow, const OpcjeSkanowania& opcje) {
+    std::error_code blad;
+    const uintmax_t rozmiar = std::filesystem::file_size(sciezka, blad);
+    const auto modyfikacja = std::filesystem::last_write_time(sciezka, blad);
+    if (blad) return nullptr;  // Brak pliku
+    const int64_t znacznik = static_cast<int64_t>(modyfikacja.time_since_epoch().count());
+
+    std::lock_guard<std::mutex> blokada(mutex_indeksow);
+    WpisIndeksu& wpis = otwarte_indeksy[sciezka];
+    if (wpis.indeks && wpis.rozmiar == rozmiar && wpis.modyfikacja == modyfikacja) return &wpis;
+
+    wpis.indeks = std::make_unique<IndeksSlow>();  // Zwolnij stare mapowanie przed podmianą pliku indeksu
+    wpis.rozmiar = rozmiar;
+    wpis.modyfikacja = modyfikacja;
+    wpis.zbudowany = false;
+    const std::string sciezka_indeksu = sciezka + ".indeks";
+    if (wpis.indeks->otworz(sciezka_indeksu, rozmiar, znacznik)) return &wpis;
+
+    // Brak aktualnego indeksu - tokenizacja korpusu na tych samych fragmentach co skanowanie (bez nakładki)
+    OpcjeSkanowania opcje_korpusu = opcje;
+    if (opcje_korpusu.wczytywanie == TrybWczytywania::Strumieniowy) opcje_korpusu.wczytywanie = TrybWczytywania::Mmap;
+    auto korpus = wczytaj_korpus(sciezka, opcje_korpusu);
+    const size_t rozmiar_fragmentu = opcje.rozmiar_fragmentu ? opcje.rozmiar_fragmentu : ROZMIAR_FRAGMENTU;
+    const auto& fragmenty = korpus->fragmenty(1, rozmiar_fragmentu);
+    if (!IndeksSlow::zbuduj(korpus->dane(), fragmenty, rozmiar_fragmentu, sciezka_indeksu, rozmiar, znacznik,
+        PulaWatkow::wspolna(static_cast<size_t>(liczba_watkow > 0 ? liczba_watkow : 1)))) {
+        wpis.indeks.reset();
+        return nullptr;  // Nie udało się zapisać indeksu (np. katalog tylko do odczytu)
+    }
+    if (!wpis.indeks->otworz(sciezka_indeksu, rozmiar, znacznik)) {
+        wpis.indeks.reset();
+        return nullptr;
+    }
+    wpis.zbudowany = true;
+    return &wpis;
+}
+
+Metrics liczba_slow_z_indeksu(const std::string& sciezka_pliku, const std::string& slowo, int liczba_watkow, const OpcjeSkanowania& opcje) {
+    // Otwarcie lub budowa indeksu - osobna kolumna czasu, jak wczytywanie korpusu
+    auto start = std::chrono::high_resolution_clock::now();
+    const WpisIndeksu* wpis = otworz_indeks(sciezka_pliku, liczba_watkow, opcje);
+    const double czas_otwarcia = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    if (!wpis || !IndeksSlow::jest_slowem(slowo)) {  // Bez indeksu lub nie pojedyncze słowo - skanowanie całych słów
+        OpcjeSkanowania calych = opcje;
+        calych.cale_slowa = true;
+        calych.bez_diakrytykow = false;
+        Metrics wynik = liczba_slow_sekwencyjny(sciezka_pliku, slowo, calych);
+        wynik.czas_wczytywania += czas_otwarcia;
+        wynik.silnik += wpis ? " (tekst nie jest pojedynczym slowem - skanowanie)" : " (brak indeksu - skanowanie)";
+        return wynik;
+    }
+
+    Pomiar pomiar = rozpocznij_pomiar();
+    const uint64_t liczba = wpis->indeks->liczba(slowo);
+    Metrics wynik = zakoncz_pomiar(pomiar);
+    wynik.count = liczba;
+    wynik.czas_wczytywania = czas_otwarcia;
+    std::ostringstream opis;
+    opis << "Indeks slow (" << wpis->indeks->liczba_terminow() << " terminow, " << wpis->indeks->liczba_tokenow()
+        << " slow, " << (wpis->zbudowany ? "zbudowany" : "wczytany z dysku") << ")";
+    wynik.silnik = opis.str();
+    return wynik;
+}
+
+// Korpus z katalogu
+// =================
+
+// Zadanie trybu katalogu: cały mały plik albo jeden fragment dużego pliku
+struct ZadanieKatalogu {
+    size_t plik;  // Indeks w KorpusKatalogu::pliki
+    uint64_t od;  // Początek części właściwej w pliku
+};
+
+// Pliki katalogu i lista zadań wspólna dla wszystkich wersji
+struct KorpusKatalogu {
+    std::vector<PlikKorpusu> pliki;
+    std::vector<ZadanieKatalogu> zadania;
+    size_t rozmiar_fragmentu = ROZMIAR_FRAGMENTU;
+    size_t nakladka = 0;
+    uint64_t bajty = 0;            // Łączny rozmiar plików
+    double czas_listowania = 0.0;  // Przejście katalogu i podział na zadania
+};
+
+// Listuje katalog i dzieli pliki na zadania: plik nie większy niż fragment to jedno zadanie,
+// większy - kolejne fragmenty z nakładką, jak w podziel_na_fragmenty. Duże pliki trafiają na początek
+// listy, więc ich fragmenty są rozdzielane między wątki, a małe pliki wyrównują obciążenie na końcu.
+static KorpusKatalogu przygotuj_katalog(const std::string& katalog, size_t dlugosc_wzorca, const OpcjeSkanowania& opcje) {
+    auto start = std::chrono::high_resolution_clock::now();
+    KorpusKatalogu korpus;
+    korpus.pliki = wylistuj_katalog(katalog);
+    std::sort(korpus.pliki.begin(), korpus.pliki.end(), [](const PlikKorpusu& a, const PlikKorpusu& b) { return a.rozmiar > b.rozmiar; });
+    korpus.rozmiar_fragmentu = opcje.rozmiar_fragmentu ? opcje.rozmiar_fragmentu : ROZMIAR_FRAGMENTU;
+    korpus.nakladka = dlugosc_wzorca ? dlugosc_wzorca - 1 : 0;
+    for (size_t i = 0; i < korpus.pliki.size(); ++i) {
+        korpus.bajty += korpus.pliki[i].rozmiar;
+        for (uint64_t od = 0; od < korpus.pliki[i].rozmiar; od += korpus.rozmiar_fragmentu) korpus.zadania.push_back({ i, od });
+    }
+    korpus.czas_listowania = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    return korpus;
+}
+
+// Wczytuje część właściwą zadania z nakładką do bufora wątku i zlicza w niej wystąpienia
+static uint64_t wykonaj_zadanie_katalogu(const KorpusKatalogu& korpus, size_t numer, const KMP_Preprocessed& wzorzec, std::vector<char>& bufor) {
+    const ZadanieKatalogu& zadanie = korpus.zadania[numer];
+    const PlikKorpusu& plik = korpus.pliki[zadanie.plik];
+    const size_t ile = static_cast<size_t>(std::min(static_cast<uint64_t>(korpus.rozmiar_fragmentu + korpus.nakladka), plik.rozmiar - zadanie.od));
+    const std::string_view fragment = odczytaj_zakres(plik.sciezka, zadanie.od, ile, bufor);
+
+    PolozenieFragmentu polozenie;
+    polozenie.poczatek_pliku = zadanie.od == 0;
+    polozenie.koniec_pliku = zadanie.od + fragment.size() >= plik.rozmiar;
+    polozenie.wlasciwa = std::min(korpus.rozmiar_fragmentu, fragment.size());
+    return liczba_slow_we_fragmencie(fragment, wzorzec, polozenie);
+}
+
+// Sumuje wyniki zadań w liczniki plików i uzupełnia metryki
+static void uzupelnij_wynik_katalogu(Metrics& wynik, const KorpusKatalogu& korpus, const std::vector<uint64_t>& wyniki_zadan,
+    const KMP_Preprocessed& wzorzec) {
+    wynik.pliki.resize(korpus.pliki.size());
+    for (size_t i = 0; i < korpus.pliki.size(); ++i) {
+        wynik.pliki[i].sciezka = korpus.pliki[i].sciezka;
+        wynik.pliki[i].rozmiar = korpus.pliki[i].rozmiar;
+    }
+    wynik.count = 0;
+    for (size_t z = 0; z < korpus.zadania.size(); ++z) {
+        wynik.pliki[korpus.zadania[z].plik].liczba += wyniki_zadan[z];
+        wynik.count += wyniki_zadan[z];
+    }
+    wynik.bajty = static_cast<size_t>(korpus.bajty);
+    wynik.czas_wczytywania = korpus.czas_listowania;
+    wynik.silnik = wzorzec.opis;
+}
+
+// Wersja sekwencyjna
+Metrics liczba_slow_katalog_sekwencyjny(const std::string& katalog, const std::string& slowo, const OpcjeSkanowania& opcje) {
+    const KorpusKatalogu korpus = przygotuj_katalog(katalog, dlugosc_okna(slowo, opcje), opcje);
+
+    Pomiar pomiar = rozpocznij_pomiar();
+    auto wzorzec = przygotuj_wzorzec(slowo, opcje.silnik, {}, opcje.cale_slowa, opcje.bez_diakrytykow);
+    std::vector<uint64_t> wyniki_zadan(korpus.zadania.size(), 0);
+    std::vector<char> bufor;  // Jeden bufor na cały przebieg - bez alokacji na plik
+    for (size_t z = 0; z < korpus.zadania.size(); ++z) {
+        wyniki_zadan[z] = wykonaj_zadanie_katalogu(korpus, z, wzorzec, bufor);
+    }
+
+    Metrics wynik = zakoncz_pomiar(pomiar);
+    uzupelnij_wynik_katalogu(wynik, korpus, wyniki_zadan, wzorzec);
+    return wynik;
+}
+
+// Wersja z użyciem std::thread - małe pliki i fragmenty dużych plików w jednej partii puli
+Metrics liczba_slow_katalog_Thread(const std::string& katalog, const std::string& slowo, int liczba_watkow, const OpcjeSkanowania& opcje) {
+    const KorpusKatalogu korpus = przygotuj_katalog(katalog, dlugosc_okna(slowo, opcje), opcje);
+
+    Pomiar pomiar = rozpocznij_pomiar();
+    auto wzorzec = przygotuj_wzorzec(slowo, opcje.silnik, {}, opcje.cale_slowa, opcje.bez_diakrytykow);
+    PulaWatkow& pula = PulaWatkow::wspolna(static_cast<size_t>(liczba_watkow > 0 ? liczba_watkow : 1));
+    std::vector<uint64_t> wyniki_zadan(korpus.zadania.size(), 0);
+    std::vector<std::vector<char>> bufory(pula.liczba_watkow());  // Bufor odczytu każdego wątku puli
+    pula.wykonaj(korpus.zadania.size(), [&](size_t z, size_t watek) {
+        wyniki_zadan[z] = wykonaj_zadanie_katalogu(korpus, z, wzorzec, bufory[watek]);
+        });
+
+    Metrics wynik = zakoncz_pomiar(pomiar);
+    uzupelnij_wynik_katalogu(wynik, korpus, wyniki_zadan, wzorzec);
+    wynik.watki = pula.statystyki();
+    return wynik;
+}
+
+// Wersja równoległa z użyciem OpenMP - zadania o różnej wielkości, więc podział dynamiczny
+Metrics liczba_slow_katalog_OpenMP(const std::string& katalog, const std::string& slowo, int liczba_watkow, const OpcjeSkanowania& opcje) {
+    const KorpusKatalogu korpus = przygotuj_katalog(katalog, dlugosc_okna(slowo, opcje), opcje);
+
+    Pomiar pomiar = rozpocznij_pomiar();
+    auto wzorzec = przygotuj_wzorzec(slowo, opcje.silnik, {}, opcje.cale_slowa, opcje.bez_diakrytykow);
+    std::vector<uint64_t> wyniki_zadan(korpus.zadania.size(), 0);
+    omp_set_num_threads(liczba_watkow);
+#pragma omp parallel
+    {
+        std::vector<char> bufor;
+#pragma omp for schedule(dynamic, 1)
+        for (long long z = 0; z < static_cast<long long>(korpus.zadania.size()); ++z) {
+            wyniki_zadan[static_cast<size_t>(z)] = wykonaj_zadanie_katalogu(korpus, static_cast<size_t>(z), wzorzec, bufor);
+        }
+    }
+
+    Metrics wynik = zakoncz_pomiar(pomiar);
+    uzupelnij_wynik_katalogu(wynik, korpus, wyniki_zadan, wzorzec);
+    return wynik;
+}
+
+// Histogram słów całego pliku
+// ===========================
+
+// Korpus dla histogramu - słowo może sięgać za fragment, więc tokenizacja potrzebuje całego pliku w pamięci
+// (tryb strumieniowy jest zastępowany mapowaniem); fragmenty bez nakładki
+static PrzygotowanyKorpus przygotuj_korpus_histogramu(const std::string& sciezka, const OpcjeSkanowania& opcje) {
+    OpcjeSkanowania opcje_korpusu = opcje;
+    if (opcje_korpusu.wczytywanie == TrybWczytywania::Strumieniowy) opcje_korpusu.wczytywanie = TrybWczytywania::Mmap;
+    return przygotuj_korpus(sciezka, 1, opcje_korpusu);
+}
+
+// Zlicza słowa zaczynające się w części właściwej fragmentu
+static void zlicz_slowa_fragmentu(const PrzygotowanyKorpus& korpus, std::string_view fragment, const OpcjeSkanowania& opcje, MapaSlow& mapa) {
+    const std::string_view dane = korpus.dane->dane();
+    const size_t rozmiar = opcje.rozmiar_fragmentu ? opcje.rozmiar_fragmentu : ROZMIAR_FRAGMENTU;
+    const size_t poczatek = static_cast<size_t>(fragment.data() - dane.data());
+    zlicz_slowa(dane, poczatek, std::min(poczatek + rozmiar, dane.size()), mapa);
+}
+
+// N najczęstszych słów (przy równej liczbie - w kolejności bajtów) i łączna liczba słów
+static std::vector<CzestoscSlowa> najczestsze_slowa(const MapaSlow& mapa, size_t ile, uint64_t& wszystkie) {
+    std::vector<const MapaSlow::Wpis*> wpisy;
+    wpisy.reserve(mapa.rozmiar());
+    wszystkie = 0;
+    for (const auto& wpis : mapa.wpisy()) {
+        if (!wpis.tekst) continue;
+        wpisy.push_back(&wpis);
+        wszystkie += wpis.liczba;
+    }
+    if (ile > wpisy.size()) ile = wpisy.size();
+    std::partial_sort(wpisy.begin(), wpisy.begin() + ile, wpisy.end(), [](const MapaSlow::Wpis* a, const MapaSlow::Wpis* b) {
+        if (a->liczba != b->liczba) return a->liczba > b->liczba;
+        return std::string_view(a->tekst, a->dlugosc) < std::string_view(b->tekst, b->dlugosc);
+    });
+    std::vector<CzestoscSlowa> wynik;
+    for (size_t i = 0; i < ile; ++i) wynik.push_back({ std::string(wpisy[i]->tekst, wpisy[i]->dlugosc), wpisy[i]->liczba });
+    return wynik;
+}
+
+// Wynik histogramu z mapy po scaleniu (mapy[0]) - wspólny dla obu wersji
+static void uzupelnij_histogram(Metrics& wynik, const MapaSlow& mapa, size_t ile, size_t liczba_map,
+    const PrzygotowanyKorpus& korpus) {
+    uint64_t wszystkie = 0;
+    wynik.najczestsze = najczestsze_slowa(mapa, ile, wszystkie);
+    wynik.count = wszystkie;
+    wynik.bajty = korpus.dane->dane().size();
+    wynik.czas_wczytywania = korpus.czas_wczytywania;
+    size_t rundy = 0;
+    for (size_t krok = 1; krok < liczba_map; krok *= 2) ++rundy;
+    std::ostringstream opis;
+    opis << "Histogram (" << mapa.rozmiar() << " roznych slow, " << liczba_map << " map, scalanie drzewem: " << rundy << " rund)";
+    wynik.silnik = opis.str();
+}
+
+Metrics histogram_slow_Thread(const std::string& sciezka_pliku, size_t ile_najczestszych, int liczba_watkow, const OpcjeSkanowania& opcje) {
+    // Wczytanie pliku poza pomiarem - osobna kolumna czasu
+    auto korpus = przygotuj_korpus_histogramu(sciezka_pliku, opcje);
+
+    Pomiar pomiar = rozpocznij_pomiar();
+
+    // Każdy wątek puli zlicza swoje fragmenty do własnej mapy - bez synchronizacji
+    PulaWatkow& pula = PulaWatkow::wspolna(static_cast<size_t>(liczba_watkow > 0 ? liczba_watkow : 1));
+    const auto& fragmenty = *korpus.fragmenty;
+    std::vector<MapaSlow> mapy(pula.liczba_watkow());
+    pula.wykonaj(fragmenty.size(), [&](size_t zadanie, size_t watek) {
+        zlicz_slowa_fragmentu(korpus, fragmenty[zadanie], opcje, mapy[watek]);
+    });
+    std::vector<StatystykiWatku> statystyki = pula.statystyki();  // Faza tokenizacji - scalanie nadpisze statystyki
+
+    // Drzewo redukcji: w rundzie o kroku k mapa i (wielokrotność 2k) przejmuje mapę i + k - pary scalane równolegle
+    for (size_t krok = 1; krok < mapy.size(); krok *= 2) {
+        const size_t pary = (mapy.size() + 2 * krok - 1) / (2 * krok);
+        pula.wykonaj(pary, [&](size_t para, size_t) {
+            const size_t i = para * 2 * krok;
+            if (i + krok >= mapy.size()) return;  // Mapa bez pary przechodzi do następnej rundy
+            mapy[i].scal(mapy[i + krok]);
+            mapy[i + krok] = MapaSlow(0);  // Zwolnij scaloną mapę
+        });
+    }
+
+    Metrics wynik = zakoncz_pomiar(pomiar);
+    uzupelnij_histogram(wynik, mapy[0], ile_najczestszych, mapy.size(), korpus);
+    wynik.watki = std::move(statystyki);
+    return wynik;
+}
+
+Metrics histogram_slow_OpenMP(const std::string& sciezka_pliku, size_t ile_najczestszych, int liczba_watkow, const OpcjeSkanowania& opcje) {
+    // Wczytanie pliku poza pomiarem - osobna kolumna czasu
+    auto korpus = przygotuj_korpus_histogramu(sciezka_pliku, opcje);
+
+    Pomiar pomiar = rozpocznij_pomiar();
+
+    const auto& fragmenty = *korpus.fragmenty;
+    const int liczba_map = liczba_watkow > 0 ? liczba_watkow : 1;
+    std::vector<MapaSlow> mapy(static_cast<size_t>(liczba_map));
+    omp_set_num_threads(liczba_map);
+
+#pragma omp parallel
+    {
+        // Mapa wątku zespołu - zespół może być mniejszy niż żądano, wtedy część map zostaje pusta
+        MapaSlow& mapa = mapy[omp_get_thread_num()];
+#pragma omp for schedule(dynamic, 4)
+        for (int i = 0; i < static_cast<int>(fragmenty.size()); ++i) {
+            zlicz_slowa_fragmentu(korpus, fragmenty[i], opcje, mapa);
+        }
+
+        // Drzewo redukcji jak w wersji std::thread - niejawna bariera po każdej pętli kończy rundę
+        for (int krok = 1; krok < liczba_map; krok *= 2) {
+#pragma omp for schedule(dynamic, 1)
+            for (int i = 0; i < liczba_map; i += 2 * krok) {
+                if (i + krok < liczba_map) {
+                    mapy[i].scal(mapy[i + krok]);
+                    mapy[i + krok] = MapaSlow(0);
+                }
+            }
+        }
+    }
+
+    Metrics wynik = zakoncz_pomiar(pomiar);
+    uzupelnij_histogram(wynik, mapy[0], ile_najczestszych, mapy.size(), korpus);
+    return wynik;
+}
+
+// Zliczanie wielu słów w jednym przebiegu (Aho-Corasick / Teddy)
+// ===============================================================
+
+// Silnik wielu słów - Teddy dla małych zestawów krótkich słów, Aho-Corasick dla pozostałych
+class SilnikWieluSlow {
+public:
+    SilnikWieluSlow(const std::vector<std::string>& slowa, SilnikWielu wybor) {
+        if (wybor == SilnikWielu::Automatyczny) {
+            // Teddy opłaca się tylko z PSHUFB, przy niewielkiej liczbie słów i pełnym 3-bajtowym odcisku
+            // (krótsze słowa dają zbyt wielu fałszywych kandydatów)
+            size_t najkrotsze = SIZE_MAX;
+            for (const auto& slowo : slowa) {
+                if (!slowo.empty() && slowo.size() < najkrotsze) najkrotsze = slowo.size();
+            }
+            bool maly_zestaw = slowa.size() >= 2 && slowa.size() <= Teddy::MAKS_SLOW && najkrotsze >= 3 && najkrotsze != SIZE_MAX;
+            wybor = (maly_zestaw && obsluguje_ssse3()) ? SilnikWielu::Teddy : SilnikWielu::AhoCorasick;
+        }
+        if (wybor == SilnikWielu::Teddy && slowa.size() <= Teddy::MAKS_SLOW) teddy_ = std::make_unique<Teddy>(slowa);
+        else automat_ = std::make_unique<AhoCorasick>(slowa);
+    }
+
+    void zlicz(std::string_view fragment, size_t min_koniec, size_t max_poczatek, std::vector<uint64_t>& liczniki) const {
+        if (teddy_) teddy_->zlicz(fragment, min_koniec, max_poczatek, liczniki);
+        else automat_->zlicz(fragment, min_koniec, max_poczatek, liczniki);
+    }
+    size_t maks_dlugosc() const { return teddy_ ? teddy_->maks_dlugosc() : automat_->maks_dlugosc(); }
+    const char* nazwa() const { return teddy_ ? teddy_->nazwa() : "Aho-Corasick"; }
+
+private:
+    std::unique_ptr<Teddy> teddy_;
+    std::unique_ptr<AhoCorasick> automat_;
+};
+
+// Zlicza wszystkie słowa we fragmencie z podziel_na_fragmenty - tylko dopasowania zaczynające się
+// w części właściwej fragmentu (krótsze słowa mogą się zmieścić w całości w nakładce)
+static void zlicz_wiele_we_fragmencie(const SilnikWieluSlow& automat, std::string_view fragment,
+    const OpcjeSkanowania& opcje, std::vector<uint64_t>& liczniki) {
+    size_t rozmiar = opcje.rozmiar_fragmentu ? opcje.rozmiar_fragmentu : ROZMIAR_FRAGMENTU;
+    size_t wlasciwa = std::min(rozmiar, fragment.size());
+    automat.zlicz(fragment, 0, wlasciwa, liczniki);
+}
+
+// Zlicza wszystkie słowa w buforze strumienia - tylko dopasowania kończące się za nakładką
+// (te w całości w nakładce zostały policzone w poprzednim buforze)
+static void zlicz_wiele_w_buforze(const SilnikWieluSlow& automat, const StrumienFragmentow& strumien,
+    std::string_view fragment, size_t slot, std::vector<uint64_t>& liczniki) {
+    automat.zlicz(fragment, strumien.nakladka(slot), fragment.size(), liczniki);
+}
+
+// Uzupełnia metryki o liczniki poszczególnych słów
+static void zapisz_liczniki(Metrics& wynik, std::vector<uint64_t> liczniki, size_t liczba_slow) {
+    liczniki.resize(liczba_slow, 0);
+    wynik.count = 0;
+    for (uint64_t x : liczniki) wynik.count += x;
+    wynik.liczniki_slow = std::move(liczniki);
+}
+
+// Wersja sekwencyjna
+Metrics liczba_wielu_slow_sekwencyjny(const std::string& sciezka_pliku, const std::vector<std::string>& slowa, const OpcjeSkanowania& opcje) {
+    // Wczytanie pliku poza pomiarem - osobna kolumna czasu
+    auto korpus = przygotuj_korpus(sciezka_pliku, najdluzsze_slowo(slowa), opcje);
+
+    // Rozpocznij pomiary
+    Pomiar pomiar = rozpocznij_pomiar();
+
+    // Główne przetwarzanie - jeden przebieg po pliku dla wszystkich słów
+    SilnikWieluSlow automat(slowa, opcje.silnik_wielu);
+    std::unique_ptr<StrumienFragmentow> strumien;  // Pierścień buforów żyje do końca pomiaru pamięci
+    std::vector<uint64_t> liczniki(slowa.size(), 0);
+
+    if (opcje.wczytywanie == TrybWczytywania::Strumieniowy) {
+        strumien = otworz_strumien(sciezka_pliku, automat.maks_dlugosc(), 1, opcje);
+        std::string_view fragment;
+        size_t slot;
+        while (strumien->pobierz(fragment, slot)) {
+            zlicz_wiele_w_buforze(automat, *strumien, fragment, slot, liczniki);
+            strumien->zwolnij(slot);
+        }
+    }
+    else {
+        for (const auto& fragment : *korpus.fragmenty) {
+            zlicz_wiele_we_fragmencie(automat, fragment, opcje, liczniki);
+        }
+    }
+
+    // Zakończ pomiary
+    Metrics wynik = zakoncz_pomiar(pomiar);
+    zapisz_liczniki(wynik, std::move(liczniki), slowa.size());
+    wynik.silnik = automat.nazwa();
+    wynik.bajty = strumien ? strumien->wczytano_bajtow() : korpus.dane->dane().size();
+    wynik.czas_wczytywania = korpus.czas_wczytywania;
+    return wynik;
+}
+
+// Wersja z użyciem std::thread
+Metrics liczba_wielu_slow_Thread(const std::string& sciezka_pliku, const std::vector<std::string>& slowa, int liczba_watkow, const OpcjeSkanowania& opcje) {
+    // Wczytanie pliku poza pomiarem - osobna kolumna czasu
+    auto korpus = przygotuj_korpus(sciezka_pliku, najdluzsze_slowo(slowa), opcje);
+
+    // Rozpocznij pomiary
+    Pomiar pomiar = rozpocznij_pomiar();
+
+    // Przygotuj dane
+    SilnikWieluSlow automat(slowa, opcje.silnik_wielu);  // Silnik jest tylko do odczytu - współdzielony przez wątki
+    std::unique_ptr<StrumienFragmentow> strumien;  // Pierścień buforów żyje do końca pomiaru pamięci
+    if (opcje.wczytywanie == TrybWczytywania::Strumieniowy) {
+        strumien = otworz_strumien(sciezka_pliku, automat.maks_dlugosc(), liczba_watkow, opcje);
+    }
+
+    // Liczniki cząstkowe - osobny wektor dla każdego wątku puli
+    PulaWatkow& pula = PulaWatkow::wspolna(static_cast<size_t>(liczba_watkow));
+    std::vector<std::vector<uint64_t>> wyniki(pula.liczba_watkow(), std::vector<uint64_t>(slowa.size(), 0));
+
+    if (strumien) {
+        pula.wykonaj(pula.liczba_watkow(), [&](size_t, size_t watek) {
+            std::string_view fragment;
+            size_t slot;
+            while (strumien->pobierz(fragment, slot)) {
+                zlicz_wiele_w_buforze(automat, *strumien, fragment, slot, wyniki[watek]);
+                strumien->zwolnij(slot);
+            }
+            });
+    }
+    else {
+        const auto& fragmenty = *korpus.fragmenty;
+        pula.wykonaj(fragmenty.size(), [&](size_t i, size_t watek) {
+            zlicz_wiele_we_fragmencie(automat, fragmenty[i], opcje, wyniki[watek]);
+            });
+    }
+
+    // Sumuj wyniki cząstkowe
+    std::vector<uint64_t> liczniki(slowa.size(), 0);
+    for (const auto& w : wyniki) {
+        for (size_t i = 0; i < liczniki.size(); ++i) liczniki[i] += w[i];
+    }
+
+    // Zakończ pomiary
+    Metrics wynik = zakoncz_pomiar(pomiar);
+    zapisz_liczniki(wynik, std::move(liczniki), slowa.size());
+    wynik.silnik = automat.nazwa();
+    wynik.bajty = strumien ? strumien->wczytano_bajtow() : korpus.dane->dane().size();
+    wynik.czas_wczytywania = korpus.czas_wczytywania;
+    wynik.watki = pula.statystyki();
+    return wynik;
+}
+
+// Wersja z użyciem OpenMP
+Metrics liczba_wielu_slow_OpenMP(const std::string& sciezka_pliku, const std::vector<std::string>& slowa, int liczba_watkow, const OpcjeSkanowania& opcje) {
+    // Wczytanie pliku poza pomiarem - osobna kolumna czasu
+    auto korpus = przygotuj_korpus(sciezka_pliku, najdluzsze_slowo(slowa), opcje);
+
+    // Rozpocznij pomiary
+    Pomiar pomiar = rozpocznij_pomiar();
+
+    // Przygotuj dane
+    SilnikWieluSlow automat(slowa, opcje.silnik_wielu);
+    std::unique_ptr<StrumienFragmentow> strumien;  // Pierścień buforów żyje do końca pomiaru pamięci
+    std::vector<uint64_t> liczniki(slowa.size(), 0);
+    omp_set_num_threads(liczba_watkow);// Ustaw liczbę wątków
+
+    if (opcje.wczytywanie == TrybWczytywania::Strumieniowy) {
+        strumien = otworz_strumien(sciezka_pliku, automat.maks_dlugosc(), liczba_watkow, opcje);
+    }
+    const std::vector<std::string_view> brak_fragmentow;
+    const auto& fragmenty = korpus.fragmenty ? *korpus.fragmenty : brak_fragmentow;
+
+    // Każdy wątek liczy do własnego wektora, a na końcu dodaje go do wyniku w sekcji krytycznej
+#pragma omp parallel
+    {
+        std::vector<uint64_t> lokalne(slowa.size(), 0);
+        if (strumien) {
+            std::string_view fragment;
+            size_t slot;
+            while (strumien->pobierz(fragment, slot)) {
+                zlicz_wiele_w_buforze(automat, *strumien, fragment, slot, lokalne);
+                strumien->zwolnij(slot);
+            }
+        }
+        else {
+#pragma omp for schedule(static, 10)
+            for (int i = 0; i < static_cast<int>(fragmenty.size()); ++i) {
+                zlicz_wiele_we_fragmencie(automat, fragmenty[i], opcje, lokalne);
+            }
+        }
+#pragma omp critical
+        for (size_t i = 0; i < liczniki.size(); ++i) liczniki[i] += lokalne[i];
+    }
+
+    // Zakończ pomiary
+    Metrics wynik = zakoncz_pomiar(pomiar);
+    zapisz_liczniki(wynik, std::move(liczniki), slowa.size());
+    wynik.silnik = automat.nazwa();
+    wynik.bajty = strumien ? strumien->wczytano_bajtow() : korpus.dane->dane().size();
+    wynik.czas_wczytywania = korpus.czas_wczytywania;
+    return wynik;
+}
+
+// Wersja z korutynami C++20 - każde słowo jest osobnym zapytaniem jednego potoku korutyn
+Metrics liczba_wielu_slow_korutyny(const std::string& sciezka_pliku, const std::vector<std::string>& slowa, int liczba_watkow, const OpcjeSkanowania& opcje) {
+    std::vector<ZapytanieSkanu> zapytania;
+    for (const auto& slowo : slowa) zapytania.push_back({ sciezka_pliku, slowo });
+
+    // Dosłowne podciągi jak w silnikach wielu słów - wyniki porównywalne z pozostałymi wersjami
+    OpcjeSkanowania doslowne = opcje;
+    doslowne.cale_slowa = false;
+    doslowne.bez_diakrytykow = false;
+    if (doslowne.silnik == SilnikWyszukiwania::Regex) doslowne.silnik = SilnikWyszukiwania::Automatyczny;
+    return zlicz_zapytania_korutynami(zapytania, liczba_watkow, doslowne);
+}
+
+// Porównuje silniki wielu słów z osobnym przebiegiem KMP dla każdego słowa na tych samych fragmentach
+// Plik jest wczytywany raz przed pomiarami, więc porównywany jest wyłącznie czas jąder
+static void porownaj_silniki_wielu_slow(const std::string& sciezka_pliku, const std::vector<std::string>& slowa, const OpcjeSkanowania& opcje) {
+    OpcjeSkanowania opcje_pamieci = opcje;
+    if (opcje_pamieci.wczytywanie == TrybWczytywania::Strumieniowy) opcje_pamieci.wczytywanie = TrybWczytywania::CalyPlik;
+    auto korpus = przygotuj_korpus(sciezka_pliku, najdluzsze_slowo(slowa), opcje_pamieci);
+
+    SilnikWieluSlow teddy(slowa, SilnikWielu::Teddy);
+    SilnikWieluSlow automat(slowa, SilnikWielu::AhoCorasick);
+    const auto& fragmenty = *korpus.fragmenty;
+    const double megabajty = korpus.dane->dane().size() / (1024.0 * 1024.0);
+
+    // Mierzy czas jednego przebiegu po wszystkich fragmentach
+    auto zmierz = [&](const SilnikWieluSlow& silnik, std::vector<uint64_t>& liczniki) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto& fragment : fragmenty) zlicz_wiele_we_fragmencie(silnik, fragment, opcje, liczniki);
+        return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    };
+
+    std::vector<uint64_t> liczniki_teddy(slowa.size(), 0), liczniki_ac(slowa.size(), 0), liczniki_kmp(slowa.size(), 0);
+    double czas_teddy = zmierz(teddy, liczniki_teddy);
+    double czas_ac = zmierz(automat, liczniki_ac);
+
+    // KMP: osobny przebieg dla każdego słowa; fragment przycięty do części właściwej + długość słowa - 1
+    size_t rozmiar = opcje.rozmiar_fragmentu ? opcje.rozmiar_fragmentu : ROZMIAR_FRAGMENTU;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < slowa.size(); ++i) {
+        auto wzorzec = przygotuj_wzorzec(slowa[i], SilnikWyszukiwania::KMP);
+        for (const auto& fragment : fragmenty) {
+            size_t dlugosc = std::min(fragment.size(), rozmiar + (slowa[i].empty() ? 0 : slowa[i].size() - 1));
+            liczniki_kmp[i] += liczba_slow_we_fragmencie(fragment.substr(0, dlugosc), wzorzec);
+        }
+    }
+    double czas_kmp = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    bool zgodne = (liczniki_teddy == liczniki_ac) && (liczniki_ac == liczniki_kmp);
+    std::cout << "\nPorownanie silnikow na tych samych fragmentach (" << megabajty << " MB, " << slowa.size() << " slow):"
+        << "\n" << teddy.nazwa() << ": " << czas_teddy << "s (" << megabajty / czas_teddy << " MB/s)"
+        << "\n" << automat.nazwa() << ": " << czas_ac << "s (" << megabajty / czas_ac << " MB/s)"
+        << "\nKMP osobno dla kazdego slowa: " << czas_kmp << "s (" << megabajty * slowa.size() / czas_kmp << " MB/s)"
+        << "\nZgodnosc wynikow: " << (zgodne ? "tak" : "NIE") << "\n";
+}
+
+// Główna funkcja interfejsu użytkownika
+// =====================================
+
+// Przepustowość w bajtach na cykl na rdzeń - pozwala porównać silniki niezależnie od liczby wątków
+static double bajty_na_cykl(const Metrics& wynik, int liczba_watkow) {
+    if (wynik.cykle == 0 || liczba_watkow <= 0) return 0.0;
+    return static_cast<double>(wynik.bajty) / (static_cast<double>(wynik.cykle) * liczba_watkow);
+}
+
+// Statystyki wątków puli: wykonane zadania, kradzieże i czas bezczynności
+static void wypisz_watki(const Metrics& wynik) {
+    if (wynik.watki.empty()) return;
+    std::cout << "\nWatki puli (zadania/kradzieze/bezczynnosc):";
+    for (size_t i = 0; i < wynik.watki.size(); ++i) {
+        const auto& w = wynik.watki[i];
+        std::cout << " #" << i << ": " << w.zadania << "/" << w.kradzieze << "/" << w.bezczynnosc * 1000.0 << " ms";
+    }
+}
+
+// Przepustowość w MB/s czasu obliczeń
+static double megabajty_na_sekunde(const Metrics& wynik) {
+    return wynik.czas > 0.0 ? static_cast<double>(wynik.bajty) / wynik.czas / 1e6 : 0.0;
+}
+
+// Tryb bez diakrytyków: przepustowość obok dokładnego wyszukiwania tego samego słowa (wersja sekwencyjna)
+static void wypisz_przepustowosc_dokladnej(const std::string& sciezka, const std::string& slowo,
+    const OpcjeSkanowania& opcje, const Metrics& bez_diakrytykow) {
+    OpcjeSkanowania dokladne = opcje;
+    dokladne.bez_diakrytykow = false;
+    const Metrics wynik = liczba_slow_sekwencyjny(sciezka, slowo, dokladne);
+    std::cout << "\nPrzepustowosc (sekwencyjnie): bez diakrytykow " << megabajty_na_sekunde(bez_diakrytykow) << " MB/s ("
+        << bez_diakrytykow.count << " wystapien), dokladnie " << megabajty_na_sekunde(wynik) << " MB/s ("
+        << wynik.count << " wystapien, " << wynik.silnik << ")";
+}
+
+// Filtr n-gramów: odsetek pominiętych fragmentów i przyspieszenie względem skanowania wszystkich fragmentów
+static void wypisz_skutecznosc_filtra(const std::string& sciezka, const std::string& slowo,
+    const OpcjeSkanowania& opcje, const Metrics& z_filtrem) {
+    if (z_filtrem.liczba_fragmentow == 0) return;
+    OpcjeSkanowania bez_filtra = opcje;
+    bez_filtra.filtr_ngramow = false;
+    const Metrics wynik = liczba_slow_sekwencyjny(sciezka, slowo, bez_filtra);
+    std::cout << "\nFiltr 3-gramow (sekwencyjnie): pominieto " << z_filtrem.pominiete_fragmenty << "/" << z_filtrem.liczba_fragmentow
+        << " fragmentow (" << 100.0 * z_filtrem.pominiete_fragmenty / z_filtrem.liczba_fragmentow << "%), czas "
+        << z_filtrem.czas << "s zamiast " << wynik.czas << "s (przyspieszenie x"
+        << (z_filtrem.czas > 0.0 ? wynik.czas / z_filtrem.czas : 0.0) << ")";
+}
+
+// Tryb wyrażeń regularnych: przepustowość automatu obok silnika dosłownego szukającego najdłuższego
+// tekstu dosłownego wyrażenia (obecnego w każdym dopasowaniu) - wersja sekwencyjna
+static void wypisz_porownanie_z_literalem(const std::string& sciezka, const std::string& wyrazenie,
+    const OpcjeSkanowania& opcje, const Metrics& wynik_regex) {
+    std::string blad;
+    const auto skompilowane = WyrazenieRegularne::kompiluj(wyrazenie, blad);
+    if (!skompilowane) {
+        std::cout << "\nBlad wyrazenia: " << blad;
+        return;
+    }
+    if (skompilowane->literal().empty()) {
+        std::cout << "\nPrzepustowosc (sekwencyjnie): wyrazenie " << megabajty_na_sekunde(wynik_regex)
+            << " MB/s (brak tekstu doslownego do porownania)";
+        return;
+    }
+    OpcjeSkanowania doslowne = opcje;
+    doslowne.silnik = SilnikWyszukiwania::Automatyczny;
+    const Metrics wynik = liczba_slow_sekwencyjny(sciezka, skompilowane->literal(), doslowne);
+    std::cout << "\nPrzepustowosc (sekwencyjnie): wyrazenie " << megabajty_na_sekunde(wynik_regex) << " MB/s ("
+        << wynik_regex.count << " dopasowan), tekst doslowny \"" << skompilowane->literal() << "\" "
+        << megabajty_na_sekunde(wynik) << " MB/s (" << wynik.count << " wystapien, " << wynik.silnik << ")";
+}
+
+// Tryb asynchroniczny: przepustowość urządzenia (odczyty w locie) obok przepustowości samego skanowania -
+// czas całkowity bliski dłuższemu z nich oznacza, że odczyt i skanowanie nakładały się w pełni
+static void wypisz_przepustowosc_odczytu(const char* nazwa, const Metrics& wynik) {
+    if (wynik.odczyt.empty()) return;
+    const double urzadzenie = wynik.czas_odczytu > 0.0 ? static_cast<double>(wynik.bajty_urzadzenia) / wynik.czas_odczytu / 1e6 : 0.0;
+    const double skanowanie = wynik.czas_skanowania > 0.0 ? static_cast<double>(wynik.bajty) / wynik.czas_skanowania / 1e6 : 0.0;
+    std::cout << "\nOdczyt " << nazwa << " (" << wynik.odczyt << "): urzadzenie " << urzadzenie << " MB/s ("
+        << wynik.czas_odczytu << "s), skanowanie " << skanowanie << " MB/s (" << wynik.czas_skanowania << "s), calosc "
+        << megabajty_na_sekunde(wynik) << " MB/s (" << wynik.czas << "s)";
+}
+
+// Liczniki jądra wersji: podział czasu CPU, przełączenia kontekstu i błędy stron
+static void wypisz_zasoby(const char* nazwa, const Metrics& wynik) {
+    std::cout << "\n  " << nazwa << ": CPU " << wynik.cpu_uzytkownika << "s / " << wynik.cpu_systemu << "s (watek glowny "
+        << wynik.cpu_watku << "s), przelaczenia " << wynik.przelaczenia_dobrowolne << " / " << wynik.przelaczenia_wymuszone
+        << ", bledy stron " << wynik.bledy_stron << " / " << wynik.bledy_stron_dysku;
+}
+
+// Tryb NUMA: bajty przeskanowane przez wątki każdego węzła i przepustowość węzła (bajty / średni czas pracy wątku)
+static void wypisz_wezly(const char* nazwa, const Metrics& wynik) {
+    if (wynik.wezly.empty()) return;
+    std::cout << "\nWezly NUMA " << nazwa << " (watki/MB/MB/s/kradzieze zdalne):";
+    for (size_t i = 0; i < wynik.wezly.size(); ++i) {
+        const StatystykiWezla& w = wynik.wezly[i];
+        const double czas = w.watki ? w.praca / static_cast<double>(w.watki) : 0.0;
+        std::cout << " #" << i << ": " << w.watki << "/" << w.bajty / 1e6 << "/" << (czas > 0.0 ? w.bajty / czas / 1e6 : 0.0)
+            << "/" << w.kradzieze_zdalne;
+    }
+}
+
+// Tryb pozycji: zapisuje strumień pozycji słowa do <plik>.<numer słowa>.pozycje, podaje jego rozmiar
+// i pierwsze pozycje; strumienie wersji muszą być identyczne (scalanie w kolejności pliku)
+static void zapisz_pozycje_slowa(const std::string& sciezka, size_t numer, const Metrics& seq, const Metrics& thr, const Metrics& omp,
+    const Metrics& kor) {
+    constexpr size_t POKAZ = 10;
+    const std::string plik = sciezka + "." + std::to_string(numer + 1) + ".pozycje";
+    const std::vector<uint64_t> pozycje = dekoduj_pozycje(thr.pozycje);
+    std::cout << "\nPozycje: " << pozycje.size() << " w " << thr.pozycje.size() << " B ("
+        << (pozycje.empty() ? 0.0 : static_cast<double>(thr.pozycje.size()) / pozycje.size()) << " B/pozycje";
+    if (pozycje.size() != thr.count || seq.pozycje != thr.pozycje || omp.pozycje != thr.pozycje
+        || kor.pozycje != thr.pozycje) std::cout << ", NIEZGODNE WERSJE";
+    std::cout << (zapisz_pozycje(plik, thr.pozycje) ? "), zapisane do " + plik : "), nie udalo sie zapisac " + plik) << ":";
+    for (size_t i = 0; i < pozycje.size() && i < POKAZ; ++i) std::cout << " " << pozycje[i];
+    if (pozycje.size() > POKAZ) std::cout << " ...";
+}
+
+// Tryb pozycyjny: czas od otwarcia pliku do wyniku (wczytanie + skanowanie) obok wczytania całego pliku
+// i mmap - bez pamięci podręcznej korpusów, więc każdy pomiar czyta plik od nowa (z pamięci podręcznej systemu,
+// jeśli plik już w niej jest - wtedy porównywany jest koszt kopiowania i mapowania, a nie dysku)
+static void porownaj_wczytywanie(const std::string& sciezka, const std::string& slowo, int liczba_watkow, const OpcjeSkanowania& opcje) {
+    struct Tryb {
+        const char* nazwa;
+        TrybWczytywania wczytywanie;
+    };
+    const Tryb tryby[] = {
+        { "caly plik", TrybWczytywania::CalyPlik },
+        { "mmap", TrybWczytywania::Mmap },
+        { "pread w watkach", TrybWczytywania::Pozycyjny },
+    };
+    std::cout << "\nWczytanie + skanowanie (Threading / OpenMP):";
+    for (const auto& tryb : tryby) {
+        OpcjeSkanowania porownanie = opcje;
+        porownanie.wczytywanie = tryb.wczytywanie;
+        porownanie.pamiec_podreczna = false;
+        const Metrics thr = liczba_slow_Thread(sciezka, slowo, liczba_watkow, porownanie);
+        const Metrics omp = liczba_slow_OpenMP(sciezka, slowo, liczba_watkow, porownanie);
+        std::cout << "\n  " << tryb.nazwa << ": " << thr.czas_wczytywania + thr.czas << "s / " << omp.czas_wczytywania + omp.czas
+            << "s (w tym wczytanie " << thr.czas_wczytywania << "s / " << omp.czas_wczytywania << "s, wynik " << thr.count << ")";
+    }
+}
+
+// Modele wątków spoza trzech stałych wersji na tym samym słowie i danych (backend przez liczba_slow_backend)
+static void porownaj_backendy(const std::string& sciezka, const std::string& slowo, int liczba_watkow, const OpcjeSkanowania& opcje) {
+    const RodzajBackendu rodzaje[] = { RodzajBackendu::OpenMPZadania, RodzajBackendu::StdExecution, RodzajBackendu::ArenaZadan };
+    std::cout << "\nPozostale modele watkow:";
+    for (RodzajBackendu rodzaj : rodzaje) {
+        auto backend = utworz_backend(rodzaj, liczba_watkow);
+        const Metrics wynik = liczba_slow_backend(sciezka, slowo, *backend, opcje);
+        std::cout << "\n  " << wynik.backend << ": " << wynik.count << " (czas: " << wynik.czas << "s, " << megabajty_na_sekunde(wynik)
+            << " MB/s, CPU: " << wynik.cpu_usage << "%, RAM: " << wynik.ram_usage << " B, " << bajty_na_cykl(wynik, liczba_watkow) << " B/cykl/rdzen)";
+    }
+}
+
+// Tryb katalogu: wynik jednej wersji z przepustowością w plikach i bajtach na sekundę
+static void wypisz_wynik_katalogu(const char* nazwa, const Metrics& wynik) {
+    const double pliki_na_sekunde = wynik.czas > 0.0 ? static_cast<double>(wynik.pliki.size()) / wynik.czas : 0.0;
+    std::cout << "\n" << nazwa << ": " << wynik.count << " (czas: " << wynik.czas << "s, " << pliki_na_sekunde << " plikow/s, "
+        << megabajty_na_sekunde(wynik) << " MB/s, CPU: " << wynik.cpu_usage << "%, RAM: " << wynik.ram_usage << " B)";
+}
+
+// Tryb katalogu: pliki z największą liczbą wystąpień
+static void wypisz_pliki_katalogu(const Metrics& wynik) {
+    constexpr size_t LIMIT = 20;
+    std::vector<const WynikPliku*> z_wystapieniami;
+    for (const auto& plik : wynik.pliki) {
+        if (plik.liczba > 0) z_wystapieniami.push_back(&plik);
+    }
+    std::sort(z_wystapieniami.begin(), z_wystapieniami.end(), [](const WynikPliku* a, const WynikPliku* b) { return a->liczba > b->liczba; });
+    std::cout << "\nPliki z wystapieniami: " << z_wystapieniami.size() << "/" << wynik.pliki.size();
+    for (size_t i = 0; i < z_wystapieniami.size() && i < LIMIT; ++i) {
+        std::cout << "\n  " << z_wystapieniami[i]->sciezka << ": " << z_wystapieniami[i]->liczba;
+    }
+    if (z_wystapieniami.size() > LIMIT) std::cout << "\n  ... i " << z_wystapieniami.size() - LIMIT << " kolejnych";
+}
+
+void liczenie_slow() {
+#ifdef _WIN32
+    // Ustawienie kodowania UTF-8 dla konsoli (terminale Linuksa używają UTF-8 domyślnie)
+    system("chcp 65001");
+#endif
+
+    // Pobierz dane od użytkownika
+#ifdef _WIN32
+    std::string nazwa_uzytkownika;  // Ścieżka pliku jest względna wobec pulpitu użytkownika
+    std::cout << "Podaj nazwe uzytkownika: ";
+    std::cin >> nazwa_uzytkownika;
+#endif
+
+    int liczba_watkow;
+    std::cout << "Podaj ilosc watkow: ";
+    std::cin >> liczba_watkow;
+
+    int liczba_slow;
+    std::cout << "Podaj ilosc slow do sprawdzenia (0 - histogram najczestszych slow pliku): ";
+    std::cin >> liczba_slow;
+
+    std::vector<std::string> slowa(liczba_slow);
+    for (int i = 0; i < liczba_slow; ++i) {
+        std::cout << "Podaj " << i + 1 << ". slowo: ";
+        std::cin >> slowa[i];
+    }
+
+    // Skonstruuj pełną ścieżkę do pliku (poza Windows - ścieżka bezwzględna lub względna wobec katalogu roboczego)
+    std::string sciezka_pliku;
+    std::cout << "Podaj sciezke do pliku: ";
+    std::cin >> sciezka_pliku;
+#ifdef _WIN32
+    sciezka_pliku = "C:\\Users\\" + nazwa_uzytkownika + "\\Desktop\\" + sciezka_pliku;
+#endif
+
+    char czy_katalog = 'N';
+    if (!slowa.empty()) {
+        std::cout << "Czy to katalog (wszystkie pliki z podkatalogami)? (T/N): ";
+        std::cin >> czy_katalog;
+    }
+    const bool katalog = (czy_katalog == 'T' || czy_katalog == 't');
+
+    // Wybór sposobu wczytania pliku
+    OpcjeSkanowania opcje;
+    int tryb_wczytywania = 0;
+    if (!katalog) {  // Pliki katalogu są zawsze czytane zakresami do buforów wątków
+        std::cout << "Tryb wczytywania pliku (0 - caly plik do pamieci, 1 - mmap, 2 - strumieniowo ze stala pamiecia, 3 - asynchronicznie z kolejka odczytow, 4 - pozycyjnie (pread w kazdym watku)): ";
+        std::cin >> tryb_wczytywania;
+    }
+    if (tryb_wczytywania == 1) {
+        opcje.wczytywanie = TrybWczytywania::Mmap;
+        char populate;
+        std::cout << "Wczytac wszystkie strony od razu (MAP_POPULATE)? (T/N): ";
+        std::cin >> populate;
+        opcje.wstepne_wczytanie = (populate == 'T' || populate == 't');
+    }
+    else if (tryb_wczytywania == 2) {
+        opcje.wczytywanie = TrybWczytywania::Strumieniowy;
+    }
+    else if (tryb_wczytywania == 3) {  // Zliczanie słowo po słowie; tryb wielu słów wczyta cały plik
+        opcje.wczytywanie = TrybWczytywania::Asynchroniczny;
+        std::cout << "Glebokosc kolejki odczytow (np. 8): ";
+        std::cin >> opcje.glebokosc_kolejki;
+        if (opcje.glebokosc_kolejki == 0) opcje.glebokosc_kolejki = 1;
+        char bez_pamieci;
+        std::cout << "Czytac z pominieciem pamieci podrecznej systemu (O_DIRECT / FILE_FLAG_NO_BUFFERING, fragment musi byc wielokrotnoscia 4 KB)? (T/N): ";
+        std::cin >> bez_pamieci;
+        opcje.bez_pamieci_podrecznej = (bez_pamieci == 'T' || bez_pamieci == 't');
+    }
+    else if (tryb_wczytywania == 4) {  // Zliczanie słowo po słowie; tryb wielu słów wczyta cały plik
+        opcje.wczytywanie = TrybWczytywania::Pozycyjny;
+    }
+
+    size_t rozmiar_kb;
+    std::cout << "Rozmiar fragmentu w KB (0 - domyslnie " << ROZMIAR_FRAGMENTU / 1024 << "): ";
+    std::cin >> rozmiar_kb;
+    if (rozmiar_kb > 0) opcje.rozmiar_fragmentu = rozmiar_kb * 1024;
+
+    if (!katalog && opcje.wczytywanie != TrybWczytywania::Strumieniowy && !odczyt_w_trakcie_skanowania(opcje)) {
+        char wspoldzielony;
+        std::cout << "Wczytac plik raz i wspoldzielic miedzy wersjami i slowami? (T/N): ";
+        std::cin >> wspoldzielony;
+        opcje.pamiec_podreczna = (wspoldzielony == 'T' || wspoldzielony == 't');
+    }
+
+    if (slowa.empty()) {  // Histogram zamiast podanych słów - porównanie modeli wątków na pracy z tablicami skrótów
+        size_t ile;
+        std::cout << "Ile najczestszych slow wypisac: ";
+        std::cin >> ile;
+        auto result_thr = histogram_slow_Thread(sciezka_pliku, ile, liczba_watkow, opcje);
+        auto result_omp = histogram_slow_OpenMP(sciezka_pliku, ile, liczba_watkow, opcje);
+
+        std::cout << "\nNajczestsze slowa (Threading / OpenMP):";
+        for (size_t i = 0; i < result_thr.najczestsze.size(); ++i) {
+            std::cout << "\n" << i + 1 << ". " << result_thr.najczestsze[i].slowo << ": " << result_thr.najczestsze[i].liczba;
+            if (i < result_omp.najczestsze.size()) std::cout << " / " << result_omp.najczestsze[i].liczba;
+        }
+        std::cout << "\n\nPodsumowanie (histogram):"
+            << "\nThreading: " << result_thr.count << " slow (czas: " << result_thr.czas << "s, wczytywanie: " << result_thr.czas_wczytywania << "s, CPU: " << result_thr.cpu_usage << "%, RAM: " << result_thr.ram_usage << " B, " << bajty_na_cykl(result_thr, liczba_watkow) << " B/cykl/rdzen)"
+            << "\nOpenMP: " << result_omp.count << " slow (czas: " << result_omp.czas << "s, wczytywanie: " << result_omp.czas_wczytywania << "s, CPU: " << result_omp.cpu_usage << "%, RAM: " << result_omp.ram_usage << " B, " << bajty_na_cykl(result_omp, liczba_watkow) << " B/cykl/rdzen)"
+            << "\nSilnik: " << result_thr.silnik;
+        wypisz_watki(result_thr);
+        std::cout << "\n";
+        return;
+    }
+
+    int silnik;
+    std::cout << "Silnik wyszukiwania (0 - automatyczny, 1 - KMP, 2 - SIMD [" << nazwa_simd(wykryj_simd()) << "], 3 - Horspool, 4 - slowa sa wyrazeniami regularnymi): ";
+    std::cin >> silnik;
+    if (silnik == 1) opcje.silnik = SilnikWyszukiwania::KMP;
+    else if (silnik == 2) opcje.silnik = SilnikWyszukiwania::SIMD;
+    else if (silnik == 3) opcje.silnik = SilnikWyszukiwania::Horspool;
+    else if (silnik == 4) opcje.silnik = SilnikWyszukiwania::Regex;
+
+    const bool regex = opcje.silnik == SilnikWyszukiwania::Regex;
+    if (regex) {  // Błędy składni przed wczytaniem pliku
+        for (const auto& slowo : slowa) {
+            std::string blad;
+            if (!WyrazenieRegularne::kompiluj(slowo, blad)) std::cout << "Wyrazenie \"" << slowo << "\": " << blad << "\n";
+        }
+    }
+    else {
+        char cale;
+        std::cout << "Liczyc tylko cale slowa (\"kot\" bez \"kotek\" i \"szkoto\")? (T/N): ";
+        std::cin >> cale;
+        opcje.cale_slowa = (cale == 'T' || cale == 't');
+
+        char bez_diakrytykow;
+        std::cout << "Ignorowac wielkosc liter i polskie znaki (\"lodz\" znajdzie tez \"LODZ\" i slowo z ogonkami)? (T/N): ";
+        std::cin >> bez_diakrytykow;
+        opcje.bez_diakrytykow = (bez_diakrytykow == 'T' || bez_diakrytykow == 't');
+    }
+
+    if (katalog) {
+        for (const auto& slowo : slowa) {
+            auto result_seq = liczba_slow_katalog_sekwencyjny(sciezka_pliku, slowo, opcje);
+            auto result_thr = liczba_slow_katalog_Thread(sciezka_pliku, slowo, liczba_watkow, opcje);
+            auto result_omp = liczba_slow_katalog_OpenMP(sciezka_pliku, slowo, liczba_watkow, opcje);
+            std::cout << "\nSlowo: " << slowo << " (" << result_seq.pliki.size() << " plikow, " << result_seq.bajty << " B, listowanie katalogu: " << result_seq.czas_wczytywania << "s)";
+            wypisz_wynik_katalogu("Sekwencyjnie", result_seq);
+            wypisz_wynik_katalogu("Threading", result_thr);
+            wypisz_wynik_katalogu("OpenMP", result_omp);
+            std::cout << "\nSilnik: " << result_seq.silnik;
+            wypisz_watki(result_thr);
+            wypisz_pliki_katalogu(result_thr);
+            std::cout << "\n";
+        }
+        return;
+    }
+
+    if (opcje.cale_slowa && !opcje.bez_diakrytykow) {
+        char z_indeksu;
+        std::cout << "Odpowiadac z indeksu slow (plik .indeks obok korpusu, budowany przy pierwszym uzyciu)? (T/N): ";
+        std::cin >> z_indeksu;
+        if (z_indeksu == 'T' || z_indeksu == 't') {
+            for (const auto& slowo : slowa) {
+                auto wynik = liczba_slow_z_indeksu(sciezka_pliku, slowo, liczba_watkow, opcje);
+                std::cout << "\nSlowo: " << slowo << "\nIndeks: " << wynik.count << " (zapytanie: " << wynik.czas * 1e6
+                    << " us, otwarcie/budowa indeksu: " << wynik.czas_wczytywania << "s)\nSilnik: " << wynik.silnik << "\n";
+            }
+            return;
+        }
+    }
+
+    char jeden_przebieg = 'N';
+    if (!opcje.cale_slowa && !opcje.bez_diakrytykow && !regex) {  // Teddy i Aho-Corasick liczą podciągi
+        std::cout << "Zliczac wszystkie slowa w jednym przebiegu (Teddy / Aho-Corasick)? (T/N): ";
+        std::cin >> jeden_przebieg;
+    }
+    if (jeden_przebieg == 'T' || jeden_przebieg == 't') {
+        // Jeden przebieg po pliku na wersję zamiast jednego na każde słowo
+        auto result_seq = liczba_wielu_slow_sekwencyjny(sciezka_pliku, slowa, opcje);
+        auto result_thr = liczba_wielu_slow_Thread(sciezka_pliku, slowa, liczba_watkow, opcje);
+        auto result_omp = liczba_wielu_slow_OpenMP(sciezka_pliku, slowa, liczba_watkow, opcje);
+
+        for (size_t i = 0; i < slowa.size(); ++i) {
+            std::cout << "\nSlowo: " << slowa[i]
+                << " (Sekwencyjnie: " << result_seq.liczniki_slow[i]
+                << ", Threading: " << result_thr.liczniki_slow[i]
+                << ", OpenMP: " << result_omp.liczniki_slow[i] << ")";
+        }
+        std::cout << "\n\nPodsumowanie (jeden przebieg):"
+            << "\nSekwencyjnie: " << result_seq.count << " (czas: " << result_seq.czas << "s, wczytywanie: " << result_seq.czas_wczytywania << "s, CPU: " << result_seq.cpu_usage << "%, RAM: " << result_seq.ram_usage << " B, " << bajty_na_cykl(result_seq, 1) << " B/cykl/rdzen)"
+            << "\nThreading: " << result_thr.count << " (czas: " << result_thr.czas << "s, wczytywanie: " << result_thr.czas_wczytywania << "s, CPU: " << result_thr.cpu_usage << "%, RAM: " << result_thr.ram_usage << " B, " << bajty_na_cykl(result_thr, liczba_watkow) << " B/cykl/rdzen)"
+            << "\nOpenMP: " << result_omp.count << " (czas: " << result_omp.czas << "s, wczytywanie: " << result_omp.czas_wczytywania << "s, CPU: " << result_omp.cpu_usage << "%, RAM: " << result_omp.ram_usage << " B, " << bajty_na_cykl(result_omp, liczba_watkow) << " B/cykl/rdzen)"
+            << "\nSilnik: " << result_seq.silnik;
+        wypisz_watki(result_thr);
+        std::cout << "\n";
+
+        char porownanie;
+        std::cout << "Porownac Teddy, Aho-Corasick i KMP na tych samych fragmentach? (T/N): ";
+        std::cin >> porownanie;
+        if (porownanie == 'T' || porownanie == 't') porownaj_silniki_wielu_slow(sciezka_pliku, slowa, opcje);
+        return;
+    }
+
+    if (opcje.wczytywanie != TrybWczytywania::Strumieniowy && !odczyt_w_trakcie_skanowania(opcje)
+        && !opcje.bez_diakrytykow && !regex) {
+        char filtr;
+        std::cout << "Pomijac fragmenty bez 3-gramow slowa (streszczenia budowane raz na plik)? (T/N): ";
+        std::cin >> filtr;
+        opcje.filtr_ngramow = (filtr == 'T' || filtr == 't');
+    }
+
+    if (opcje.wczytywanie == TrybWczytywania::CalyPlik && liczba_watkow > 1) {
+        char numa;
+        std::cout << "Rozmiescic watki i fragmenty wedlug wezlow NUMA (" << TopologiaNUMA::systemowa().opis() << ")? (T/N): ";
+        std::cin >> numa;
+        opcje.numa = (numa == 'T' || numa == 't');
+    }
+
+    if (opcje.wczytywanie != TrybWczytywania::Strumieniowy) {
+        char pozycje;
+        std::cout << "Zapisac pozycje wystapien (plik <plik>.<numer slowa>.pozycje, roznice varint)? (T/N): ";
+        std::cin >> pozycje;
+        opcje.pozycje = (pozycje == 'T' || pozycje == 't');
+    }
+
+    bool porownanie_wczytywania = false;
+    if (opcje.wczytywanie == TrybWczytywania::Pozycyjny) {
+        char porownanie;
+        std::cout << "Porownac z wczytaniem calego pliku i mmap? (T/N): ";
+        std::cin >> porownanie;
+        porownanie_wczytywania = (porownanie == 'T' || porownanie == 't');
+    }
+
+    char backendy;
+    std::cout << "Porownac tez pozostale modele watkow (zadania OpenMP, std::execution, arena zadan)? (T/N): ";
+    std::cin >> backendy;
+    const bool porownanie_backendow = (backendy == 'T' || backendy == 't');
+
+    // Zmienne do podsumowania
+    uint64_t total_seq = 0, total_thr = 0, total_omp = 0, total_kor = 0;
+    double time_seq = 0, time_thr = 0, time_omp = 0, time_kor = 0;
+    double load_seq = 0, load_thr = 0, load_omp = 0, load_kor = 0;
+    double cpu_seq = 0, cpu_thr = 0, cpu_omp = 0, cpu_kor = 0;
+    size_t ram_seq = 0, ram_thr = 0, ram_omp = 0, ram_kor = 0;
+
+    for (size_t numer = 0; numer < slowa.size(); ++numer) {
+        const std::string& slowo = slowa[numer];
+
+        // Wywołaj wszystkie implementacje
+        auto result_seq = liczba_slow_sekwencyjny(sciezka_pliku, slowo, opcje);
+        auto result_thr = liczba_slow_Thread(sciezka_pliku, slowo, liczba_watkow, opcje);
+        auto result_omp = liczba_slow_OpenMP(sciezka_pliku, slowo, liczba_watkow, opcje);
+        auto result_kor = liczba_slow_korutyny(sciezka_pliku, slowo, liczba_watkow, opcje);
+
+        // Wyświetl wyniki dla bieżącego słowa
+        std::cout << "\nSlowo: " << slowo
+            << "\nSekwencyjnie: " << result_seq.count << " (czas: " << result_seq.czas << "s, wczytywanie: " << result_seq.czas_wczytywania << "s, CPU: " << result_seq.cpu_usage << "%, RAM: " << result_seq.ram_usage << " B, " << bajty_na_cykl(result_seq, 1) << " B/cykl/rdzen)"
+            << "\nThreading: " << result_thr.count << " (czas: " << result_thr.czas << "s, wczytywanie: " << result_thr.czas_wczytywania << "s, CPU: " << result_thr.cpu_usage << "%, RAM: " << result_thr.ram_usage << " B, " << bajty_na_cykl(result_thr, liczba_watkow) << " B/cykl/rdzen)"
+            << "\nOpenMP: " << result_omp.count << " (czas: " << result_omp.czas << "s, wczytywanie: " << result_omp.czas_wczytywania << "s, CPU: " << result_omp.cpu_usage << "%, RAM: " << result_omp.ram_usage << " B, " << bajty_na_cykl(result_omp, liczba_watkow) << " B/cykl/rdzen)"
+            << "\nKorutyny: " << result_kor.count << " (czas: " << result_kor.czas << "s, wczytywanie: " << result_kor.czas_wczytywania << "s, CPU: " << result_kor.cpu_usage << "%, RAM: " << result_kor.ram_usage << " B, " << bajty_na_cykl(result_kor, liczba_watkow) << " B/cykl/rdzen)"
+            << "\nSilnik: " << result_seq.silnik;
+        wypisz_watki(result_thr);
+        std::cout << "\nZasoby (CPU uzytkownika / jadra, przelaczenia dobrowolne / wymuszone, bledy stron bez dysku / z dyskiem):";
+        wypisz_zasoby("Sekwencyjnie", result_seq);
+        wypisz_zasoby("Threading", result_thr);
+        wypisz_zasoby("OpenMP", result_omp);
+        wypisz_zasoby("Korutyny", result_kor);
+        std::cout << "\nSzczyt pamieci procesu: " << result_kor.szczyt_pamieci << " B";
+        wypisz_przepustowosc_odczytu("sekwencyjnie", result_seq);
+        wypisz_przepustowosc_odczytu("Threading", result_thr);
+        wypisz_przepustowosc_odczytu("OpenMP", result_omp);
+        wypisz_wezly("Threading", result_thr);
+        wypisz_wezly("OpenMP", result_omp);
+        if (opcje.pozycje) zapisz_pozycje_slowa(sciezka_pliku, numer, result_seq, result_thr, result_omp, result_kor);
+        if (porownanie_wczytywania) porownaj_wczytywanie(sciezka_pliku, slowo, liczba_watkow, opcje);
+        if (porownanie_backendow) porownaj_backendy(sciezka_pliku, slowo, liczba_watkow, opcje);
+        if (opcje.bez_diakrytykow) wypisz_przepustowosc_dokladnej(sciezka_pliku, slowo, opcje, result_seq);
+        if (opcje.filtr_ngramow) wypisz_skutecznosc_filtra(sciezka_pliku, slowo, opcje, result_seq);
+        if (regex) wypisz_porownanie_z_literalem(sciezka_pliku, slowo, opcje, result_seq);
+        std::cout << "\n";
+
+        // Aktualizuj statystyki podsumowujące
+        total_seq += result_seq.count;
+        total_thr += result_thr.count;
+        total_omp += result_omp.count;
+        total_kor += result_kor.count;
+
+        time_seq += result_seq.czas;
+        time_thr += result_thr.czas;
+        time_omp += result_omp.czas;
+        time_kor += result_kor.czas;
+
+        load_seq += result_seq.czas_wczytywania;
+        load_thr += result_thr.czas_wczytywania;
+        load_omp += result_omp.czas_wczytywania;
+        load_kor += result_kor.czas_wczytywania;
+
+        cpu_seq += result_seq.cpu_usage;
+        cpu_thr += result_thr.cpu_usage;
+        cpu_omp += result_omp.cpu_usage;
+        cpu_kor += result_kor.cpu_usage;
+
+        ram_seq += result_seq.ram_usage;
+        ram_thr += result_thr.ram_usage;
+        ram_omp += result_omp.ram_usage;
+        ram_kor += result_kor.ram_usage;
+    }
+    // Wyświetl podsumowanie globalne
+    std::cout << "\nPodsumowanie:"
+        << "\nSekwencyjnie: " << total_seq << " (czas: " << time_seq << "s, wczytywanie: " << load_seq << "s, średnie CPU: " << cpu_seq / slowa.size() << "%, RAM: " << ram_seq << " B)"
+        << "\nThreading: " << total_thr << " (czas: " << time_thr << "s, wczytywanie: " << load_thr << "s, średnie CPU: " << cpu_thr / slowa.size() << "%, RAM: " << ram_thr << " B)"
+        << "\nOpenMP: " << total_omp << " (czas: " << time_omp << "s, wczytywanie: " << load_omp << "s, średnie CPU: " << cpu_omp / slowa.size() << "%, RAM: " << ram_omp << " B)"
+        << "\nKorutyny: " << total_kor << " (czas: " << time_kor << "s, wczytywanie: " << load_kor << "s, średnie CPU: " << cpu_kor / slowa.size() << "%, RAM: " << ram_kor << " B)\n";
+}
+
+// Mikrobenchmark jąder zliczających
+// =================================
+
+// Generator xorshift64 - powtarzalne bufory i wzorce bez zależności od <random>
+static uint64_t losuj(uint64_t& stan) {
+    stan ^= stan << 13;
+    stan ^= stan >> 7;
+    stan ^= stan << 17;
+    return stan;
+}
+
+// Tekst z małych liter i spacji (losowe wystąpienia wzorców dłuższych niż kilka znaków praktycznie
+// nie istnieją), w którym na kolejnych polach długości wzorca wstawiany jest wzorzec z prawdopodobieństwem
+// gestosc - wstawione wystąpienia pokrywają średnio taki odsetek bajtów
+static std::string bufor_syntetyczny(size_t rozmiar, const std::string& wzorzec, double gestosc, uint64_t ziarno) {
+    static const char ALFABET[] = "abcdefghijklmnopqrstuvwxyz ";
+    std::string tekst(rozmiar, ' ');
+    uint64_t stan = ziarno;
+    for (char& znak : tekst) znak = ALFABET[losuj(stan) % (sizeof(ALFABET) - 1)];
+    const size_t m = wzorzec.size();
+    // 2^64 * gestosc nie mieści się w uint64_t dla gestosc == 1.0 - wtedy próg obejmuje każde losowanie
+    const uint64_t prog = gestosc >= 1.0 ? UINT64_MAX : static_cast<uint64_t>(std::ldexp(gestosc, 64));
+    for (size_t pole = 0; m > 0 && gestosc > 0.0 && pole + m <= rozmiar; pole += m) {
+        if (losuj(stan) <= prog) tekst.replace(pole, m, wzorzec);
+    }
+    return tekst;
+}
+
+// Wzorzec z samych liter - dosłowny także dla silnika wyrażeń regularnych
+static std::string wzorzec_syntetyczny(size_t dlugosc, uint64_t ziarno) {
+    std::string wzorzec(dlugosc, 'a');
+    uint64_t stan = ziarno;
+    for (char& znak : wzorzec) znak = static_cast<char>('a' + losuj(stan) % 26);
+    return wzorzec;
+}
+
+// Jeden przebieg jądra po buforze pociętym na fragmenty z nakładką jak w podziel_na_fragmenty
+static uint64_t przebieg_jadra(std::string_view tekst, const KMP_Preprocessed& wzorzec, size_t rozmiar_fragmentu) {
+    const size_t nakladka = wzorzec.pattern.empty() ? 0 : wzorzec.pattern.size() - 1;
+    uint64_t wynik = 0;
+    for (size_t od = 0; od < tekst.size(); od += rozmiar_fragmentu) {
+        const std::string_view fragment = tekst.substr(od, rozmiar_fragmentu + nakladka);
+        PolozenieFragmentu polozenie;
+        polozenie.poczatek_pliku = od == 0;
+        polozenie.koniec_pliku = od + fragment.size() == tekst.size();
+        polozenie.wlasciwa = std::min(rozmiar_fragmentu, fragment.size());
+        wynik += liczba_slow_we_fragmencie(fragment, wzorzec, polozenie);
+    }
+    return wynik;
+}
+
+// Średnia i odchylenie standardowe próby
+static void srednia_i_odchylenie(const std::vector<double>& proby, double& srednia, double& odchylenie) {
+    srednia = 0.0;
+    for (double x : proby) srednia += x;
+    srednia /= proby.size();
+    double suma_kwadratow = 0.0;
+    for (double x : proby) suma_kwadratow += (x - srednia) * (x - srednia);
+    odchylenie = proby.size() > 1 ? std::sqrt(suma_kwadratow / (proby.size() - 1)) : 0.0;
+}
+
+std::vector<WynikJadra> mikrobenchmark_jader(const ParametryMikrobenchmarku& parametry) {
+    std::vector<WynikJadra> wyniki;
+    const int powtorzenia = parametry.powtorzenia > 0 ? parametry.powtorzenia : 1;
+    for (size_t dlugosc : parametry.dlugosci) {
+        if (dlugosc == 0) continue;
+        const std::string slowo = wzorzec_syntetyczny(dlugosc, 0x9E3779B97F4A7C15ull + dlugosc);
+        for (double gestosc : parametry.gestosci) {
+            // Ten sam bufor dla wszystkich silników i rozmiarów fragmentu w punkcie
+            const std::string tekst = bufor_syntetyczny(parametry.rozmiar_bufora, slowo, gestosc, 0x2545F4914F6CDD1Dull ^ dlugosc);
+            for (size_t rozmiar_fragmentu : parametry.rozmiary_fragmentu) {
+                if (rozmiar_fragmentu == 0) continue;
+                const uint64_t odniesienie = przebieg_jadra(tekst, przygotuj_wzorzec(slowo, SilnikWyszukiwania::KMP), rozmiar_fragmentu);
+                for (SilnikWyszukiwania silnik : parametry.silniki) {
+                    if (silnik == SilnikWyszukiwania::Bajt && dlugosc != 1) continue;  // Dłuższe wzorce i tak liczy SIMD
+                    const KMP_Preprocessed wzorzec = przygotuj_wzorzec(slowo, silnik, tekst.substr(0, 64 * 1024));
+
+                    WynikJadra wynik{};
+                    wynik.silnik = silnik;
+                    wynik.wybrany = wzorzec.silnik;
+                    wynik.dlugosc = dlugosc;
+                    wynik.gestosc = gestosc;
+                    wynik.rozmiar_fragmentu = rozmiar_fragmentu;
+                    wynik.wystapienia = przebieg_jadra(tekst, wzorzec, rozmiar_fragmentu);  // Rozgrzanie pamięci podręcznej i predyktora
+                    wynik.zgodny = wynik.wystapienia == odniesienie;
+
+                    std::vector<double> ns(powtorzenia), na_cykl(powtorzenia);
+                    for (int p = 0; p < powtorzenia; ++p) {
+                        const uint64_t start_cykle = licznik_cykli();
+                        const auto start = std::chrono::high_resolution_clock::now();
+                        const uint64_t liczba = przebieg_jadra(tekst, wzorzec, rozmiar_fragmentu);
+                        const double czas = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start).count();
+                        const uint64_t cykle = licznik_cykli() - start_cykle;
+                        wynik.zgodny = wynik.zgodny && liczba == odniesienie;  // Wynik używany - kompilator nie usunie przebiegu
+                        ns[p] = czas / tekst.size();
+                        na_cykl[p] = cykle ? static_cast<double>(tekst.size()) / cykle : 0.0;
+                    }
+                    srednia_i_odchylenie(ns, wynik.ns_na_bajt, wynik.odchylenie_ns);
+                    srednia_i_odchylenie(na_cykl, wynik.bajty_na_cykl, wynik.odchylenie_cykli);
+                    wyniki.push_back(wynik);
+                }
+            }
+        }
+    }
+    return wyniki;
+}
+
+void mikrobenchmark() {
+    ParametryMikrobenchmarku parametry;
+    size_t megabajty = 16;
+    std::cout << "Rozmiar bufora w MB (0 - domyslnie 16): ";
+    std::cin >> megabajty;
+    if (megabajty > 0) parametry.rozmiar_bufora = megabajty * 1024 * 1024;
+    std::cout << "Liczba powtorzen kazdego pomiaru (0 - domyslnie 5): ";
+    std::cin >> parametry.powtorzenia;
+    if (parametry.powtorzenia <= 0) parametry.powtorzenia = 5;
+    char czy_automatyczny = 'N';
+    std::cout << "Dodac silnik automatyczny (wybor wedlug probki bufora)? (T/N): ";
+    std::cin >> czy_automatyczny;
+    if (czy_automatyczny == 'T' || czy_automatyczny == 't') parametry.silniki.push_back(SilnikWyszukiwania::Automatyczny);
+
+    std::cout << "\nMikrobenchmark jader zliczajacych (" << parametry.rozmiar_bufora / (1024 * 1024) << " MB, "
+        << parametry.powtorzenia << " powtorzen; SIMD: " << nazwa_simd(wykryj_simd()) << "; srednia +- odchylenie standardowe)\n"
+        << std::left << std::setw(34) << "Silnik" << std::right << std::setw(7) << "Dl." << std::setw(10) << "Gestosc"
+        << std::setw(11) << "Fragment" << std::setw(22) << "ns/B" << std::setw(24) << "B/cykl" << std::setw(13) << "Wystapienia" << "\n";
+    std::cout << std::fixed;
+    for (const WynikJadra& wynik : mikrobenchmark_jader(parametry)) {
+        std::ostringstream ns, na_cykl;
+        ns << std::fixed << std::setprecision(4) << wynik.ns_na_bajt << " +- " << wynik.odchylenie_ns;
+        na_cykl << std::fixed << std::setprecision(3) << wynik.bajty_na_cykl << " +- " << wynik.odchylenie_cykli;
+        const std::string nazwa = (wynik.silnik == SilnikWyszukiwania::Automatyczny ? "Auto: " : "") + nazwa_silnika(wynik.wybrany);
+        std::cout << std::left << std::setw(34) << nazwa << std::right << std::setw(7) << wynik.dlugosc
+            << std::setw(9) << std::setprecision(1) << wynik.gestosc * 100.0 << "%" << std::setw(8) << wynik.rozmiar_fragmentu / 1024 << " KB"
+            << std::setw(22) << ns.str() << std::setw(24) << na_cykl.str() << std::setw(13) << wynik.wystapienia
+            << (wynik.zgodny ? "" : "  NIEZGODNY Z KMP") << "\n";
+    }
+    std::cout.unsetf(std::ios::fixed);
+}
@@ -1,42 +1,301 @@
-#pragma once         // Dyrektywa kompilatora zapobiegajca wielokrotnemu doczaniu tego samego nagwka
-#ifndef LICZENIE_SLOW_H  // Tradycyjny sposb zabezpieczenia przed wielokrotnym include (tzw. include guards)
-#define LICZENIE_SLOW_H
-
-#include <string>    // Biblioteka do obsugi cigw znakw (std::string)
-#include <vector>    // Kontener wektor do przechowywania dynamicznych tablic
-#include <cstddef>   // Definicje standardowe (np. size_t)
-
-// Struktura przechowujca wyniki wraz z metrykami wydajnociowymi
-struct Metrics {
-    int count;         // Liczba znalezionych wystpie sowa
-    double czas;       // Cakowity czas wykonania w sekundach (czas - pol. "time")
-    double cpu_usage;  // Procentowe uycie procesora podczas wykonania (0-100%)
-    size_t ram_usage;  // Zuyta pami operacyjna w bajtach (rnica przed/po wykonaniu)
-};
-
-// Deklaracje funkcji:
-
-// Wersja sekwencyjna - zlicza sowa w pojedynczym wtku
-Metrics liczba_slow_sekwencyjny(
-    const std::string& sciezka_pliku,  // cieka do analizowanego pliku
-    const std::string& slowo           // Szukane sowo
-);
-
-// Wersja wielowtkowa z uyciem std::thread
-Metrics liczba_slow_Thread(
-    const std::string& sciezka_pliku,  // cieka do pliku
-    const std::string& slowo,          // Szukane sowo
-    int liczba_watkow                  // Liczba wtkw do uruchomienia
-);
-
-// Wersja rwnolega z uyciem OpenMP
-Metrics liczba_slow_OpenMP(
-    const std::string& sciezka_pliku,  // cieka do pliku
-    const std::string& slowo,          // Szukane sowo
-    int liczba_watkow                  // Liczba wtkw do uruchomienia
-);
-
-// Gwna funkcja interfejsu uytkownika
-void liczenie_slow();  // Funkcja inicjujca proces zliczania i wywietlajca wyniki
-
+#pragma once         // Dyrektywa kompilatora zapobiegająca wielokrotnemu dołączaniu tego samego nagłówka
+#ifndef LICZENIE_SLOW_H  // Tradycyjny sposób zabezpieczenia przed wielokrotnym include (tzw. include guards)
+#define LICZENIE_SLOW_H
+
+#include <string>    // Biblioteka do obsługi ciągów znaków (std::string)
+#include <vector>    // Kontener wektor do przechowywania dynamicznych tablic
+#include <cstddef>   // Definicje standardowe (np. size_t)
+#include <cstdint>   // uint64_t
+#include "pula_watkow.h"  // StatystykiWatku
+#include "backendy_rownolegle.h"  // BackendRownolegly - model wykonania wersji zliczania
+
+// Domyślny rozmiar części właściwej fragmentu pliku (2MB)
+constexpr size_t ROZMIAR_FRAGMENTU = 2 * 1024 * 1024;
+
+// Słowo histogramu z liczbą wystąpień
+struct CzestoscSlowa {
+    std::string slowo;
+    uint64_t liczba;
+};
+
+// Wynik trybu katalogu dla jednego pliku
+struct WynikPliku {
+    std::string sciezka;
+    uint64_t rozmiar = 0;
+    uint64_t liczba = 0;  // Wystąpienia słowa w pliku
+};
+
+// Praca wątków jednego węzła NUMA (wersje std::thread i OpenMP w trybie NUMA)
+struct StatystykiWezla {
+    size_t watki = 0;
+    uint64_t bajty = 0;           // Bajty fragmentów przeskanowanych przez wątki węzła
+    double praca = 0.0;           // Suma czasów skanowania wątków węzła w sekundach
+    size_t kradzieze_zdalne = 0;  // Fragmenty zabrane wątkom innego węzła (tylko pula wątków)
+};
+
+// Struktura przechowująca wyniki wraz z metrykami wydajnościowymi
+struct Metrics {
+    uint64_t count;    // Liczba znalezionych wystąpień słowa
+    double czas;       // Czas obliczeń w sekundach (czas - pol. "time"); bez wczytania pliku poza trybem strumieniowym
+    double cpu_usage;  // Procentowe użycie procesora podczas wykonania (0-100%)
+    size_t ram_usage;  // Zużyta pamięć operacyjna w bajtach (przyrost pamięci prywatnej - Linux: RssAnon, Windows: PrivateUsage; bez współdzielonego korpusu; w trybie strumieniowym - rozmiar pierścienia)
+    size_t bajty = 0;                 // Liczba bajtów pliku przeskanowanych przez silnik
+    unsigned long long cykle = 0;     // Cykle zegara procesora (RDTSC) w czasie wykonania - do przeliczenia na bajty/cykl
+    double cpu_uzytkownika = 0.0;     // Czas CPU procesu w trybie użytkownika w sekundach
+    double cpu_systemu = 0.0;         // Czas CPU procesu w trybie jądra w sekundach (wywołania systemowe, obsługa błędów stron)
+    double cpu_watku = 0.0;           // Czas CPU wątku mierzącego - przy małej wartości praca przypadła wątkom roboczym
+    size_t szczyt_pamieci = 0;        // Największy zbiór roboczy procesu od startu w bajtach (VmHWM / PeakWorkingSetSize)
+    uint64_t przelaczenia_dobrowolne = 0;  // Przełączenia kontekstu w oczekiwaniu na zasób, np. blokadę lub dysk (Windows: 0)
+    uint64_t przelaczenia_wymuszone = 0;   // Wywłaszczenia przez planistę - więcej wątków niż wolnych procesorów (Windows: 0)
+    uint64_t bledy_stron = 0;         // Błędy stron bez odczytu z dysku (Windows: wszystkie błędy stron)
+    uint64_t bledy_stron_dysku = 0;   // Błędy stron z odczytem z dysku (Windows: 0)
+    std::vector<uint64_t> liczniki_slow;  // Tryb wielu słów: liczba wystąpień każdego słowa (w kolejności podania)
+    std::string silnik;               // Nazwa użytego silnika wyszukiwania
+    double czas_wczytywania = 0.0;    // Wczytanie i podział pliku oraz próbka dla silnika automatycznego w sekundach (prawie 0, gdy korpus był już w pamięci podręcznej)
+    std::vector<StatystykiWatku> watki;  // Wersja std::thread (i arena zadań, OpenMP w trybie NUMA): zadania, kradzieże i bezczynność każdego wątku
+    std::string backend;              // Zliczanie słowo po słowie: nazwa backendu równoległego
+    std::vector<CzestoscSlowa> najczestsze;  // Histogram: najczęstsze słowa pliku (malejąco)
+    size_t pominiete_fragmenty = 0;   // Fragmenty odrzucone przez filtr n-gramów (bez skanowania)
+    size_t liczba_fragmentow = 0;     // Wszystkie fragmenty korpusu (0 w trybie strumieniowym)
+    std::vector<WynikPliku> pliki;    // Tryb katalogu: wystąpienia w każdym pliku (od największego pliku)
+    std::string odczyt;               // Tryb asynchroniczny: użyty mechanizm odczytu
+    uint64_t bajty_urzadzenia = 0;    // Tryb asynchroniczny: bajty odczytane z urządzenia (z nakładkami)
+    double czas_odczytu = 0.0;        // Tryb asynchroniczny: od pierwszego zgłoszenia do ostatniego zakończenia odczytu
+    double czas_skanowania = 0.0;     // Tryb asynchroniczny: suma czasów skanowania fragmentów podzielona przez liczbę wątków
+    std::vector<StatystykiWezla> wezly;  // Tryb NUMA: bajty i czas pracy według węzłów
+    std::string pozycje;              // Tryb pozycji: pozycje dopasowań w kolejności pliku jako różnice varint (dekoduj_pozycje)
+};
+
+// Sposób dostarczenia zawartości pliku do silnika zliczającego
+enum class TrybWczytywania {
+    CalyPlik,  // Kopia całego pliku w std::string (ifstream::read)
+    Mmap,          // Plik zmapowany w pamięci - fragmenty wskazują bezpośrednio na mapowanie
+    Strumieniowy,  // Pierścień buforów o stałym rozmiarze - pamięć nie zależy od rozmiaru pliku
+    Asynchroniczny, // Kolejka odczytów w locie (io_uring / IOCP) - fragmenty skanowane, gdy kolejne są jeszcze czytane (słowo po słowie; inne tryby czytają cały plik)
+    Pozycyjny      // Każdy wątek czyta swój fragment z nakładką (pread) do własnego bufora - bez szeregowej fazy wczytania (jw.)
+};
+
+// Algorytm zliczający wystąpienia wzorca we fragmencie
+enum class SilnikWyszukiwania {
+    KMP,           // Knuth-Morris-Pratt - jeden bajt na iterację
+    SIMD,          // Wektorowy filtr pierwszego/ostatniego bajtu (AVX2/SSE2, wybór w czasie wykonania) + memcmp
+    Horspool,      // Boyer-Moore-Horspool - przeskakuje bajty, opłaca się dla długich wzorców
+    Bajt,          // Zliczanie jednego znaku (tylko wzorce 1-bajtowe; dłuższe są liczone przez SIMD)
+    Regex,         // Słowo jest wyrażeniem regularnym (leniwy DFA) - zliczane są początki dopasowań
+    Automatyczny   // Wybór na podstawie długości wzorca i częstości bajtów w próbce pliku
+};
+
+// Algorytm zliczający wiele słów w jednym przebiegu
+enum class SilnikWielu {
+    Automatyczny,  // Teddy dla 2-32 słów o długości >= 3 (jeśli procesor ma SSSE3), w przeciwnym razie Aho-Corasick
+    AhoCorasick,   // Automat ze spłaszczoną tablicą przejść
+    Teddy          // Wektorowe maski połówek bajtu (PSHUFB) - do 32 słów
+};
+
+// Opcje wspólne dla wszystkich wersji zliczania
+struct OpcjeSkanowania {
+    TrybWczytywania wczytywanie = TrybWczytywania::CalyPlik;  // Sposób wczytania pliku
+    bool wstepne_wczytanie = false;  // Tylko Mmap: wczytaj strony od razu (MAP_POPULATE / PrefetchVirtualMemory)
+    size_t rozmiar_fragmentu = ROZMIAR_FRAGMENTU;  // Rozmiar fragmentu - mniejszy daje lepsze równoważenie obciążenia
+    SilnikWyszukiwania silnik = SilnikWyszukiwania::Automatyczny;  // Algorytm zliczający
+    SilnikWielu silnik_wielu = SilnikWielu::Automatyczny;  // Algorytm w trybie wielu słów
+    bool cale_slowa = false;         // Zliczanie słowo po słowie (poza Regex): tylko całe słowa (litery/cyfry ASCII i polskie litery UTF-8 to znaki słowa)
+    bool bez_diakrytykow = false;    // Zliczanie słowo po słowie: bez rozróżniania wielkości liter i znaków diakrytycznych ("lodz" = "Łódź")
+    bool pamiec_podreczna = true;    // CalyPlik/Mmap: wczytaj plik raz i współdziel go między wersjami, słowami i wywołaniami
+    bool filtr_ngramow = false;      // CalyPlik/Mmap, zliczanie słowo po słowie: pomijaj fragmenty bez 3-gramów słowa (bez trybu bez diakrytyków)
+    size_t glebokosc_kolejki = 8;    // Asynchroniczny: liczba odczytów w locie
+    bool bez_pamieci_podrecznej = false;  // Asynchroniczny: O_DIRECT / FILE_FLAG_NO_BUFFERING (fragment musi być wielokrotnością 4 KB)
+    bool numa = false;               // CalyPlik, wersje std::thread i OpenMP: wątki przypięte do węzłów NUMA, fragment w pamięci węzła wątku, który go skanuje
+    bool pozycje = false;            // Zliczanie słowo po słowie (poza Strumieniowy): zapisz pozycje dopasowań w Metrics::pozycje
+};
+
+// Deklaracje funkcji:
+
+// Wersja sekwencyjna - zlicza słowa w pojedynczym wątku
+Metrics liczba_slow_sekwencyjny(
+    const std::string& sciezka_pliku,  // Ścieżka do analizowanego pliku
+    const std::string& slowo,          // Szukane słowo
+    const OpcjeSkanowania& opcje = {}  // Sposób wczytania pliku i silnik wyszukiwania
+);
+
+// Wersja wielowątkowa z użyciem std::thread
+Metrics liczba_slow_Thread(
+    const std::string& sciezka_pliku,  // Ścieżka do pliku
+    const std::string& slowo,          // Szukane słowo
+    int liczba_watkow,                 // Liczba wątków do uruchomienia
+    const OpcjeSkanowania& opcje = {}  // Sposób wczytania pliku i silnik wyszukiwania
+);
+
+// Wersja równoległa z użyciem OpenMP
+Metrics liczba_slow_OpenMP(
+    const std::string& sciezka_pliku,  // Ścieżka do pliku
+    const std::string& slowo,          // Szukane słowo
+    int liczba_watkow,                 // Liczba wątków do uruchomienia
+    const OpcjeSkanowania& opcje = {}  // Sposób wczytania pliku i silnik wyszukiwania
+);
+
+// Wersja z dowolnym backendem równoległym - trzy powyższe wersje są jej wywołaniami z backendem
+// sekwencyjnym, pulą wątków i OpenMP; nowy model wątków wystarczy dodać w backendy_rownolegle.cpp
+Metrics liczba_slow_backend(
+    const std::string& sciezka_pliku,  // Ścieżka do pliku
+    const std::string& slowo,          // Szukane słowo
+    BackendRownolegly& backend,        // Model wykonania (utworz_backend) - wyznacza też liczbę wątków
+    const OpcjeSkanowania& opcje = {}  // Sposób wczytania pliku i silnik wyszukiwania
+);
+
+// Wersja z korutynami C++20 - każdy fragment jest korutyną, która czeka (co_await) na miejsce w potoku
+// i w trybach odczytu na wczytanie swojego zakresu przez wątki odczytu; korutyny dzieli stała liczba wątków
+// wykonawcy (CalyPlik/Mmap - fragmenty korpusu w pamięci, pozostałe tryby - odczyty zakresów pliku)
+Metrics liczba_slow_korutyny(
+    const std::string& sciezka_pliku,  // Ścieżka do pliku
+    const std::string& slowo,          // Szukane słowo
+    int liczba_watkow,                 // Wątki wykonawcy
+    const OpcjeSkanowania& opcje = {}  // Sposób wczytania pliku, silnik; glebokosc_kolejki - odczyty w locie
+);
+
+// Zapytanie potoku korutyn: słowo w pliku
+struct ZapytanieSkanu {
+    std::string sciezka;
+    std::string slowo;
+};
+
+// Wiele zapytań (pliki x słowa) naraz w jednym potoku korutyn - fragmenty wszystkich zapytań przeplatają się
+// na tych samych wątkach; z pamięcią podręczną korpusów plik jest wczytywany raz na wszystkie słowa
+// Wynik: count - suma wystąpień, liczniki_slow - wystąpienia dla każdego zapytania (w kolejności podania;
+// bez pozycji), bajty - łączny rozmiar różnych plików
+Metrics zlicz_zapytania_korutynami(
+    const std::vector<ZapytanieSkanu>& zapytania,  // Pliki i słowa
+    int liczba_watkow,                             // Wątki wykonawcy
+    const OpcjeSkanowania& opcje = {}              // Wspólne dla wszystkich zapytań
+);
+
+// Zliczanie całych słów z trwałego indeksu (plik <sciezka_pliku>.indeks) - indeks jest budowany równolegle
+// przy pierwszym zapytaniu i ponownie tylko po zmianie rozmiaru lub czasu modyfikacji pliku
+// Wynik: count - wystąpienia jako całe słowo, czas - samo zapytanie, czas_wczytywania - otwarcie lub budowa indeksu
+Metrics liczba_slow_z_indeksu(
+    const std::string& sciezka_pliku,  // Ścieżka do pliku
+    const std::string& slowo,          // Szukane słowo (tekst z kilku słów jest liczony skanowaniem)
+    int liczba_watkow,                 // Wątki tokenizujące korpus przy budowie indeksu
+    const OpcjeSkanowania& opcje = {}  // Sposób wczytania pliku i rozmiar fragmentu przy budowie
+);
+
+// Zliczanie wielu słów w jednym przebiegu po pliku (Teddy lub automat Aho-Corasick)
+// Wynik: count - suma wystąpień wszystkich słów, liczniki_slow - wystąpienia każdego słowa
+
+// Wersja sekwencyjna
+Metrics liczba_wielu_slow_sekwencyjny(
+    const std::string& sciezka_pliku,      // Ścieżka do pliku
+    const std::vector<std::string>& slowa, // Szukane słowa
+    const OpcjeSkanowania& opcje = {}      // Sposób wczytania pliku
+);
+
+// Wersja wielowątkowa z użyciem std::thread
+Metrics liczba_wielu_slow_Thread(
+    const std::string& sciezka_pliku,      // Ścieżka do pliku
+    const std::vector<std::string>& slowa, // Szukane słowa
+    int liczba_watkow,                     // Liczba wątków do uruchomienia
+    const OpcjeSkanowania& opcje = {}      // Sposób wczytania pliku
+);
+
+// Wersja równoległa z użyciem OpenMP
+Metrics liczba_wielu_slow_OpenMP(
+    const std::string& sciezka_pliku,      // Ścieżka do pliku
+    const std::vector<std::string>& slowa, // Szukane słowa
+    int liczba_watkow,                     // Liczba wątków do uruchomienia
+    const OpcjeSkanowania& opcje = {}      // Sposób wczytania pliku
+);
+
+// Wersja z korutynami C++20 - słowa jako osobne zapytania jednego potoku (zlicz_zapytania_korutynami);
+// każde słowo to osobny przebieg po pliku; jak silniki wielu słów liczy dosłowne podciągi (cale_slowa,
+// bez_diakrytykow i Regex są pomijane), a silnik zapytania wybiera opcje.silnik, nie silnik_wielu
+Metrics liczba_wielu_slow_korutyny(
+    const std::string& sciezka_pliku,      // Ścieżka do pliku
+    const std::vector<std::string>& slowa, // Szukane słowa
+    int liczba_watkow,                     // Wątki wykonawcy
+    const OpcjeSkanowania& opcje = {}      // Sposób wczytania pliku, silnik; glebokosc_kolejki - odczyty w locie
+);
+
+// Zliczanie słowa we wszystkich plikach katalogu i jego podkatalogów
+// Małe pliki są pojedynczymi zadaniami, duże - dzielone na fragmenty z nakładką; wszystkie zadania trafiają
+// do jednej partii, a każdy wątek czyta swoje zadania do własnego bufora (opcje.wczytywanie jest pomijane)
+// Wynik: count - suma wystąpień, pliki - wystąpienia w każdym pliku, bajty - łączny rozmiar plików,
+// czas_wczytywania - przejście katalogu (odczyt plików jest częścią czasu obliczeń)
+
+// Wersja sekwencyjna
+Metrics liczba_slow_katalog_sekwencyjny(
+    const std::string& katalog,        // Katalog korpusu
+    const std::string& slowo,          // Szukane słowo
+    const OpcjeSkanowania& opcje = {}  // Rozmiar fragmentu i silnik wyszukiwania
+);
+
+// Wersja wielowątkowa z użyciem std::thread (pula wątków)
+Metrics liczba_slow_katalog_Thread(
+    const std::string& katalog,        // Katalog korpusu
+    const std::string& slowo,          // Szukane słowo
+    int liczba_watkow,                 // Liczba wątków do uruchomienia
+    const OpcjeSkanowania& opcje = {}  // Rozmiar fragmentu i silnik wyszukiwania
+);
+
+// Wersja równoległa z użyciem OpenMP
+Metrics liczba_slow_katalog_OpenMP(
+    const std::string& katalog,        // Katalog korpusu
+    const std::string& slowo,          // Szukane słowo
+    int liczba_watkow,                 // Liczba wątków do uruchomienia
+    const OpcjeSkanowania& opcje = {}  // Rozmiar fragmentu i silnik wyszukiwania
+);
+
+// Histogram wszystkich słów pliku (słowa jak w trybie całych słów)
+// Każdy wątek zlicza swoje fragmenty do własnej mapy z adresowaniem otwartym (klucze wskazują na korpus),
+// a mapy są scalane równolegle drzewem redukcji
+// Wynik: count - liczba wszystkich słów, najczestsze - ile_najczestszych słów z liczbą wystąpień
+
+// Wersja z użyciem std::thread (pula wątków)
+Metrics histogram_slow_Thread(
+    const std::string& sciezka_pliku,  // Ścieżka do pliku
+    size_t ile_najczestszych,          // Liczba słów w wyniku
+    int liczba_watkow,                 // Liczba wątków do uruchomienia
+    const OpcjeSkanowania& opcje = {}  // Sposób wczytania pliku (strumieniowy - zastępowany mapowaniem)
+);
+
+// Wersja równoległa z użyciem OpenMP
+Metrics histogram_slow_OpenMP(
+    const std::string& sciezka_pliku,  // Ścieżka do pliku
+    size_t ile_najczestszych,          // Liczba słów w wyniku
+    int liczba_watkow,                 // Liczba wątków do uruchomienia
+    const OpcjeSkanowania& opcje = {}  // Sposób wczytania pliku (strumieniowy - zastępowany mapowaniem)
+);
+
+// Mikrobenchmark jąder zliczających - liczba_slow_we_fragmencie na syntetycznych buforach w pamięci,
+// bez wczytywania pliku, wątków i liczników procesu; każdy punkt siatki jest mierzony kilka razy
+struct ParametryMikrobenchmarku {
+    std::vector<size_t> dlugosci = { 1, 2, 4, 8, 16, 32, 64, 128, 256 };  // Długości wzorca
+    std::vector<double> gestosci = { 0.0, 0.001, 0.01, 0.1 };  // Odsetek bajtów bufora pokrytych wstawionymi wystąpieniami wzorca
+    std::vector<size_t> rozmiary_fragmentu = { 4 * 1024, 64 * 1024, 1024 * 1024 };  // Części właściwe fragmentów (nakładka: długość - 1)
+    std::vector<SilnikWyszukiwania> silniki = { SilnikWyszukiwania::KMP, SilnikWyszukiwania::SIMD, SilnikWyszukiwania::Horspool,
+        SilnikWyszukiwania::Bajt, SilnikWyszukiwania::Regex };  // Bajt - tylko wzorce 1-bajtowe
+    size_t rozmiar_bufora = 16 * 1024 * 1024;  // Bajty tekstu na jedno powtórzenie
+    int powtorzenia = 5;                       // Pomiary każdego punktu (po jednym przebiegu rozgrzewającym)
+};
+
+// Wynik jednego punktu siatki: średnie i odchylenia standardowe z powtórzeń
+struct WynikJadra {
+    SilnikWyszukiwania silnik;  // Silnik z parametrów
+    SilnikWyszukiwania wybrany; // Silnik, który faktycznie zliczał (inny niż silnik tylko dla Automatyczny)
+    size_t dlugosc;            // Długość wzorca
+    double gestosc;            // Odsetek bajtów pokrytych wystąpieniami
+    size_t rozmiar_fragmentu;  // Część właściwa fragmentu
+    uint64_t wystapienia;      // Wynik zliczania (ten sam dla wszystkich silników w punkcie)
+    bool zgodny;               // Wynik równy wynikowi KMP na tych samych danych
+    double ns_na_bajt;
+    double odchylenie_ns;
+    double bajty_na_cykl;      // Według licznik_cykli() (poza x86 - bajty na nanosekundę)
+    double odchylenie_cykli;
+};
+
+std::vector<WynikJadra> mikrobenchmark_jader(const ParametryMikrobenchmarku& parametry = {});
+
+// Główna funkcja interfejsu użytkownika
+void liczenie_slow();  // Funkcja inicjująca proces zliczania i wyświetlająca wyniki
+void mikrobenchmark(); // Mikrobenchmark jąder z parametrami od użytkownika i tabelą wyników
+
 #endif // LICZENIE_SLOW_H
\ No newline at end of file
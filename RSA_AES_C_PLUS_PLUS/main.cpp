@@ -1,23 +1,30 @@
-#include <iostream>
-#include "liczenie_slow.h"
-#include "rsa_aes.h"
-
-int main() {
-    std::cout << "Wybierz opcje:\n";
-    std::cout << "1. Liczenie sw w pliku\n";
-    std::cout << "2. Szyfrowanie RSA/AES\n";
-    int wybor;
-    std::cin >> wybor;
-
-    if (wybor == 1) {
-        liczenie_slow();
-    }
-    else if (wybor == 2) {
-        szyfrowanie();
-    }
-    else {
-        std::cout << "Nieprawidlowy wybor." << std::endl;
-    }
-
-    return 0;
+#include <iostream>
+#include "liczenie_slow.h"
+#include "rsa_aes.h"
+#include "wiersz_polecen.h"
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) return uruchom_wiersz_polecen(argc, argv);  // Flagi - tryb nieinteraktywny (--pomoc)
+
+    std::cout << "Wybierz opcje:\n";
+    std::cout << "1. Liczenie słów w pliku\n";
+    std::cout << "2. Szyfrowanie RSA/AES\n";
+    std::cout << "3. Mikrobenchmark jąder zliczania słów\n";
+    int wybor;
+    std::cin >> wybor;
+
+    if (wybor == 1) {
+        liczenie_slow();
+    }
+    else if (wybor == 2) {
+        szyfrowanie();
+    }
+    else if (wybor == 3) {
+        mikrobenchmark();
+    }
+    else {
+        std::cout << "Nieprawidlowy wybor." << std::endl;
+    }
+
+    return 0;
 }
\ No newline at end of file
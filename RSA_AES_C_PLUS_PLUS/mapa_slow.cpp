@@ -0,0 +1,75 @@
+// Sekcja includów - dołączanie niezbędnych bibliotek
+#include "mapa_slow.h"             // Deklaracja mapy
+#include "silniki_wyszukiwania.h"  // znak_slowa - te same granice słów co w trybie całych słów
+
+// Mapa z adresowaniem otwartym
+// ============================
+
+MapaSlow::MapaSlow(size_t pojemnosc) {
+    size_t rozmiar = 16;
+    while (rozmiar < pojemnosc) rozmiar *= 2;
+    wpisy_.resize(rozmiar);
+}
+
+void MapaSlow::powieksz() {
+    std::vector<Wpis> stare(wpisy_.size() * 2);
+    stare.swap(wpisy_);
+    const size_t maska = wpisy_.size() - 1;
+    for (const Wpis& wpis : stare) {
+        if (!wpis.tekst) continue;
+        size_t i = static_cast<size_t>(wpis.skrot) & maska;
+        while (wpisy_[i].tekst) i = (i + 1) & maska;  // Klucze są różne - wystarczy wolne miejsce
+        wpisy_[i] = wpis;
+    }
+}
+
+void MapaSlow::scal(const MapaSlow& inna) {
+    for (const Wpis& wpis : inna.wpisy_) {
+        if (wpis.tekst) dodaj(std::string_view(wpis.tekst, wpis.dlugosc), wpis.skrot, wpis.liczba);
+    }
+}
+
+uint64_t MapaSlow::liczba(std::string_view slowo) const {
+    const uint64_t skrot = skrot_slowa(slowo);
+    const size_t maska = wpisy_.size() - 1;
+    for (size_t i = static_cast<size_t>(skrot) & maska; wpisy_[i].tekst; i = (i + 1) & maska) {
+        const Wpis& wpis = wpisy_[i];
+        if (wpis.skrot == skrot && wpis.dlugosc == slowo.size() && memcmp(wpis.tekst, slowo.data(), slowo.size()) == 0) {
+            return wpis.liczba;
+        }
+    }
+    return 0;
+}
+
+void MapaSlow::wyczysc() {
+    for (Wpis& wpis : wpisy_) wpis = Wpis{};
+    zajete_ = 0;
+}
+
+// Tokenizacja
+// ===========
+
+bool bajt_slowa(const char* s, size_t i) {
+    const unsigned char c = static_cast<unsigned char>(s[i]);
+    if (c < 0x80 || c >= 0xC0) return znak_slowa(c);
+    return i > 0 && static_cast<unsigned char>(s[i - 1]) >= 0xC0 && znak_slowa(static_cast<unsigned char>(s[i - 1]));
+}
+
+void zlicz_slowa(std::string_view dane, size_t poczatek, size_t koniec, MapaSlow& mapa) {
+    const char* s = dane.data();
+    const size_t n = dane.size();
+    size_t i = poczatek;
+    if (i > 0) {
+        while (i < koniec && bajt_slowa(s, i) && bajt_slowa(s, i - 1)) ++i;  // Słowo zaczęte w poprzednim fragmencie
+    }
+    while (i < koniec) {
+        if (!bajt_slowa(s, i)) {
+            ++i;
+            continue;
+        }
+        size_t j = i + 1;
+        while (j < n && bajt_slowa(s, j)) ++j;
+        mapa.dodaj(std::string_view(s + i, j - i));
+        i = j;
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once          // Dyrektywa kompilatora zapobiegająca wielokrotnemu dołączaniu
+#ifndef MAPA_SLOW_H      // Tradycyjne zabezpieczenie przed podwójnym include
+#define MAPA_SLOW_H
+
+#include <string_view>  // Klucze - widoki na korpus
+#include <vector>       // Tablica wpisów
+#include <cstddef>      // Definicje standardowe (np. size_t)
+#include <cstdint>      // uint64_t
+#include <cstring>      // memcmp
+
+// Skrót FNV-1a słowa - używany przez MapaSlow i słownik indeksu
+inline uint64_t skrot_slowa(std::string_view slowo) {
+    uint64_t h = 14695981039346656037ull;
+    for (unsigned char c : slowo) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+/**
+ * Mapa słowo -> liczba wystąpień z adresowaniem otwartym (próbkowanie liniowe)
+ * @brief Klucze są widokami na bufor korpusu, więc dodanie słowa nie alokuje pamięci - tablica rośnie
+ *        tylko przy zapełnieniu powyżej 50%. Każdy wątek buduje własną mapę, a mapy są potem scalane.
+ * @note Bufor, na który wskazują klucze, musi żyć dłużej niż mapa.
+ */
+class MapaSlow {
+public:
+    // Wpis tablicy - tekst == nullptr oznacza wolne miejsce
+    struct Wpis {
+        const char* tekst = nullptr;
+        uint64_t skrot = 0;
+        uint64_t liczba = 0;
+        uint32_t dlugosc = 0;
+    };
+
+    explicit MapaSlow(size_t pojemnosc = 1024);  // Zaokrąglana w górę do potęgi 2
+
+    // Zwiększa licznik słowa o `ile` (dodaje słowo, jeśli go nie ma)
+    void dodaj(std::string_view slowo, uint64_t ile = 1) {
+        dodaj(slowo, skrot_slowa(slowo), ile);
+    }
+
+    void dodaj(std::string_view slowo, uint64_t skrot, uint64_t ile) {
+        const size_t maska = wpisy_.size() - 1;
+        for (size_t i = static_cast<size_t>(skrot) & maska;; i = (i + 1) & maska) {
+            Wpis& wpis = wpisy_[i];
+            if (!wpis.tekst) {
+                wpis.tekst = slowo.data();
+                wpis.skrot = skrot;
+                wpis.dlugosc = static_cast<uint32_t>(slowo.size());
+                wpis.liczba = ile;
+                if (++zajete_ * 2 > wpisy_.size()) powieksz();
+                return;
+            }
+            if (wpis.skrot == skrot && wpis.dlugosc == slowo.size() && memcmp(wpis.tekst, slowo.data(), slowo.size()) == 0) {
+                wpis.liczba += ile;
+                return;
+            }
+        }
+    }
+
+    void scal(const MapaSlow& inna);          // Dodaje liczniki innej mapy (skróty nie są liczone ponownie)
+    uint64_t liczba(std::string_view slowo) const;  // 0 - brak słowa
+    size_t rozmiar() const { return zajete_; }      // Liczba różnych słów
+    const std::vector<Wpis>& wpisy() const { return wpisy_; }  // Cała tablica - z wolnymi miejscami
+    void wyczysc();                                  // Usuwa wszystkie słowa, zachowując pojemność
+
+private:
+    void powieksz();  // Podwaja tablicę i rozmieszcza wpisy od nowa
+
+    std::vector<Wpis> wpisy_;
+    size_t zajete_ = 0;
+};
+
+/**
+ * Zlicza słowa zaczynające się w [poczatek, koniec) - słowo może sięgać za koniec, aż do końca danych
+ * @details Słowo to maksymalny ciąg bajtów, dla których bajt_slowa() zwraca true - te same znaki słowa,
+ *          co w trybie całych słów. Fragmenty korpusu liczone tą funkcją dają razem każde słowo dokładnie raz.
+ */
+void zlicz_slowa(std::string_view dane, size_t poczatek, size_t koniec, MapaSlow& mapa);
+
+// Czy bajt na pozycji i należy do słowa: litera/cyfra ASCII, bajt wiodący litery UTF-8
+// albo bajt kontynuacji stojący za takim bajtem wiodącym
+bool bajt_slowa(const char* s, size_t i);
+
+#endif // MAPA_SLOW_H
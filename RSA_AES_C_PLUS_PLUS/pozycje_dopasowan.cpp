@@ -0,0 +1,88 @@
+// Sekcja includów - dołączanie niezbędnych bibliotek
+#include "pozycje_dopasowan.h"  // Deklaracje bufora i strumienia pozycji
+#include <algorithm>            // std::sort
+#include <fstream>              // Zapis strumienia do pliku
+
+// Kodowanie varint
+// ================
+
+void dopisz_varint(std::string& cel, uint64_t wartosc) {
+    while (wartosc >= 0x80) {
+        cel.push_back(static_cast<char>((wartosc & 0x7F) | 0x80));
+        wartosc >>= 7;
+    }
+    cel.push_back(static_cast<char>(wartosc));
+}
+
+std::vector<uint64_t> dekoduj_pozycje(std::string_view strumien) {
+    std::vector<uint64_t> wynik;
+    uint64_t pozycja = 0;
+    uint64_t wartosc = 0;
+    unsigned przesuniecie = 0;
+    for (char znak : strumien) {
+        const unsigned char bajt = static_cast<unsigned char>(znak);
+        if (przesuniecie < 64) wartosc |= static_cast<uint64_t>(bajt & 0x7F) << przesuniecie;
+        przesuniecie += 7;
+        if (bajt & 0x80) continue;
+        pozycja += wartosc;  // Pierwsza wartość jest różnicą względem zera
+        wynik.push_back(pozycja);
+        wartosc = 0;
+        przesuniecie = 0;
+    }
+    return wynik;
+}
+
+// Bufory wątków
+// =============
+
+void BuforPozycji::zamknij_fragment(size_t fragment, uint64_t poczatek) {
+    if (biezace_.empty()) return;  // Fragment bez dopasowań nie tworzy odcinka
+    Odcinek odcinek;
+    odcinek.fragment = fragment;
+    odcinek.pierwsza = poczatek + biezace_.front();
+    odcinek.ostatnia = poczatek + biezace_.back();
+    odcinek.od = dane_.size();
+    for (size_t i = 1; i < biezace_.size(); ++i) dopisz_varint(dane_, biezace_[i] - biezace_[i - 1]);
+    odcinek.do_ = dane_.size();
+    odcinki_.push_back(odcinek);
+    liczba_ += biezace_.size();
+    biezace_.clear();
+}
+
+std::string scal_pozycje(const std::vector<BuforPozycji>& bufory) {
+    // Odcinki wszystkich wątków w kolejności fragmentów - fragment jest skanowany przez jeden wątek
+    std::vector<const BuforPozycji::Odcinek*> odcinki;
+    std::vector<const std::string*> dane;
+    size_t rozmiar = 0;
+    for (const auto& bufor : bufory) {
+        for (const auto& odcinek : bufor.odcinki_) {
+            odcinki.push_back(&odcinek);
+            dane.push_back(&bufor.dane_);
+        }
+        rozmiar += bufor.dane_.size() + bufor.odcinki_.size() * 10;  // Pierwsze różnice odcinków - najwyżej 10 bajtów
+    }
+    std::vector<size_t> kolejnosc(odcinki.size());
+    for (size_t i = 0; i < kolejnosc.size(); ++i) kolejnosc[i] = i;
+    std::sort(kolejnosc.begin(), kolejnosc.end(), [&](size_t a, size_t b) { return odcinki[a]->fragment < odcinki[b]->fragment; });
+
+    std::string wynik;
+    wynik.reserve(rozmiar);
+    uint64_t poprzednia = 0;
+    for (size_t i : kolejnosc) {
+        const auto& odcinek = *odcinki[i];
+        dopisz_varint(wynik, odcinek.pierwsza - poprzednia);  // Fragmenty mają rozłączne, rosnące zakresy dopasowań
+        wynik.append(*dane[i], odcinek.od, odcinek.do_ - odcinek.od);
+        poprzednia = odcinek.ostatnia;
+    }
+    return wynik;
+}
+
+// Zapis
+// =====
+
+bool zapisz_pozycje(const std::string& sciezka, std::string_view strumien) {
+    std::ofstream plik(sciezka, std::ios::binary | std::ios::trunc);
+    if (!plik) return false;
+    plik.write(strumien.data(), static_cast<std::streamsize>(strumien.size()));
+    return static_cast<bool>(plik);
+}
@@ -0,0 +1,73 @@
+#pragma once              // Dyrektywa kompilatora zapobiegająca wielokrotnemu dołączaniu
+#ifndef POZYCJE_DOPASOWAN_H  // Tradycyjne zabezpieczenie przed podwójnym include
+#define POZYCJE_DOPASOWAN_H
+
+#include <string>       // Zakodowany strumień
+#include <string_view>  // Odczyt strumienia
+#include <vector>       // Odcinki i pozycje fragmentu
+#include <cstddef>      // Definicje standardowe (np. size_t)
+#include <cstdint>      // uint64_t - pozycje w pliku
+
+/**
+ * Pozycje dopasowań zebrane przez jeden wątek, zakodowane różnicowo odcinkami - jeden odcinek na fragment
+ * @brief Wątek skanuje fragmenty w dowolnej kolejności (podkradanie zadań, kolejka odczytów), więc każdy
+ *        fragment jest osobnym odcinkiem z numerem fragmentu. Wewnątrz odcinka zapisywane są tylko różnice
+ *        między kolejnymi pozycjami (varint), a pierwsza pozycja odcinka - osobno, bo jej różnicę względem
+ *        poprzedniego dopasowania w pliku zna dopiero scal_pozycje.
+ */
+class BuforPozycji {
+public:
+    // Pozycje bieżącego fragmentu (względem jego początku, rosnąco) - wypełnia liczba_slow_we_fragmencie
+    std::vector<size_t>& biezace() { return biezace_; }
+
+    /**
+     * Koduje biezace() jako odcinek fragmentu i czyści je
+     * @param fragment Numer fragmentu w pliku - kolejność scalania
+     * @param poczatek Przesunięcie fragmentu w pliku
+     */
+    void zamknij_fragment(size_t fragment, uint64_t poczatek);
+
+    uint64_t liczba() const { return liczba_; }  // Wszystkie zapisane pozycje
+
+private:
+    friend std::string scal_pozycje(const std::vector<BuforPozycji>& bufory);
+
+    struct Odcinek {
+        size_t fragment;
+        uint64_t pierwsza;  // Pozycja bezwzględna pierwszego dopasowania
+        uint64_t ostatnia;  // Pozycja bezwzględna ostatniego dopasowania
+        size_t od, do_;     // Różnice pozostałych dopasowań: dane_[od, do_)
+    };
+
+    std::vector<size_t> biezace_;
+    std::vector<Odcinek> odcinki_;
+    std::string dane_;
+    uint64_t liczba_ = 0;
+};
+
+/**
+ * Scala bufory wątków w kolejności fragmentów w jeden strumień
+ * @return Strumień varint (LEB128: 7 bitów na bajt, najstarszy bit - kolejny bajt): pierwsza pozycja,
+ *         potem różnice kolejnych pozycji w pliku. Odcinki są kopiowane bez dekodowania - przeliczana
+ *         jest tylko pierwsza różnica każdego odcinka.
+ */
+std::string scal_pozycje(const std::vector<BuforPozycji>& bufory);
+
+/**
+ * Dopisuje liczbę w kodowaniu varint (1 bajt dla różnic < 128, 2 - < 16384 itd.)
+ */
+void dopisz_varint(std::string& cel, uint64_t wartosc);
+
+/**
+ * Odczytuje strumień z scal_pozycje jako pozycje bezwzględne
+ * @return Pozycje rosnąco; urwany ostatni varint jest pomijany
+ */
+std::vector<uint64_t> dekoduj_pozycje(std::string_view strumien);
+
+/**
+ * Zapisuje strumień pozycji do pliku (binarnie, bez nagłówka)
+ * @return false, gdy pliku nie udało się zapisać
+ */
+bool zapisz_pozycje(const std::string& sciezka, std::string_view strumien);
+
+#endif // POZYCJE_DOPASOWAN_H
@@ -0,0 +1,150 @@
+// Sekcja includów - dołączanie niezbędnych bibliotek
+#include "pula_watkow.h"  // Deklaracja puli
+#include "topologia_numa.h"  // Węzły NUMA i przypinanie wątków
+#include <chrono>         // Pomiar czasu pracy i bezczynności
+
+// Tworzenie i zatrzymywanie puli
+// ==============================
+
+PulaWatkow::PulaWatkow(size_t liczba_watkow, bool numa) : numa_(numa) {
+    if (liczba_watkow == 0) liczba_watkow = 1;
+    statystyki_.resize(liczba_watkow);
+    czas_pracy_.resize(liczba_watkow, 0.0);
+
+    // Kolejność kradzieży: od sąsiada (rozkłada złodziei między ofiary), w trybie NUMA najpierw własny węzeł
+    wezly_.assign(liczba_watkow, 0);
+    if (numa_) {
+        for (size_t i = 0; i < liczba_watkow; ++i) wezly_[i] = TopologiaNUMA::systemowa().wezel_watku(i, liczba_watkow);
+    }
+    ofiary_.resize(liczba_watkow);
+    for (size_t id = 0; id < liczba_watkow; ++id) {
+        for (int zdalne = 0; zdalne < 2; ++zdalne) {
+            for (size_t krok = 1; krok < liczba_watkow; ++krok) {
+                const size_t ofiara = (id + krok) % liczba_watkow;
+                if ((wezly_[ofiara] != wezly_[id]) == (zdalne != 0)) ofiary_[id].push_back(ofiara);
+            }
+        }
+    }
+    for (size_t i = 0; i < liczba_watkow; ++i) kolejki_.push_back(std::make_unique<Kolejka>());
+    for (size_t i = 0; i < liczba_watkow; ++i) watki_.emplace_back(&PulaWatkow::petla, this, i);
+}
+
+PulaWatkow::~PulaWatkow() {
+    {
+        std::lock_guard<std::mutex> blokada(mutex_);
+        zatrzymaj_ = true;
+    }
+    nowa_partia_.notify_all();
+    for (auto& t : watki_) t.join();
+}
+
+PulaWatkow& PulaWatkow::wspolna(size_t liczba_watkow, bool numa) {
+    static std::mutex mutex;
+    static std::unique_ptr<PulaWatkow> pula;
+    std::lock_guard<std::mutex> blokada(mutex);
+    if (liczba_watkow == 0) liczba_watkow = 1;
+    if (!pula || pula->liczba_watkow() != liczba_watkow || pula->numa() != numa) {
+        pula.reset();  // Najpierw zatrzymaj stare wątki
+        pula = std::make_unique<PulaWatkow>(liczba_watkow, numa);
+    }
+    return *pula;
+}
+
+// Wykonywanie partii zadań
+// ========================
+
+void PulaWatkow::wykonaj(size_t liczba_zadan, const std::function<void(size_t, size_t)>& zadanie) {
+    std::lock_guard<std::mutex> wywolanie(wywolanie_);
+    const size_t n = watki_.size();
+    for (size_t id = 0; id < n; ++id) {
+        statystyki_[id] = StatystykiWatku{};
+        statystyki_[id].wezel = wezly_[id];
+    }
+    if (liczba_zadan == 0) return;
+
+    // Ciągłe bloki zadań dla kolejnych wątków - sąsiednie fragmenty trafiają do tego samego wątku
+    const size_t na_watek = (liczba_zadan + n - 1) / n;
+    for (size_t id = 0; id < n; ++id) {
+        std::lock_guard<std::mutex> blokada(kolejki_[id]->mutex);
+        auto& kolejka = kolejki_[id]->zadania;
+        kolejka.clear();
+        for (size_t i = id * na_watek; i < liczba_zadan && i < (id + 1) * na_watek; ++i) kolejka.push_back(i);
+    }
+
+    const auto poczatek = std::chrono::steady_clock::now();
+    {
+        std::unique_lock<std::mutex> blokada(mutex_);
+        zadanie_ = &zadanie;
+        aktywne_ = n;
+        ++partia_;
+        nowa_partia_.notify_all();
+        koniec_partii_.wait(blokada, [&] { return aktywne_ == 0; });  // Wszystkie wątki opuściły partię
+        zadanie_ = nullptr;
+    }
+    const double czas_partii = std::chrono::duration<double>(std::chrono::steady_clock::now() - poczatek).count();
+
+    for (size_t id = 0; id < n; ++id) {
+        double bezczynnosc = czas_partii - czas_pracy_[id];
+        statystyki_[id].bezczynnosc = bezczynnosc > 0.0 ? bezczynnosc : 0.0;
+        statystyki_[id].praca = czas_pracy_[id];
+    }
+}
+
+bool PulaWatkow::pobierz(size_t id, size_t& zadanie, size_t& zrodlo) {
+    {
+        Kolejka& wlasna = *kolejki_[id];
+        std::lock_guard<std::mutex> blokada(wlasna.mutex);
+        if (!wlasna.zadania.empty()) {
+            zadanie = wlasna.zadania.back();
+            wlasna.zadania.pop_back();
+            zrodlo = id;
+            return true;
+        }
+    }
+
+    // Własna kolejka pusta - przeszukaj pozostałe w kolejności ofiary_ (w trybie NUMA najpierw własny węzeł)
+    for (size_t ofiara : ofiary_[id]) {
+        Kolejka& cudza = *kolejki_[ofiara];
+        std::lock_guard<std::mutex> blokada(cudza.mutex);
+        if (!cudza.zadania.empty()) {
+            zadanie = cudza.zadania.front();  // Z przeciwnego końca niż właściciel - najdalej od jego bieżącej pracy
+            cudza.zadania.pop_front();
+            zrodlo = ofiara;
+            return true;
+        }
+    }
+    return false;
+}
+
+void PulaWatkow::petla(size_t id) {
+    if (numa_) TopologiaNUMA::systemowa().przypnij_watek(id, kolejki_.size());  // Wątek zostaje na swoim procesorze do końca życia puli
+    size_t ostatnia_partia = 0;
+    for (;;) {
+        const std::function<void(size_t, size_t)>* zadanie;
+        {
+            std::unique_lock<std::mutex> blokada(mutex_);
+            nowa_partia_.wait(blokada, [&] { return zatrzymaj_ || partia_ != ostatnia_partia; });
+            if (zatrzymaj_) return;
+            ostatnia_partia = partia_;
+            zadanie = zadanie_;
+        }
+
+        // Zadania nie tworzą nowych zadań, więc gdy wszystkie kolejki są puste, partia jest dla tego wątku skończona
+        StatystykiWatku& statystyki = statystyki_[id];
+        double czas_pracy = 0.0;
+        size_t numer;
+        size_t zrodlo;
+        while (pobierz(id, numer, zrodlo)) {
+            const auto start = std::chrono::steady_clock::now();
+            (*zadanie)(numer, id);
+            czas_pracy += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            ++statystyki.zadania;
+            if (zrodlo != id) ++statystyki.kradzieze;
+            if (wezly_[zrodlo] != wezly_[id]) ++statystyki.kradzieze_zdalne;
+        }
+        czas_pracy_[id] = czas_pracy;
+
+        std::lock_guard<std::mutex> blokada(mutex_);
+        if (--aktywne_ == 0) koniec_partii_.notify_one();
+    }
+}
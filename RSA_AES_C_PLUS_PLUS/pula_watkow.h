@@ -0,0 +1,92 @@
+#pragma once          // Dyrektywa kompilatora zapobiegająca wielokrotnemu dołączaniu
+#ifndef PULA_WATKOW_H    // Tradycyjne zabezpieczenie przed podwójnym include
+#define PULA_WATKOW_H
+
+#include <cstddef>             // Definicje standardowe (np. size_t)
+#include <vector>              // Kolejki i statystyki wątków
+#include <deque>               // Kolejka zadań każdego wątku
+#include <thread>              // Wątki robocze
+#include <mutex>               // Ochrona kolejek i stanu partii
+#include <condition_variable>  // Budzenie wątków i oczekiwanie na koniec partii
+#include <functional>          // std::function dla zadania
+#include <memory>              // std::unique_ptr dla kolejek
+
+// Statystyki jednego wątku puli z ostatniego wywołania wykonaj()
+struct StatystykiWatku {
+    size_t zadania = 0;        // Liczba wykonanych zadań (fragmentów)
+    size_t kradzieze = 0;      // Liczba zadań zabranych z kolejek innych wątków
+    double bezczynnosc = 0.0;  // Czas w sekundach, w którym wątek nie miał pracy (od startu partii do jej końca)
+    double praca = 0.0;        // Czas wykonywania zadań w sekundach
+    size_t wezel = 0;          // Węzeł NUMA wątku (0 poza trybem NUMA)
+    size_t kradzieze_zdalne = 0;  // Kradzieże z kolejek wątków innego węzła NUMA
+};
+
+/**
+ * Długo żyjąca pula wątków z podkradaniem zadań (work stealing)
+ * @brief Każdy wątek ma własną kolejkę numerów zadań. Zadania są rozdzielane ciągłymi blokami
+ *        (jak przy statycznym podziale), wątek zdejmuje je z końca własnej kolejki, a gdy ta się
+ *        opróżni - zabiera zadania z początku kolejek innych wątków. Wolniejszy rdzeń nie blokuje
+ *        więc całej partii, a wątki są tworzone raz i używane ponownie dla kolejnych słów i wywołań.
+ * @details W trybie NUMA wątki są przypięte do procesorów według TopologiaNUMA (kolejne bloki wątków
+ *          na kolejnych węzłach), a pusty wątek kradnie najpierw od wątków swojego węzła - zadania,
+ *          których dane leżą w pamięci innego węzła, zabiera dopiero, gdy w jego węźle nie ma już pracy.
+ */
+class PulaWatkow {
+public:
+    explicit PulaWatkow(size_t liczba_watkow, bool numa = false);
+    ~PulaWatkow();  // Zatrzymuje i dołącza wątki
+
+    PulaWatkow(const PulaWatkow&) = delete;
+    PulaWatkow& operator=(const PulaWatkow&) = delete;
+
+    /**
+     * Wykonuje partię zadań i czeka na jej zakończenie
+     * @param liczba_zadan Liczba zadań - numery 0..liczba_zadan-1
+     * @param zadanie Funkcja wywoływana jako zadanie(numer_zadania, numer_watku); numer wątku
+     *        pozwala używać wyników cząstkowych bez synchronizacji
+     * @note Wywołania z różnych wątków są wykonywane po kolei
+     */
+    void wykonaj(size_t liczba_zadan, const std::function<void(size_t, size_t)>& zadanie);
+
+    size_t liczba_watkow() const { return watki_.size(); }
+    bool numa() const { return numa_; }
+    size_t wezel_watku(size_t id) const { return wezly_[id]; }
+    const std::vector<StatystykiWatku>& statystyki() const { return statystyki_; }  // Z ostatniej partii
+
+    /**
+     * Zwraca pulę współdzieloną przez wszystkie wywołania w procesie
+     * @param liczba_watkow Żądana liczba wątków - pula jest tworzona od nowa tylko przy jej zmianie
+     * @param numa Wątki przypięte do węzłów NUMA - zmiana również tworzy pulę od nowa
+     */
+    static PulaWatkow& wspolna(size_t liczba_watkow, bool numa = false);
+
+private:
+    // Kolejka zadań jednego wątku - właściciel zdejmuje z końca, złodzieje z początku
+    struct Kolejka {
+        std::mutex mutex;
+        std::deque<size_t> zadania;
+    };
+
+    void petla(size_t id);                            // Pętla wątku roboczego
+    bool pobierz(size_t id, size_t& zadanie, size_t& zrodlo);  // Własna kolejka, potem cudze; zrodlo - właściciel kolejki
+
+    std::vector<std::thread> watki_;
+    std::vector<std::unique_ptr<Kolejka>> kolejki_;
+    std::vector<StatystykiWatku> statystyki_;
+    std::vector<double> czas_pracy_;                  // Czas wykonywania zadań w bieżącej partii
+    bool numa_ = false;
+    std::vector<size_t> wezly_;                       // Węzeł NUMA każdego wątku
+    std::vector<std::vector<size_t>> ofiary_;         // Kolejność przeszukiwania cudzych kolejek każdego wątku
+
+    const std::function<void(size_t, size_t)>* zadanie_ = nullptr;  // Funkcja bieżącej partii
+    size_t partia_ = 0;                               // Numer partii - zmiana budzi wątki
+    size_t aktywne_ = 0;                              // Wątki, które nie zakończyły jeszcze bieżącej partii
+    bool zatrzymaj_ = false;
+
+    std::mutex mutex_;                                // Stan partii
+    std::condition_variable nowa_partia_;
+    std::condition_variable koniec_partii_;
+    std::mutex wywolanie_;                            // Serializuje wywołania wykonaj()
+};
+
+#endif // PULA_WATKOW_H
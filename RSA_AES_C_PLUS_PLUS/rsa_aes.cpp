@@ -1,473 +1,356 @@
-
-#include "cryptlib.h"   // Gwna biblioteka Crypto++
-#include "osrng.h"      // Generator liczb losowych
-#include "aes.h"        // Algorytm AES
-#include "modes.h"      // Tryby pracy szyfrw blokowych
-#include "filters.h"    // Filtry do przetwarzania danych
-#include "hex.h"        // Kodowanie heksadecymalne
-#include "rsa.h"        // Algorytm RSA
-#include "pem.h"        // Obsuga kluczy PEM
-#include <iostream>      // Obsuga wejcia i wyjcia
-#include "files.h"      // Obsuga plikw
-
-// Obsuga konfliktw z definicjami Windows
-#ifdef _WIN32
-#undef BOOLEAN              // Usu konfliktujc definicj
-#endif
-
-
-#include <windows.h>     // Windows API
-#include <psapi.h>       // Monitorowanie zasobw
-
-// Przywr oryginaln definicj BOOLEAN dla Windows
-#define BOOLEAN WINBOOL
-
-// Linkowanie z bibliotekami
-
-#pragma comment(lib, "psapi.lib")      // Biblioteka do monitorowania procesw
-#pragma comment(lib, "cryptlib.lib")   // Biblioteka Crypto++
-
-// Alias dla przestrzeni nazw CryptoPP
-namespace CP = CryptoPP;
-
-using namespace std;
-
-
-void GetProcessorTimes(FILETIME& userTime, FILETIME& kernelTime);
-double FileTimeToSeconds(const FILETIME& ft);
-void PrintResourceUsage(double cpuUsage, const PROCESS_MEMORY_COUNTERS& pmc);
-
-
-// Implementacja AES
-// =================
-
-/**
- * Szyfruje i deszyfruje tekst przy uyciu AES-CTR
- * @param plaintext Tekst do zaszyfrowania
- * @param keySize Rozmiar klucza (128, 192, 256)
- */
-void EncryptDecryptAES(string plaintext, int keySize) {
-    CP::AutoSeededRandomPool prng; // Kryptograficzny generator liczb losowych
-
-    // Walidacja rozmiaru klucza
-    if (keySize != 128 && keySize != 192 && keySize != 256) {
-        cerr << "Nieprawidlowy rozmiar klucza AES." << endl;
-        return;
-    }
-    // Generacja klucza i IV
-    int keyLength = keySize / 8; // Konwersja bitw na bajty
-    CP::SecByteBlock key(keyLength); // Klucz AES
-    CP::SecByteBlock iv(CP::AES::BLOCKSIZE); // Wektor inicjalizujcy (IV)
-
-    prng.GenerateBlock(key, key.size()); // Generowanie losowego klucza AES
-    prng.GenerateBlock(iv, iv.size());   // Generowanie losowego IV // Wektor inicjujcy (16 bajtw)
-
-    // Konwersja klucza do hex
-    string strKey;
-    CP::HexEncoder keyEncoder(new CP::StringSink(strKey));
-    keyEncoder.Put(key, key.size());
-    keyEncoder.MessageEnd();
-
-    cout << "Klucz AES (szesnastkowo): " << endl << strKey << endl;
-
-    string cipher, recovered;
-    cout << "Tekst oryginalny: " << plaintext << endl;
-
-    try {
-        // Inicjalizacja szyfrowania AES w trybie CTR
-        CP::CTR_Mode<CP::AES>::Encryption e;
-        e.SetKeyWithIV(key, key.size(), iv);
-
-        // Szyfrowanie tekstu // Kodowanie tekstu jawnego do hex przed szyfrowaniem
-        string encodedPlain;
-        CP::StringSource(plaintext, true,
-            new CP::HexEncoder(
-                new CP::StringSink(encodedPlain)
-            )
-        );
-        // Przeprocesowanie szyfrowania
-        CP::StringSource(encodedPlain, true,
-            new CP::StreamTransformationFilter(e,
-                new CP::StringSink(cipher)
-            )
-        );
-
-        cout << "Zaszyfrowany tekst (w heksadecymalnym): ";
-        CP::StringSource(cipher, true,
-            new CP::HexEncoder(
-                new CP::FileSink(cout)
-            )
-        );
-        cout << endl;
-
-        // Deszyfrowanie
-        CP::CTR_Mode<CP::AES>::Decryption d;
-        d.SetKeyWithIV(key, key.size(), iv);
-        CP::StringSource(cipher, true,
-            new CP::StreamTransformationFilter(d,
-                new CP::StringSink(recovered)
-            )
-        );
-        // Dekodowanie z hex
-        string decodedRecovered;
-        CP::StringSource(recovered, true,
-            new CP::HexDecoder(
-                new CP::StringSink(decodedRecovered)
-            )
-        );
-        // Wywietl IV
-        string strIV;
-        CP::HexEncoder ivEncoder(new CP::StringSink(strIV));
-        ivEncoder.Put(iv, iv.size());
-        ivEncoder.MessageEnd();
-
-        cout << "Wektor inicjujacy (IV) (szesnastkowo): " << endl << strIV << endl;
-        cout << "Tekst odszyfrowany: " << decodedRecovered << endl;
-        // Weryfikacja poprawnoci
-        if (plaintext != decodedRecovered) {
-            cout << "Blad: Tekst odszyfrowany rozni sie od oryginalnego!" << endl;
-        }
-    }
-    catch (const CP::Exception& e) {
-        cerr << "CryptoPP blad: " << e.what() << endl;
-        exit(1);
-    }
-}
-// Implementacja RSA
-// =================
-
-/**
- * Szyfruje i deszyfruje tekst przy uyciu RSA-OAEP
- * @param plaintext Tekst do zaszyfrowania
- * @param bytes Dugo klucza w bitach (512-4096)
- */
-void EncryptDecryptRSA(string plaintext, int bytes) {
-    CP::AutoSeededRandomPool rng;// Generator kryptograficzny
-    
-    // Walidacja dugoci klucza
-    if (bytes < 512 || bytes > 4096) {
-        cerr << "Nieprawidlowa dlugosc klucza RSA" << endl;
-        return;
-    }
-
-    // Generacja pary kluczy
-    CP::InvertibleRSAFunction params;
-    params.GenerateRandomWithKeySize(rng, bytes);  // Generuj parametry RSA
-
-    CP::RSA::PrivateKey privateKey(params);  // Klucz prywatny
-    CP::RSA::PublicKey publicKey(params);     // Klucz publiczny
-    
-    // Eksport kluczy do hex
-    string strPrivateKey, strPublicKey;
-    CP::HexEncoder privateKeyEncoder(new CP::StringSink(strPrivateKey));
-    CP::HexEncoder publicKeyEncoder(new CP::StringSink(strPublicKey));
-
-    privateKey.Save(privateKeyEncoder);
-    publicKey.Save(publicKeyEncoder);
-
-    cout << "Prywatny klucz RSA (szesnastkowo): " << endl << strPrivateKey << endl;
-    cout << "Publiczny klucz RSA (szesnastkowo): " << endl << strPublicKey << endl;
-
-    string encrypted, decrypted;
-    cout << "Tekst oryginalny: " << plaintext << endl;
-
-    try {
-        // Szyfrowanie z OAEP-SHA
-        CP::RSAES_OAEP_SHA_Encryptor e(publicKey);
-        CP::StringSource(plaintext, true,
-            new CP::PK_EncryptorFilter(rng, e,
-                new CP::StringSink(encrypted)
-            )
-        );
-        // Konwersja zaszyfrowanych danych na hex
-        string encoded;
-        CP::HexEncoder encoder(new CP::StringSink(encoded));
-        encoder.Put(reinterpret_cast<const CP::byte*>(encrypted.data()), encrypted.size());
-        encoder.MessageEnd();
-
-        cout << "Zaszyfrowany tekst (w heksadecymalnym): " << encoded << endl;
-        // Deszyfrowanie
-        CP::RSAES_OAEP_SHA_Decryptor d(privateKey);
-        CP::StringSource(encoded, true,
-            new CP::HexDecoder(
-                new CP::PK_DecryptorFilter(rng, d,
-                    new CP::StringSink(decrypted)
-                )
-            )
-        );
-
-        cout << "Tekst odszyfrowany: " << decrypted << endl;
-
-        if (plaintext != decrypted) {
-            cout << "Blad: Tekst odszyfrowany rozni sie od oryginalnego!" << endl;
-        }
-    }
-    catch (const CP::Exception& e) {
-        cerr << "CryptoPP blad: " << e.what() << endl;
-        exit(1);
-    }
-}
-// Generacja losowego tekstu
-// =========================
-
-/**
- * Generuje losowy tekst o zadanej dugoci
- * @param min_length Minimalna dugo
- * @param max_length Maksymalna dugo
- * @return Losowy cig znakw
- */
-string generateRandomText(int min_length, int max_length) {
-    const string characters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789!@#$%^&*()";
-    const int charactersLength = characters.length();
-
-    int length = rand() % (max_length - min_length + 1) + min_length;
-    string randomText;
-
-    for (int i = 0; i < length; ++i) {
-        randomText += characters[rand() % charactersLength];
-    }
-    return randomText;
-}
-
-// Deklaracje funkcji pomocniczych
-// ===============================
-
-/**
- * Pobiera czas procesora zuyty przez proces
- * @param userTime[out] Czas w trybie uytkownika
- * @param kernelTime[out] Czas w trybie jdra
- */
-void GetProcessorTimes(FILETIME& userTime, FILETIME& kernelTime) {
-    FILETIME creationTime, exitTime;
-    GetProcessTimes(
-        GetCurrentProcess(),   // Obecny proces
-        &creationTime,         // Czas utworzenia (ignorowany)
-        &exitTime,             // Czas zakoczenia (ignorowany)
-        &kernelTime,           // Czas w kernel mode
-        &userTime              // Czas w user mode
-    );
-}
-
-double FileTimeToSeconds(const FILETIME& ft) {
-    ULARGE_INTEGER uli;
-    uli.LowPart = ft.dwLowDateTime;   // Dolne 32 bity
-    uli.HighPart = ft.dwHighDateTime;  // Grne 32 bity
-    return uli.QuadPart / 1e7;        // 100-ns -> sekundy
-}
-
-/**
- * Wywietla zuycie zasobw
- * @param cpuUsage Procentowe uycie CPU
- * @param pmc Struktura z informacjami o pamici
- */
-void PrintResourceUsage(double cpuUsage, const PROCESS_MEMORY_COUNTERS& pmc) {
-    cout << "Uzycie procesora: " << cpuUsage << "%" << endl;
-    cout << "Uzycie pamieci RAM: " << pmc.WorkingSetSize << " B" << endl;
-}
-
-// Gwna funkcja interfejsu
-// =========================
-void szyfrowanie()
-{
-    srand(time(0));// Inicjalizacja generatora
-    cout << "Wybierz rodzaj szyfrowania: RSA lub AES" << endl;
-    string choice;
-    cin >> choice;
-
-    if (choice == "RSA" || choice == "rsa" || choice == "r" || choice == "R") {
-        cout << "Czy chcesz podac wlasny tekst? (T/N)" << endl;
-        char yn;
-        cin >> yn;
-        // Wsplne zmienne pomiarowe
-        FILETIME userStart, kernelStart, userEnd, kernelEnd;
-        PROCESS_MEMORY_COUNTERS pmcStart, pmcEnd;
-        chrono::time_point<chrono::high_resolution_clock> start, end;
-
-        if (yn == 'T' || yn == 't') {
-            // Obsuga wasnego tekstu
-            string plaintext;
-            cout << "Podaj tekst: ";
-            cin.ignore();
-            getline(cin, plaintext);
-
-            int bytes;
-            cout << "Podaj dlugosc klucza 512, 1024, 2048 lub 4096: ";
-            cin >> bytes;
-
-            while (bytes < 512 || bytes > 4096) {
-                cout << "Nieprawidlowa dlugosc! Podaj wartosc 512, 1024, 2048 lub 4096: ";
-                cin >> bytes;
-            }
-            // Rozpocznij pomiary
-            GetProcessorTimes(userStart, kernelStart);
-            GetProcessMemoryInfo(GetCurrentProcess(), &pmcStart, sizeof(pmcStart));
-            start = chrono::high_resolution_clock::now();
-
-            EncryptDecryptRSA(plaintext, bytes);
-            // Zakocz pomiary
-            end = chrono::high_resolution_clock::now();
-            GetProcessorTimes(userEnd, kernelEnd);
-            GetProcessMemoryInfo(GetCurrentProcess(), &pmcEnd, sizeof(pmcEnd));
-            // Oblicz statystyki
-            chrono::duration<double> duration = end - start;
-            double userTime = FileTimeToSeconds(userEnd) - FileTimeToSeconds(userStart);
-            double kernelTime = FileTimeToSeconds(kernelEnd) - FileTimeToSeconds(kernelStart);
-            double cpuUsage = ((userTime + kernelTime) / duration.count()) * 100.0;
-
-            cout << "\n=== Statystyki wydajnosci ===" << endl;
-            cout << "Czas wykonania: " << duration.count() << " sekund" << endl;
-            PrintResourceUsage(cpuUsage, pmcEnd);
-        }
-        else {
-            // Tryb generacji losowych danych
-            int ilosc, bytes, min_len, max_len;
-
-            cout << "Podaj ilosc hasel: ";
-            cin >> ilosc;
-            while (ilosc <= 0) {
-                cout << "Ilosc musi byc wieksza od 0! Podaj ponownie: ";
-                cin >> ilosc;
-            }
-
-            cout << "Podaj dlugosc klucza (512, 1024, 2048 lub 4096): ";
-            cin >> bytes;
-            while (bytes < 512 || bytes > 4096) {
-                cout << "Nieprawidlowa dlugosc klucza RSA. Dlugosc musi byc 512-4096 bitow: ";
-                cin >> bytes;
-            }
-
-            cout << "Podaj minimalna dlugosc tekstu (>=1): ";
-            cin >> min_len;
-            cout << "Podaj maksymalna dlugosc tekstu: ";
-            cin >> max_len;
-            while (min_len < 1 || max_len < min_len) {
-                cout << "Nieprawidlowy zakres! Podaj ponownie:\n";
-                cout << "Minimalna dlugosc (>=1): ";
-                cin >> min_len;
-                cout << "Maksymalna dlugosc (>= " << min_len << "): ";
-                cin >> max_len;
-            }
-
-            // Rozpocznij testy
-            GetProcessorTimes(userStart, kernelStart);
-            GetProcessMemoryInfo(GetCurrentProcess(), &pmcStart, sizeof(pmcStart));
-            start = chrono::high_resolution_clock::now();
-
-            for (int i = 0; i < ilosc; i++) {
-                string text = generateRandomText(min_len, max_len);
-                EncryptDecryptRSA(text, bytes);
-            }
-            // Zakocz i oblicz statystyki
-            end = chrono::high_resolution_clock::now();
-            GetProcessorTimes(userEnd, kernelEnd);
-            GetProcessMemoryInfo(GetCurrentProcess(), &pmcEnd, sizeof(pmcEnd));
-
-            chrono::duration<double> duration = end - start;
-            double userTime = FileTimeToSeconds(userEnd) - FileTimeToSeconds(userStart);
-            double kernelTime = FileTimeToSeconds(kernelEnd) - FileTimeToSeconds(kernelStart);
-            double cpuUsage = ((userTime + kernelTime) / duration.count()) * 100.0;
-
-            cout << "\n=== Statystyki wydajnosci ===" << endl;
-            cout << "Calkowity czas: " << duration.count() << " sekund" << endl;
-            PrintResourceUsage(cpuUsage, pmcEnd);
-        }
-    }
-    else if (choice == "AES" || choice == "aes" || choice == "a" || choice == "A") {
-        cout << "Czy chcesz podac wlasny tekst? (T/N)" << endl;
-        char yn;
-        cin >> yn;
-
-        FILETIME userStart, kernelStart, userEnd, kernelEnd;
-        PROCESS_MEMORY_COUNTERS pmcStart, pmcEnd;
-        chrono::time_point<chrono::high_resolution_clock> start, end;
-
-        if (yn == 'T' || yn == 't') {
-            string plaintext;
-            cout << "Podaj tekst: ";
-            cin.ignore();
-            getline(cin, plaintext);
-
-            int keySize;
-            cout << "Podaj rozmiar klucza 128, 192 lub 256: ";
-            cin >> keySize;
-
-            while (keySize != 128 && keySize != 192 && keySize != 256) {
-                cout << "Nieprawidlowa dlugosc klucza AES. Dopuszczalne wartosci: 128, 192, 256: ";
-                cin >> keySize;
-            }
-
-            GetProcessorTimes(userStart, kernelStart);
-            GetProcessMemoryInfo(GetCurrentProcess(), &pmcStart, sizeof(pmcStart));
-            start = chrono::high_resolution_clock::now();
-
-            EncryptDecryptAES(plaintext, keySize);
-
-            end = chrono::high_resolution_clock::now();
-            GetProcessorTimes(userEnd, kernelEnd);
-            GetProcessMemoryInfo(GetCurrentProcess(), &pmcEnd, sizeof(pmcEnd));
-
-            chrono::duration<double> duration = end - start;
-            double userTime = FileTimeToSeconds(userEnd) - FileTimeToSeconds(userStart);
-            double kernelTime = FileTimeToSeconds(kernelEnd) - FileTimeToSeconds(kernelStart);
-            double cpuUsage = ((userTime + kernelTime) / duration.count()) * 100.0;
-
-            cout << "\n=== Statystyki wydajnosci ===" << endl;
-            cout << "Czas wykonania: " << duration.count() << " sekund" << endl;
-            PrintResourceUsage(cpuUsage, pmcEnd);
-        }
-        else {
-            int ilosc, keySize, min_len, max_len;
-
-            cout << "Podaj ilosc hasel: ";
-            cin >> ilosc;
-            while (ilosc <= 0) {
-                cout << "Ilosc musi byc wieksza od 0! Podaj ponownie: ";
-                cin >> ilosc;
-            }
-
-            cout << "Podaj rozmiar klucza 128, 192 lub 256: ";
-            cin >> keySize;
-            while (keySize != 128 && keySize != 192 && keySize != 256) {
-                cout << "Nieprawidlowa dlugosc klucza AES. Dopuszczalne wartosci: 128, 192, 256: ";
-                cin >> keySize;
-            }
-
-            cout << "Podaj minimalna dlugosc tekstu (>=1): ";
-            cin >> min_len;
-            cout << "Podaj maksymalna dlugosc tekstu: ";
-            cin >> max_len;
-            while (min_len < 1 || max_len < min_len) {
-                cout << "Nieprawidlowy zakres! Podaj ponownie:\n";
-                cout << "Minimalna dlugosc (>=1): ";
-                cin >> min_len;
-                cout << "Maksymalna dlugosc (>= " << min_len << "): ";
-                cin >> max_len;
-            }
-
-            GetProcessorTimes(userStart, kernelStart);
-            GetProcessMemoryInfo(GetCurrentProcess(), &pmcStart, sizeof(pmcStart));
-            start = chrono::high_resolution_clock::now();
-
-            for (int i = 0; i < ilosc; i++) {
-                string text = generateRandomText(min_len, max_len);
-                EncryptDecryptAES(text, keySize);
-            }
-
-            end = chrono::high_resolution_clock::now();
-            GetProcessorTimes(userEnd, kernelEnd);
-            GetProcessMemoryInfo(GetCurrentProcess(), &pmcEnd, sizeof(pmcEnd));
-
-            chrono::duration<double> duration = end - start;
-            double userTime = FileTimeToSeconds(userEnd) - FileTimeToSeconds(userStart);
-            double kernelTime = FileTimeToSeconds(kernelEnd) - FileTimeToSeconds(kernelStart);
-            double cpuUsage = ((userTime + kernelTime) / duration.count()) * 100.0;
-
-            cout << "\n=== Statystyki wydajnosci ===" << endl;
-            cout << "Calkowity czas: " << duration.count() << " sekund" << endl;
-            PrintResourceUsage(cpuUsage, pmcEnd);
-        }
-    }
-    else {
-        cout << "Nieprawidlowy wybor szyfrowania!" << endl;
-    }
-}
\ No newline at end of file
+
+#include "cryptlib.h"   // Główna biblioteka Crypto++
+#include "osrng.h"      // Generator liczb losowych
+#include "aes.h"        // Algorytm AES
+#include "modes.h"      // Tryby pracy szyfrów blokowych
+#include "filters.h"    // Filtry do przetwarzania danych
+#include "hex.h"        // Kodowanie heksadecymalne
+#include "rsa.h"        // Algorytm RSA
+#include "pem.h"        // Obsługa kluczy PEM
+#include <iostream>      // Obsługa wejścia i wyjścia
+#include "files.h"      // Obsługa plików
+#include "rsa_aes.h"    // Deklaracje funkcji szyfrowania i Metrics
+#include "zasoby_systemowe.h"  // Pomiar czasu CPU, pamięci i liczników jądra - ten sam co w zliczaniu słów
+
+// Linkowanie z bibliotekami
+
+#pragma comment(lib, "cryptlib.lib")   // Biblioteka Crypto++
+
+// Alias dla przestrzeni nazw CryptoPP
+namespace CP = CryptoPP;
+
+using namespace std;
+
+
+void PrintResourceUsage(const Metrics& wynik);
+
+
+// Implementacja AES
+// =================
+
+/**
+ * Szyfruje i deszyfruje tekst przy użyciu AES-CTR
+ * @param plaintext Tekst do zaszyfrowania
+ * @param keySize Rozmiar klucza (128, 192, 256)
+ * @param wypisz Wyniki pośrednie na konsolę
+ */
+bool EncryptDecryptAES(const string& plaintext, int keySize, bool wypisz) {
+    CP::AutoSeededRandomPool prng; // Kryptograficzny generator liczb losowych
+
+    // Walidacja rozmiaru klucza
+    if (keySize != 128 && keySize != 192 && keySize != 256) {
+        cerr << "Nieprawidlowy rozmiar klucza AES." << endl;
+        return false;
+    }
+    // Generacja klucza i IV
+    int keyLength = keySize / 8; // Konwersja bitów na bajty
+    CP::SecByteBlock key(keyLength); // Klucz AES
+    CP::SecByteBlock iv(CP::AES::BLOCKSIZE); // Wektor inicjalizujący (IV)
+
+    prng.GenerateBlock(key, key.size()); // Generowanie losowego klucza AES
+    prng.GenerateBlock(iv, iv.size());   // Generowanie losowego IV // Wektor inicjujący (16 bajtów)
+
+    // Konwersja klucza do hex
+    if (wypisz) {
+        string strKey;
+        CP::HexEncoder keyEncoder(new CP::StringSink(strKey));
+        keyEncoder.Put(key, key.size());
+        keyEncoder.MessageEnd();
+
+        cout << "Klucz AES (szesnastkowo): " << endl << strKey << endl;
+        cout << "Tekst oryginalny: " << plaintext << endl;
+    }
+
+    string cipher, recovered;
+
+    try {
+        // Inicjalizacja szyfrowania AES w trybie CTR
+        CP::CTR_Mode<CP::AES>::Encryption e;
+        e.SetKeyWithIV(key, key.size(), iv);
+
+        // Szyfrowanie tekstu // Kodowanie tekstu jawnego do hex przed szyfrowaniem
+        string encodedPlain;
+        CP::StringSource(plaintext, true,
+            new CP::HexEncoder(
+                new CP::StringSink(encodedPlain)
+            )
+        );
+        // Przeprocesowanie szyfrowania
+        CP::StringSource(encodedPlain, true,
+            new CP::StreamTransformationFilter(e,
+                new CP::StringSink(cipher)
+            )
+        );
+
+        if (wypisz) {
+            cout << "Zaszyfrowany tekst (w heksadecymalnym): ";
+            CP::StringSource(cipher, true,
+                new CP::HexEncoder(
+                    new CP::FileSink(cout)
+                )
+            );
+            cout << endl;
+        }
+
+        // Deszyfrowanie
+        CP::CTR_Mode<CP::AES>::Decryption d;
+        d.SetKeyWithIV(key, key.size(), iv);
+        CP::StringSource(cipher, true,
+            new CP::StreamTransformationFilter(d,
+                new CP::StringSink(recovered)
+            )
+        );
+        // Dekodowanie z hex
+        string decodedRecovered;
+        CP::StringSource(recovered, true,
+            new CP::HexDecoder(
+                new CP::StringSink(decodedRecovered)
+            )
+        );
+        // Wyświetl IV
+        if (wypisz) {
+            string strIV;
+            CP::HexEncoder ivEncoder(new CP::StringSink(strIV));
+            ivEncoder.Put(iv, iv.size());
+            ivEncoder.MessageEnd();
+
+            cout << "Wektor inicjujacy (IV) (szesnastkowo): " << endl << strIV << endl;
+            cout << "Tekst odszyfrowany: " << decodedRecovered << endl;
+        }
+        // Weryfikacja poprawności
+        if (plaintext != decodedRecovered) {
+            if (wypisz) cout << "Blad: Tekst odszyfrowany rozni sie od oryginalnego!" << endl;  // Wiersz poleceń: count < liczba tekstów
+            return false;
+        }
+        return true;
+    }
+    catch (const CP::Exception& e) {
+        cerr << "CryptoPP blad: " << e.what() << endl;
+        exit(1);
+    }
+}
+// Implementacja RSA
+// =================
+
+/**
+ * Szyfruje i deszyfruje tekst przy użyciu RSA-OAEP
+ * @param plaintext Tekst do zaszyfrowania
+ * @param bytes Długość klucza w bitach (512-4096)
+ * @param wypisz Wyniki pośrednie na konsolę
+ */
+bool EncryptDecryptRSA(const string& plaintext, int bytes, bool wypisz) {
+    CP::AutoSeededRandomPool rng;// Generator kryptograficzny
+    
+    // Walidacja długości klucza
+    if (bytes < 512 || bytes > 4096) {
+        cerr << "Nieprawidlowa dlugosc klucza RSA" << endl;
+        return false;
+    }
+
+    // Generacja pary kluczy
+    CP::InvertibleRSAFunction params;
+    params.GenerateRandomWithKeySize(rng, bytes);  // Generuj parametry RSA
+
+    CP::RSA::PrivateKey privateKey(params);  // Klucz prywatny
+    CP::RSA::PublicKey publicKey(params);     // Klucz publiczny
+    
+    // Eksport kluczy do hex
+    if (wypisz) {
+        string strPrivateKey, strPublicKey;
+        CP::HexEncoder privateKeyEncoder(new CP::StringSink(strPrivateKey));
+        CP::HexEncoder publicKeyEncoder(new CP::StringSink(strPublicKey));
+
+        privateKey.Save(privateKeyEncoder);
+        publicKey.Save(publicKeyEncoder);
+
+        cout << "Prywatny klucz RSA (szesnastkowo): " << endl << strPrivateKey << endl;
+        cout << "Publiczny klucz RSA (szesnastkowo): " << endl << strPublicKey << endl;
+        cout << "Tekst oryginalny: " << plaintext << endl;
+    }
+
+    string encrypted, decrypted;
+
+    try {
+        // Szyfrowanie z OAEP-SHA
+        CP::RSAES_OAEP_SHA_Encryptor e(publicKey);
+        CP::StringSource(plaintext, true,
+            new CP::PK_EncryptorFilter(rng, e,
+                new CP::StringSink(encrypted)
+            )
+        );
+        // Konwersja zaszyfrowanych danych na hex
+        string encoded;
+        CP::HexEncoder encoder(new CP::StringSink(encoded));
+        encoder.Put(reinterpret_cast<const CP::byte*>(encrypted.data()), encrypted.size());
+        encoder.MessageEnd();
+
+        if (wypisz) cout << "Zaszyfrowany tekst (w heksadecymalnym): " << encoded << endl;
+        // Deszyfrowanie
+        CP::RSAES_OAEP_SHA_Decryptor d(privateKey);
+        CP::StringSource(encoded, true,
+            new CP::HexDecoder(
+                new CP::PK_DecryptorFilter(rng, d,
+                    new CP::StringSink(decrypted)
+                )
+            )
+        );
+
+        if (wypisz) cout << "Tekst odszyfrowany: " << decrypted << endl;
+
+        if (plaintext != decrypted) {
+            if (wypisz) cout << "Blad: Tekst odszyfrowany rozni sie od oryginalnego!" << endl;  // Wiersz poleceń: count < liczba tekstów
+            return false;
+        }
+        return true;
+    }
+    catch (const CP::Exception& e) {
+        cerr << "CryptoPP blad: " << e.what() << endl;
+        exit(1);
+    }
+}
+// Generacja losowego tekstu
+// =========================
+
+/**
+ * Generuje losowy tekst o zadanej długości
+ * @param min_length Minimalna długość
+ * @param max_length Maksymalna długość
+ * @return Losowy ciąg znaków
+ */
+string generateRandomText(int min_length, int max_length) {
+    const string characters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789!@#$%^&*()";
+    const int charactersLength = characters.length();
+
+    int length = rand() % (max_length - min_length + 1) + min_length;
+    string randomText;
+
+    for (int i = 0; i < length; ++i) {
+        randomText += characters[rand() % charactersLength];
+    }
+    return randomText;
+}
+
+// Deklaracje funkcji pomocniczych
+// ===============================
+
+/**
+ * Wyświetla zużycie zasobów
+ * @param wynik Metryki serii (seria_szyfrowan)
+ */
+void PrintResourceUsage(const Metrics& wynik) {
+    cout << "Uzycie procesora: " << wynik.cpu_usage << "%" << endl;
+    cout << "Czas CPU (uzytkownika / jadra): " << wynik.cpu_uzytkownika << "s / " << wynik.cpu_systemu << "s" << endl;
+    cout << "Uzycie pamieci RAM: " << wynik.ram_usage << " B (szczyt procesu: " << wynik.szczyt_pamieci << " B)" << endl;
+    cout << "Przelaczenia kontekstu (dobrowolne / wymuszone): " << wynik.przelaczenia_dobrowolne << " / " << wynik.przelaczenia_wymuszone << endl;
+    cout << "Bledy stron (bez dysku / z dyskiem): " << wynik.bledy_stron << " / " << wynik.bledy_stron_dysku << endl;
+}
+
+// Seria szyfrowań z pomiarem
+// ==========================
+
+bool poprawny_klucz(const string& algorytm, int rozmiar_klucza) {
+    if (algorytm == "AES") return rozmiar_klucza == 128 || rozmiar_klucza == 192 || rozmiar_klucza == 256;
+    if (algorytm == "RSA") return rozmiar_klucza >= 512 && rozmiar_klucza <= 4096;
+    return false;
+}
+
+Metrics seria_szyfrowan(const string& algorytm, int rozmiar_klucza, const vector<string>& teksty, bool wypisz) {
+    // Rozpocznij pomiary
+    const Pomiar pomiar = rozpocznij_pomiar();
+
+    uint64_t poprawne = 0;
+    for (const string& tekst : teksty) {
+        const bool wynik_tekstu = algorytm == "RSA" ? EncryptDecryptRSA(tekst, rozmiar_klucza, wypisz) : EncryptDecryptAES(tekst, rozmiar_klucza, wypisz);
+        if (wynik_tekstu) ++poprawne;
+    }
+
+    // Zakończ pomiary - CPU względem wszystkich rdzeni i przyrost pamięci prywatnej, jak w zliczaniu słów
+    Metrics wynik = zakoncz_pomiar(pomiar);
+    wynik.count = poprawne;
+    wynik.silnik = algorytm == "RSA" ? "RSA-" + to_string(rozmiar_klucza) + " (OAEP-SHA)" : "AES-" + to_string(rozmiar_klucza) + " (CTR)";
+    for (const string& tekst : teksty) wynik.bajty += tekst.size();
+    return wynik;
+}
+
+// Główna funkcja interfejsu
+// =========================
+
+// Pobiera rozmiar klucza, dopóki nie jest poprawny dla algorytmu
+static int wczytaj_rozmiar_klucza(const string& algorytm) {
+    const char* zakres = algorytm == "RSA" ? "512, 1024, 2048 lub 4096" : "128, 192 lub 256";
+    int rozmiar_klucza;
+    cout << "Podaj rozmiar klucza " << zakres << ": ";
+    cin >> rozmiar_klucza;
+    while (!poprawny_klucz(algorytm, rozmiar_klucza)) {
+        cout << "Nieprawidlowa dlugosc klucza " << algorytm << ". Dopuszczalne wartosci: " << zakres << ": ";
+        cin >> rozmiar_klucza;
+    }
+    return rozmiar_klucza;
+}
+
+void szyfrowanie()
+{
+    srand(time(0));// Inicjalizacja generatora
+    cout << "Wybierz rodzaj szyfrowania: RSA lub AES" << endl;
+    string choice;
+    cin >> choice;
+
+    string algorytm;
+    if (choice == "RSA" || choice == "rsa" || choice == "r" || choice == "R") algorytm = "RSA";
+    else if (choice == "AES" || choice == "aes" || choice == "a" || choice == "A") algorytm = "AES";
+    else {
+        cout << "Nieprawidlowy wybor szyfrowania!" << endl;
+        return;
+    }
+
+    cout << "Czy chcesz podac wlasny tekst? (T/N)" << endl;
+    char yn;
+    cin >> yn;
+
+    vector<string> teksty;
+    int rozmiar_klucza;
+    if (yn == 'T' || yn == 't') {
+        // Obsługa własnego tekstu
+        string plaintext;
+        cout << "Podaj tekst: ";
+        cin.ignore();
+        getline(cin, plaintext);
+        teksty.push_back(plaintext);
+
+        rozmiar_klucza = wczytaj_rozmiar_klucza(algorytm);
+    }
+    else {
+        // Tryb generacji losowych danych
+        int ilosc, min_len, max_len;
+
+        cout << "Podaj ilosc hasel: ";
+        cin >> ilosc;
+        while (ilosc <= 0) {
+            cout << "Ilosc musi byc wieksza od 0! Podaj ponownie: ";
+            cin >> ilosc;
+        }
+
+        rozmiar_klucza = wczytaj_rozmiar_klucza(algorytm);
+
+        cout << "Podaj minimalna dlugosc tekstu (>=1): ";
+        cin >> min_len;
+        cout << "Podaj maksymalna dlugosc tekstu: ";
+        cin >> max_len;
+        while (min_len < 1 || max_len < min_len) {
+            cout << "Nieprawidlowy zakres! Podaj ponownie:\n";
+            cout << "Minimalna dlugosc (>=1): ";
+            cin >> min_len;
+            cout << "Maksymalna dlugosc (>= " << min_len << "): ";
+            cin >> max_len;
+        }
+
+        // Teksty losowane przed pomiarem - mierzone jest samo szyfrowanie
+        for (int i = 0; i < ilosc; i++) teksty.push_back(generateRandomText(min_len, max_len));
+    }
+
+    const Metrics wynik = seria_szyfrowan(algorytm, rozmiar_klucza, teksty, true);
+
+    cout << "\n=== Statystyki wydajnosci ===" << endl;
+    cout << (teksty.size() == 1 ? "Czas wykonania: " : "Calkowity czas: ") << wynik.czas << " sekund" << endl;
+    PrintResourceUsage(wynik);
+}
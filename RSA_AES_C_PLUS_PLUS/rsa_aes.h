@@ -1,40 +1,65 @@
-#pragma once          // Dyrektywa kompilatora zapobiegajca wielokrotnemu doczaniu
-#ifndef RSA_AES_H     // Tradycyjne zabezpieczenie przed podwjnym include
-#define RSA_AES_H
-
-#include <string>     // Biblioteka do obsugi cigw znakw (std::string)
-#include <chrono>     // Biblioteka do pomiarw czasu (uywana w implementacji)
-
-/**
- * Szyfruje i deszyfruje tekst algorytmem AES
- * @param plaintext Tekst wejciowy do zaszyfrowania
- * @param keySize Rozmiar klucza w bitach - dopuszczalne wartoci: 128, 192, 256
- * @warning Funkcja wywietla wyniki bezporednio na konsol
- */
-void EncryptDecryptAES(const std::string& plaintext, int keySize);
-
-/**
- * Szyfruje i deszyfruje tekst algorytmem RSA
- * @param plaintext Tekst wejciowy do zaszyfrowania
- * @param bytes Dugo klucza w bitach - dopuszczalne wartoci: 512-4096
- * @note Generuje now par kluczy przy kadym wywoaniu
- */
-void EncryptDecryptRSA(const std::string& plaintext, int bytes);
-
-/**
- * Generuje losowy tekst do testw
- * @return Losowy cig znakw alfanumerycznych i specjalnych
- */
-std::string generateRandomText();
-
-/**
- * Gwna funkcja interfejsu uytkownika
- * @brief Umoliwia wybr algorytmu, wprowadzanie tekstu oraz wywietla statystyki
- * @details W przypadku wyboru RSA oferuje:
- * - Generacj wielu testw
- * - Wasny tekst wejciowy
- * - Pomiar czasu i pamici
- */
-void szyfrowanie();
-
+#pragma once          // Dyrektywa kompilatora zapobiegająca wielokrotnemu dołączaniu
+#ifndef RSA_AES_H     // Tradycyjne zabezpieczenie przed podwójnym include
+#define RSA_AES_H
+
+#include <string>     // Biblioteka do obsługi ciągów znaków (std::string)
+#include <vector>     // Teksty serii szyfrowań
+#include <chrono>     // Biblioteka do pomiarów czasu (używana w implementacji)
+#include "liczenie_slow.h"  // Metrics - wspólne metryki obu podsystemów
+
+/**
+ * Szyfruje i deszyfruje tekst algorytmem AES
+ * @param plaintext Tekst wejściowy do zaszyfrowania
+ * @param keySize Rozmiar klucza w bitach - dopuszczalne wartości: 128, 192, 256
+ * @param wypisz Klucz, szyfrogram i tekst odszyfrowany na konsolę (false - tylko pomiar)
+ * @return true, gdy tekst odszyfrowany jest równy oryginalnemu
+ */
+bool EncryptDecryptAES(const std::string& plaintext, int keySize, bool wypisz = true);
+
+/**
+ * Szyfruje i deszyfruje tekst algorytmem RSA
+ * @param plaintext Tekst wejściowy do zaszyfrowania
+ * @param bytes Długość klucza w bitach - dopuszczalne wartości: 512-4096
+ * @param wypisz Klucze, szyfrogram i tekst odszyfrowany na konsolę (false - tylko pomiar)
+ * @return true, gdy tekst odszyfrowany jest równy oryginalnemu
+ * @note Generuje nową parę kluczy przy każdym wywołaniu
+ */
+bool EncryptDecryptRSA(const std::string& plaintext, int bytes, bool wypisz = true);
+
+/**
+ * Generuje losowy tekst do testów
+ * @param min_length Minimalna długość
+ * @param max_length Maksymalna długość
+ * @return Losowy ciąg znaków alfanumerycznych i specjalnych
+ */
+std::string generateRandomText(int min_length, int max_length);
+
+/**
+ * Sprawdza rozmiar klucza dla algorytmu
+ * @param algorytm "AES" lub "RSA"
+ * @return true dla AES 128/192/256 i RSA 512-4096
+ */
+bool poprawny_klucz(const std::string& algorytm, int rozmiar_klucza);
+
+/**
+ * Seria szyfrowań i deszyfrowań jednym algorytmem z pomiarem czasu, CPU i pamięci całej serii
+ * @param algorytm "AES" lub "RSA"
+ * @param rozmiar_klucza Rozmiar klucza w bitach (poprawny_klucz)
+ * @param teksty Teksty jawne - jedno szyfrowanie i deszyfrowanie na tekst (przygotowane przed pomiarem)
+ * @param wypisz Klucze, szyfrogramy i teksty na konsolę jak w menu (false - wiersz poleceń)
+ * @return count - poprawne deszyfrowania, bajty - suma długości tekstów, silnik - algorytm i klucz;
+ *         czas, cpu_usage, ram_usage i cykle liczone jak w zliczaniu słów
+ */
+Metrics seria_szyfrowan(const std::string& algorytm, int rozmiar_klucza, const std::vector<std::string>& teksty, bool wypisz = false);
+
+/**
+ * Główna funkcja interfejsu użytkownika
+ * @brief Umożliwia wybór algorytmu, wprowadzanie tekstu oraz wyświetla statystyki
+ * @details W przypadku wyboru RSA oferuje:
+ * - Generację wielu testów
+ * - Własny tekst wejściowy
+ * - Pomiar czasu i pamięci
+ */
+void szyfrowanie();
+
 #endif // RSA_AES_H
\ No newline at end of file
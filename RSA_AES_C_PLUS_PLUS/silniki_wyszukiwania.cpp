@@ -0,0 +1,889 @@
+// Sekcja includów - dołączanie niezbędnych bibliotek
+#include "silniki_wyszukiwania.h"  // Deklaracje jąder wyszukiwania
+#include <cstring>                 // memchr, memcmp
+#include <chrono>                  // Zegar zastępczy dla licznika cykli
+#include <algorithm>               // std::sort
+
+// Wykrywanie architektury x86 - tylko tam dostępne są SSE2/AVX2
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SILNIKI_X86 1
+#ifdef _MSC_VER
+#include <intrin.h>                // __cpuid, __cpuidex, _xgetbv, __rdtsc, _BitScanForward
+#else
+#include <x86intrin.h>             // __rdtsc
+#include <cpuid.h>                 // __get_cpuid - ciąg marki procesora
+#endif
+#include <immintrin.h>             // Intrinsics SSE2/AVX2
+#endif
+
+// GCC/Clang wymagają atrybutu, by wygenerować kod AVX2 bez globalnej flagi -mavx2.
+// MSVC generuje dowolne intrinsics bez dodatkowych opcji.
+#if defined(SILNIKI_X86) && !defined(_MSC_VER)
+#define CEL_AVX2 __attribute__((target("avx2")))
+#define CEL_SSSE3 __attribute__((target("ssse3")))
+#else
+#define CEL_AVX2
+#define CEL_SSSE3
+#endif
+
+// Funkcje pomocnicze
+// ==================
+
+// Zwraca indeks najmłodszego ustawionego bitu (maska != 0)
+static inline unsigned najnizszy_bit(uint32_t maska) {
+#ifdef _MSC_VER
+    unsigned long indeks;
+    _BitScanForward(&indeks, maska);
+    return static_cast<unsigned>(indeks);
+#else
+    return static_cast<unsigned>(__builtin_ctz(maska));
+#endif
+}
+
+// Sprawdza środek wzorca (pierwszy i ostatni bajt zostały już porównane przez filtr)
+static inline bool zgodny_srodek(const char* kandydat, const char* wzorzec, size_t m) {
+    return m <= 2 || memcmp(kandydat + 1, wzorzec + 1, m - 2) == 0;
+}
+
+// Liczy trafienie na pozycji i; w trybie pozycji dopisuje ją też do wyniku (jądra przechodzą widok rosnąco)
+static inline void zapisz_trafienie(size_t i, uint64_t& count, std::vector<size_t>* pozycje) {
+    ++count;
+    if (pozycje) pozycje->push_back(i);
+}
+
+// Skalarne dokończenie / wersja zapasowa: memchr szuka pierwszego bajtu, reszta jak w filtrze
+static uint64_t licz_skalarnie(const char* s, size_t n, const char* p, size_t m, size_t od, std::vector<size_t>* pozycje) {
+    uint64_t count = 0;
+    const char pierwszy = p[0];
+    const char ostatni = p[m - 1];
+    size_t i = od;
+    while (i + m <= n) {
+        const void* trafienie = memchr(s + i, pierwszy, n - m + 1 - i);  // Tylko pozycje, w których wzorzec się mieści
+        if (!trafienie) break;
+        i = static_cast<size_t>(static_cast<const char*>(trafienie) - s);
+        if (s[i + m - 1] == ostatni && zgodny_srodek(s + i, p, m)) zapisz_trafienie(i, count, pozycje);
+        ++i;  // Wystąpienia mogą na siebie nachodzić
+    }
+    return count;
+}
+
+// Tryb całych słów
+// ================
+
+// Bajt wiodący 2-bajtowej litery łacińskiej w UTF-8 (U+00C0-U+017F, m.in. ą ć ę ł ń ó ś ź ż)
+static inline bool wiodacy_litery(unsigned char c) {
+    return c >= 0xC3 && c <= 0xC5;
+}
+
+static inline bool litera_lub_cyfra_ascii(unsigned char c) {
+    return static_cast<unsigned char>((c | 0x20) - 'a') < 26 || static_cast<unsigned char>(c - '0') < 10;
+}
+
+bool znak_slowa(unsigned char bajt) {
+    return bajt < 0x80 ? litera_lub_cyfra_ascii(bajt) : wiodacy_litery(bajt);
+}
+
+// Czy znak kończący się tuż przed pozycją i (i >= 1) jest znakiem słowa
+static inline bool slowo_przed(const char* s, size_t i) {
+    unsigned char c = static_cast<unsigned char>(s[i - 1]);
+    if (c < 0x80) return litera_lub_cyfra_ascii(c);
+    if (c >= 0xC0) return false;  // Bajt wiodący bez kontynuacji - uszkodzony UTF-8
+    // Bajt kontynuacji - litera, jeśli poprzedza go bajt wiodący 2-bajtowej litery
+    return i >= 2 && wiodacy_litery(static_cast<unsigned char>(s[i - 2]));
+}
+
+// Weryfikuje kandydata w trybie całych słów: środek wzorca, granice słowa i przynależność okna do widoku
+// (pierwszy i ostatni bajt wzorca zostały już porównane)
+static inline bool cale_slowo(const char* s, size_t n, size_t i, const char* p, size_t m, const PolozenieFragmentu& polozenie) {
+    if (i < 2) {
+        if (!polozenie.poczatek_pliku) return false;  // Okno zaczyna się w poprzednim fragmencie
+    }
+    else if (i - 2 >= polozenie.wlasciwa) {
+        return false;  // Okno należy do następnego fragmentu
+    }
+    if (i + m == n) {
+        if (!polozenie.koniec_pliku) return false;  // Znak za słowem jest w następnym fragmencie
+    }
+    else if (znak_slowa(static_cast<unsigned char>(s[i + m]))) {
+        return false;
+    }
+    if (i >= 1 && slowo_przed(s, i)) return false;
+    return zgodny_srodek(s + i, p, m);
+}
+
+// Wersja skalarna: memchr szuka pierwszego bajtu, od pozycji `od`
+static uint64_t licz_cale_slowa_skalarnie(const char* s, size_t n, const char* p, size_t m, size_t od, const PolozenieFragmentu& polozenie,
+    std::vector<size_t>* pozycje) {
+    uint64_t count = 0;
+    size_t i = od;
+    while (i + m <= n) {
+        const void* trafienie = memchr(s + i, p[0], n - m + 1 - i);
+        if (!trafienie) break;
+        i = static_cast<size_t>(static_cast<const char*>(trafienie) - s);
+        if (s[i + m - 1] == p[m - 1] && cale_slowo(s, n, i, p, m, polozenie)) zapisz_trafienie(i, count, pozycje);
+        ++i;
+    }
+    return count;
+}
+
+// Tryb bez rozróżniania wielkości liter i znaków diakrytycznych
+// =============================================================
+
+// Mała litera bazowa dla 2-bajtowych znaków U+00C0-U+017F (bajt wiodący 0xC3-0xC5, kontynuacja 0x80-0xBF);
+// '-' oznacza znak, który nie jest składany (×, ÷, ß oraz ligatury jak U+00E6, U+0153)
+static const char LITERY_BAZOWE[3 * 64 + 1] =
+    "aaaaaa-ceeeeiiii" "dnooooo-ouuuuy--" "aaaaaa-ceeeeiiii" "dnooooo-ouuuuy-y"   // 0xC3: U+00C0-U+00FF
+    "aaaaaaccccccccdd" "ddeeeeeeeeeegggg" "gggghhhhiiiiiiii" "ii--jjkkklllllll"   // 0xC4: U+0100-U+013F
+    "lllnnnnnn-nnoooo" "oo--rrrrrrssssss" "sstttt--uuuuuuuu" "uuuuwwyyyzzzzzzs";  // 0xC5: U+0140-U+017F
+
+// Składa znak zaczynający się na pozycji i: litera ASCII na małą, litera łacińska UTF-8 na bazową,
+// pozostałe bajty bez zmian. W dlugosc zwraca liczbę bajtów znaku (1 lub 2).
+static inline unsigned char zloz_znak(const char* s, size_t n, size_t i, size_t& dlugosc) {
+    const unsigned char c = static_cast<unsigned char>(s[i]);
+    dlugosc = 1;
+    if (c < 0x80) return static_cast<unsigned char>(c - 'A') < 26 ? static_cast<unsigned char>(c | 0x20) : c;
+    if (wiodacy_litery(c) && i + 1 < n) {
+        const unsigned char kontynuacja = static_cast<unsigned char>(s[i + 1]);
+        if ((kontynuacja & 0xC0) == 0x80) {
+            const char baza = LITERY_BAZOWE[(c - 0xC3) * 64 + (kontynuacja - 0x80)];
+            if (baza != '-') {
+                dlugosc = 2;
+                return static_cast<unsigned char>(baza);
+            }
+        }
+    }
+    return c;
+}
+
+std::string zloz_znaki(std::string_view tekst) {
+    std::string wynik;
+    wynik.reserve(tekst.size());
+    size_t dlugosc;
+    for (size_t i = 0; i < tekst.size(); i += dlugosc) {
+        wynik.push_back(static_cast<char>(zloz_znak(tekst.data(), tekst.size(), i, dlugosc)));
+    }
+    return wynik;
+}
+
+// Bajty, od których może zaczynać się znak tekstu składany do danego bajtu wzorca
+struct ZbiorPoczatkow {
+    unsigned char znak;  // Bajt wzorca po złożeniu
+    bool litera;         // Litera ASCII - pasuje też wielka litera (porównanie po OR 0x20)
+    bool wiodace[3];     // Które bajty wiodące 0xC3-0xC5 mają litery składane do tego znaku
+};
+
+static ZbiorPoczatkow zbior_poczatkow(char zlozony) {
+    ZbiorPoczatkow zbior{};
+    zbior.znak = static_cast<unsigned char>(zlozony);
+    zbior.litera = static_cast<unsigned char>(zbior.znak - 'a') < 26;
+    for (int wiodacy = 0; wiodacy < 3 && zbior.litera; ++wiodacy) {
+        for (int k = 0; k < 64; ++k) {
+            if (LITERY_BAZOWE[wiodacy * 64 + k] == zlozony) zbior.wiodace[wiodacy] = true;
+        }
+    }
+    return zbior;
+}
+
+// Porównuje złożony tekst od pozycji i ze złożonym wzorcem; zwraca długość dopasowania w bajtach tekstu (0 - brak)
+static inline size_t dopasuj_zlozony(const char* s, size_t n, size_t i, const char* p, size_t m) {
+    size_t poz = i;
+    size_t dlugosc;
+    for (size_t j = 0; j < m; ++j, poz += dlugosc) {
+        if (poz >= n || zloz_znak(s, n, poz, dlugosc) != static_cast<unsigned char>(p[j])) return 0;
+    }
+    return poz - i;
+}
+
+// Czy dopasowanie [i, i + dlugosc) należy do tego widoku (i czy jest całym słowem)
+// Bez całych słów wystąpienie należy do fragmentu, w którym się zaczyna; z całymi słowami - do okna
+// [i - 2, i + dlugosc + 1) jak w licz_cale_slowa. W strumieniu pomijane są wystąpienia mieszczące się w nakładce.
+static inline bool przyjmij_zlozony(const char* s, size_t n, size_t i, size_t dlugosc, const PolozenieFragmentu& polozenie, bool cale_slowa) {
+    if (!cale_slowa) return i < polozenie.wlasciwa && i + dlugosc > polozenie.nakladka;
+    if (i < 2) {
+        if (!polozenie.poczatek_pliku) return false;
+    }
+    else if (i - 2 >= polozenie.wlasciwa) {
+        return false;
+    }
+    if (i + dlugosc == n) {
+        if (!polozenie.koniec_pliku) return false;
+    }
+    else if (znak_slowa(static_cast<unsigned char>(s[i + dlugosc]))) {
+        return false;
+    }
+    else if (i + dlugosc + 1 <= polozenie.nakladka) {
+        return false;  // Całe okno w nakładce - policzone w poprzednim buforze
+    }
+    return !(i >= 1 && slowo_przed(s, i));
+}
+
+// Sprawdza kandydata na pozycji i i zwiększa licznik
+static inline void sprawdz_zlozony(const char* s, size_t n, size_t i, const char* p, size_t m,
+    const PolozenieFragmentu& polozenie, bool cale_slowa, uint64_t& count, std::vector<size_t>* pozycje) {
+    const size_t dlugosc = dopasuj_zlozony(s, n, i, p, m);
+    if (dlugosc && przyjmij_zlozony(s, n, i, dlugosc, polozenie, cale_slowa)) zapisz_trafienie(i, count, pozycje);
+}
+
+// Wersja skalarna: filtr pierwszego bajtu z ZbiorPoczatkow, od pozycji `od`
+static uint64_t licz_bez_diakrytykow_skalarnie(const char* s, size_t n, const char* p, size_t m, size_t od,
+    const PolozenieFragmentu& polozenie, bool cale_slowa, std::vector<size_t>* pozycje) {
+    const ZbiorPoczatkow pierwszy = zbior_poczatkow(p[0]);
+    uint64_t count = 0;
+    for (size_t i = od; i < n; ++i) {
+        const unsigned char c = static_cast<unsigned char>(s[i]);
+        const bool kandydat = (pierwszy.litera ? (c | 0x20) == pierwszy.znak : c == pierwszy.znak)
+            || (wiodacy_litery(c) && pierwszy.wiodace[c - 0xC3]);
+        if (kandydat) sprawdz_zlozony(s, n, i, p, m, polozenie, cale_slowa, count, pozycje);
+    }
+    return count;
+}
+
+#ifdef SILNIKI_X86
+
+// Maska bajtów będących literą lub cyfrą ASCII (SSE2 nie ma porównań bez znaku - min_epu8 + cmpeq)
+static inline __m128i alnum_sse2(__m128i v) {
+    const __m128i litera = _mm_sub_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i cyfra = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+    const __m128i jest_litera = _mm_cmpeq_epi8(_mm_min_epu8(litera, _mm_set1_epi8(25)), litera);
+    const __m128i jest_cyfra = _mm_cmpeq_epi8(_mm_min_epu8(cyfra, _mm_set1_epi8(9)), cyfra);
+    return _mm_or_si128(jest_litera, jest_cyfra);
+}
+
+CEL_AVX2 static inline __m256i alnum_avx2(__m256i v) {
+    const __m256i litera = _mm256_sub_epi8(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i cyfra = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+    const __m256i jest_litera = _mm256_cmpeq_epi8(_mm256_min_epu8(litera, _mm256_set1_epi8(25)), litera);
+    const __m256i jest_cyfra = _mm256_cmpeq_epi8(_mm256_min_epu8(cyfra, _mm256_set1_epi8(9)), cyfra);
+    return _mm256_or_si256(jest_litera, jest_cyfra);
+}
+
+// Całe słowa, SSE2: filtr pierwszego/ostatniego bajtu odrzuca od razu kandydatów z literą ASCII przed lub za słowem
+static uint64_t licz_cale_slowa_sse2(const char* s, size_t n, const char* p, size_t m, const PolozenieFragmentu& polozenie,
+    std::vector<size_t>* pozycje) {
+    uint64_t count = 0;
+    const __m128i pierwszy = _mm_set1_epi8(p[0]);
+    const __m128i ostatni = _mm_set1_epi8(p[m - 1]);
+    size_t i = 1;  // Blok potrzebuje bajtu przed (i - 1) i za (i + m) każdą pozycją
+    if (s[0] == p[0] && s[m - 1] == p[m - 1] && cale_slowo(s, n, 0, p, m, polozenie)) zapisz_trafienie(0, count, pozycje);  // Pozycja 0 nie ma bajtu przed
+
+    for (; i + m + 16 <= n; i += 16) {
+        __m128i blok_pierwszy = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        __m128i blok_ostatni = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + m - 1));
+        __m128i kandydaci = _mm_and_si128(_mm_cmpeq_epi8(blok_pierwszy, pierwszy), _mm_cmpeq_epi8(blok_ostatni, ostatni));
+        if (_mm_movemask_epi8(kandydaci) == 0) continue;  // Większość bloków - bez klasyfikacji granic
+
+        __m128i przed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i - 1));
+        __m128i za = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + m));
+        __m128i granice = _mm_or_si128(alnum_sse2(przed), alnum_sse2(za));
+        uint32_t maska = static_cast<uint32_t>(_mm_movemask_epi8(_mm_andnot_si128(granice, kandydaci)));
+
+        while (maska) {  // Weryfikuj każdego kandydata (w tym bajty UTF-8 wokół słowa)
+            unsigned bit = najnizszy_bit(maska);
+            if (cale_slowo(s, n, i + bit, p, m, polozenie)) zapisz_trafienie(i + bit, count, pozycje);
+            maska &= maska - 1;
+        }
+    }
+    return count + licz_cale_slowa_skalarnie(s, n, p, m, i, polozenie, pozycje);  // Końcówka krótsza niż blok
+}
+
+// Całe słowa, AVX2 - 32 pozycje na iterację
+CEL_AVX2 static uint64_t licz_cale_slowa_avx2(const char* s, size_t n, const char* p, size_t m, const PolozenieFragmentu& polozenie,
+    std::vector<size_t>* pozycje) {
+    uint64_t count = 0;
+    const __m256i pierwszy = _mm256_set1_epi8(p[0]);
+    const __m256i ostatni = _mm256_set1_epi8(p[m - 1]);
+    size_t i = 1;
+    if (s[0] == p[0] && s[m - 1] == p[m - 1] && cale_slowo(s, n, 0, p, m, polozenie)) zapisz_trafienie(0, count, pozycje);
+
+    for (; i + m + 32 <= n; i += 32) {
+        __m256i blok_pierwszy = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        __m256i blok_ostatni = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + m - 1));
+        __m256i kandydaci = _mm256_and_si256(_mm256_cmpeq_epi8(blok_pierwszy, pierwszy), _mm256_cmpeq_epi8(blok_ostatni, ostatni));
+        if (_mm256_testz_si256(kandydaci, kandydaci)) continue;
+
+        __m256i przed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i - 1));
+        __m256i za = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + m));
+        __m256i granice = _mm256_or_si256(alnum_avx2(przed), alnum_avx2(za));
+        uint32_t maska = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_andnot_si256(granice, kandydaci)));
+
+        while (maska) {
+            unsigned bit = najnizszy_bit(maska);
+            if (cale_slowo(s, n, i + bit, p, m, polozenie)) zapisz_trafienie(i + bit, count, pozycje);
+            maska &= maska - 1;
+        }
+    }
+    return count + licz_cale_slowa_skalarnie(s, n, p, m, i, polozenie, pozycje);
+}
+
+// Bez diakrytyków: wektory ZbiorPoczatkow przygotowane przed pętlą
+struct ZbiorSSE2 {
+    __m128i znak;       // Bajt wzorca
+    __m128i wielkosc;   // 0x20 dla liter ASCII (OR sprowadza wielką literę do małej), 0 dla pozostałych bajtów
+    __m128i wiodace[3]; // 0xFF, jeśli bajt wiodący 0xC3 + k należy do zbioru
+};
+
+static ZbiorSSE2 zbior_sse2(const ZbiorPoczatkow& zbior) {
+    ZbiorSSE2 wynik;
+    wynik.znak = _mm_set1_epi8(static_cast<char>(zbior.znak));
+    wynik.wielkosc = _mm_set1_epi8(zbior.litera ? 0x20 : 0);
+    for (int k = 0; k < 3; ++k) wynik.wiodace[k] = _mm_set1_epi8(zbior.wiodace[k] ? static_cast<char>(0xFF) : 0);
+    return wynik;
+}
+
+// Maska bajtów rozpoczynających znak ASCII ze zbioru (obie wielkości litery)
+static inline __m128i ascii_sse2(__m128i v, const ZbiorSSE2& zbior) {
+    return _mm_cmpeq_epi8(_mm_or_si128(v, zbior.wielkosc), zbior.znak);
+}
+
+// Maska bajtów wiodących liter UTF-8 składanych do znaku ze zbioru
+static inline __m128i wiodace_sse2(__m128i v, const ZbiorSSE2& zbior) {
+    __m128i wynik = _mm_and_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(0xC3))), zbior.wiodace[0]);
+    wynik = _mm_or_si128(wynik, _mm_and_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(0xC4))), zbior.wiodace[1]));
+    return _mm_or_si128(wynik, _mm_and_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(0xC5))), zbior.wiodace[2]));
+}
+
+// Filtr dwóch pierwszych znaków: drugi znak zaczyna się bajt (znak ASCII) lub dwa bajty (litera UTF-8) za pierwszym
+static uint64_t licz_bez_diakrytykow_sse2(const char* s, size_t n, const char* p, size_t m,
+    const PolozenieFragmentu& polozenie, bool cale_slowa, std::vector<size_t>* pozycje) {
+    const ZbiorSSE2 pierwszy = zbior_sse2(zbior_poczatkow(p[0]));
+    const ZbiorSSE2 drugi = zbior_sse2(zbior_poczatkow(m > 1 ? p[1] : p[0]));
+    uint64_t count = 0;
+    size_t i = 0;
+
+    for (; i + 2 + 16 <= n; i += 16) {
+        __m128i blok = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        __m128i kandydaci;
+        if (m == 1) {
+            kandydaci = _mm_or_si128(ascii_sse2(blok, pierwszy), wiodace_sse2(blok, pierwszy));
+        }
+        else {
+            __m128i po_bajcie = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 1));
+            __m128i po_literze = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 2));
+            kandydaci = _mm_or_si128(
+                _mm_and_si128(ascii_sse2(blok, pierwszy), _mm_or_si128(ascii_sse2(po_bajcie, drugi), wiodace_sse2(po_bajcie, drugi))),
+                _mm_and_si128(wiodace_sse2(blok, pierwszy), _mm_or_si128(ascii_sse2(po_literze, drugi), wiodace_sse2(po_literze, drugi))));
+        }
+        uint32_t maska = static_cast<uint32_t>(_mm_movemask_epi8(kandydaci));
+
+        while (maska) {  // Weryfikuj każdego kandydata, składając znaki tekstu
+            unsigned bit = najnizszy_bit(maska);
+            sprawdz_zlozony(s, n, i + bit, p, m, polozenie, cale_slowa, count, pozycje);
+            maska &= maska - 1;
+        }
+    }
+    return count + licz_bez_diakrytykow_skalarnie(s, n, p, m, i, polozenie, cale_slowa, pozycje);  // Końcówka krótsza niż blok
+}
+
+// Wersja AVX2: bajty wiodące sprawdza tablica PSHUFB indeksowana młodszą połówką bajtu (0xC3-0xC5 -> 3-5)
+struct ZbiorAVX2 {
+    __m256i znak;
+    __m256i wielkosc;
+    __m256i tablica_wiodacych;  // 0xFF pod indeksami 3-5 dla bajtów wiodących ze zbioru
+};
+
+CEL_AVX2 static ZbiorAVX2 zbior_avx2(const ZbiorPoczatkow& zbior) {
+    alignas(16) char tablica[16] = {};
+    for (int k = 0; k < 3; ++k) tablica[3 + k] = zbior.wiodace[k] ? static_cast<char>(0xFF) : 0;
+    ZbiorAVX2 wynik;
+    wynik.znak = _mm256_set1_epi8(static_cast<char>(zbior.znak));
+    wynik.wielkosc = _mm256_set1_epi8(zbior.litera ? 0x20 : 0);
+    wynik.tablica_wiodacych = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(tablica)));
+    return wynik;
+}
+
+CEL_AVX2 static inline __m256i ascii_avx2(__m256i v, const ZbiorAVX2& zbior) {
+    return _mm256_cmpeq_epi8(_mm256_or_si256(v, zbior.wielkosc), zbior.znak);
+}
+
+// Starsza połówka musi być 0xC, młodsza wybiera wpis tablicy
+CEL_AVX2 static inline __m256i wiodace_avx2(__m256i v, const ZbiorAVX2& zbior) {
+    const __m256i starsza = _mm256_cmpeq_epi8(_mm256_and_si256(v, _mm256_set1_epi8(static_cast<char>(0xF0))), _mm256_set1_epi8(static_cast<char>(0xC0)));
+    const __m256i wpis = _mm256_shuffle_epi8(zbior.tablica_wiodacych, _mm256_and_si256(v, _mm256_set1_epi8(0x0F)));
+    return _mm256_and_si256(starsza, wpis);
+}
+
+// Bez diakrytyków, AVX2 - 32 pozycje na iterację
+CEL_AVX2 static uint64_t licz_bez_diakrytykow_avx2(const char* s, size_t n, const char* p, size_t m,
+    const PolozenieFragmentu& polozenie, bool cale_slowa, std::vector<size_t>* pozycje) {
+    const ZbiorAVX2 pierwszy = zbior_avx2(zbior_poczatkow(p[0]));
+    const ZbiorAVX2 drugi = zbior_avx2(zbior_poczatkow(m > 1 ? p[1] : p[0]));
+    uint64_t count = 0;
+    size_t i = 0;
+
+    for (; i + 2 + 32 <= n; i += 32) {
+        __m256i blok = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        __m256i kandydaci;
+        if (m == 1) {
+            kandydaci = _mm256_or_si256(ascii_avx2(blok, pierwszy), wiodace_avx2(blok, pierwszy));
+        }
+        else {
+            __m256i po_bajcie = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + 1));
+            __m256i po_literze = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + 2));
+            kandydaci = _mm256_or_si256(
+                _mm256_and_si256(ascii_avx2(blok, pierwszy), _mm256_or_si256(ascii_avx2(po_bajcie, drugi), wiodace_avx2(po_bajcie, drugi))),
+                _mm256_and_si256(wiodace_avx2(blok, pierwszy), _mm256_or_si256(ascii_avx2(po_literze, drugi), wiodace_avx2(po_literze, drugi))));
+        }
+        if (_mm256_testz_si256(kandydaci, kandydaci)) continue;
+        uint32_t maska = static_cast<uint32_t>(_mm256_movemask_epi8(kandydaci));
+
+        while (maska) {
+            unsigned bit = najnizszy_bit(maska);
+            sprawdz_zlozony(s, n, i + bit, p, m, polozenie, cale_slowa, count, pozycje);
+            maska &= maska - 1;
+        }
+    }
+    return count + licz_bez_diakrytykow_skalarnie(s, n, p, m, i, polozenie, cale_slowa, pozycje);
+}
+
+// Wersja SSE2 - 16 pozycji kandydatów na iterację (SSE2 jest zawsze dostępne na x64)
+static uint64_t licz_sse2(const char* s, size_t n, const char* p, size_t m, std::vector<size_t>* pozycje) {
+    uint64_t count = 0;
+    const __m128i pierwszy = _mm_set1_epi8(p[0]);
+    const __m128i ostatni = _mm_set1_epi8(p[m - 1]);
+    size_t i = 0;
+
+    for (; i + m - 1 + 16 <= n; i += 16) {
+        __m128i blok_pierwszy = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        __m128i blok_ostatni = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + m - 1));
+        uint32_t maska = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(blok_pierwszy, pierwszy), _mm_cmpeq_epi8(blok_ostatni, ostatni))));
+
+        while (maska) {  // Weryfikuj każdego kandydata
+            unsigned bit = najnizszy_bit(maska);
+            if (zgodny_srodek(s + i + bit, p, m)) zapisz_trafienie(i + bit, count, pozycje);
+            maska &= maska - 1;
+        }
+    }
+    return count + licz_skalarnie(s, n, p, m, i, pozycje);  // Końcówka krótsza niż blok
+}
+
+// Wersja AVX2 - 32 pozycje kandydatów na iterację
+CEL_AVX2 static uint64_t licz_avx2(const char* s, size_t n, const char* p, size_t m, std::vector<size_t>* pozycje) {
+    uint64_t count = 0;
+    const __m256i pierwszy = _mm256_set1_epi8(p[0]);
+    const __m256i ostatni = _mm256_set1_epi8(p[m - 1]);
+    size_t i = 0;
+
+    for (; i + m - 1 + 32 <= n; i += 32) {
+        __m256i blok_pierwszy = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        __m256i blok_ostatni = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + m - 1));
+        uint32_t maska = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(blok_pierwszy, pierwszy), _mm256_cmpeq_epi8(blok_ostatni, ostatni))));
+
+        while (maska) {  // Weryfikuj każdego kandydata
+            unsigned bit = najnizszy_bit(maska);
+            if (zgodny_srodek(s + i + bit, p, m)) zapisz_trafienie(i + bit, count, pozycje);
+            maska &= maska - 1;
+        }
+    }
+    return count + licz_skalarnie(s, n, p, m, i, pozycje);  // Końcówka krótsza niż blok
+}
+
+// Zliczanie jednego bajtu w wersji SSE2 - liczniki bajtowe zamiast masek bitowych
+static uint64_t licz_bajt_sse2(const char* s, size_t n, char bajt) {
+    const __m128i wzor = _mm_set1_epi8(bajt);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i suma = _mm_setzero_si128();  // Dwie 64-bitowe sumy częściowe
+    size_t i = 0;
+
+    while (i + 16 <= n) {
+        __m128i liczniki = _mm_setzero_si128();
+        // Porównanie daje 0xFF (-1), więc odejmowanie zwiększa licznik - najwyżej 255 bloków przed przepełnieniem
+        for (size_t blok = 0; blok < 255 && i + 16 <= n; ++blok, i += 16) {
+            __m128i dane = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            liczniki = _mm_sub_epi8(liczniki, _mm_cmpeq_epi8(dane, wzor));
+        }
+        suma = _mm_add_epi64(suma, _mm_sad_epu8(liczniki, zero));
+    }
+
+    uint64_t sumy[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(sumy), suma);
+    uint64_t count = sumy[0] + sumy[1];
+    for (; i < n; ++i) count += (s[i] == bajt);  // Końcówka krótsza niż blok
+    return count;
+}
+
+// Zliczanie jednego bajtu w wersji AVX2 - 32 bajty na iterację
+CEL_AVX2 static uint64_t licz_bajt_avx2(const char* s, size_t n, char bajt) {
+    const __m256i wzor = _mm256_set1_epi8(bajt);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i suma = _mm256_setzero_si256();  // Cztery 64-bitowe sumy częściowe
+    size_t i = 0;
+
+    while (i + 32 <= n) {
+        __m256i liczniki = _mm256_setzero_si256();
+        for (size_t blok = 0; blok < 255 && i + 32 <= n; ++blok, i += 32) {
+            __m256i dane = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+            liczniki = _mm256_sub_epi8(liczniki, _mm256_cmpeq_epi8(dane, wzor));
+        }
+        suma = _mm256_add_epi64(suma, _mm256_sad_epu8(liczniki, zero));
+    }
+
+    __m128i polowki = _mm_add_epi64(_mm256_castsi256_si128(suma), _mm256_extracti128_si256(suma, 1));
+    uint64_t sumy[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(sumy), polowki);
+    uint64_t count = sumy[0] + sumy[1];
+    for (; i < n; ++i) count += (s[i] == bajt);  // Końcówka krótsza niż blok
+    return count;
+}
+
+#endif // SILNIKI_X86
+
+// Wykrywanie możliwości procesora
+// ===============================
+
+static PoziomSIMD wykryj_simd_bez_pamieci() {
+#ifdef SILNIKI_X86
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    int max_funkcja = info[0];
+
+    __cpuid(info, 1);
+    bool sse2 = (info[3] & (1 << 26)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;  // System zapisuje rejestry YMM przy przełączaniu kontekstu
+    bool avx = (info[2] & (1 << 28)) != 0;
+    bool avx2 = false;
+    if (max_funkcja >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    bool sse2 = __builtin_cpu_supports("sse2");
+    bool avx2 = __builtin_cpu_supports("avx2");  // Uwzględnia również wsparcie systemu (XGETBV)
+#endif
+    if (avx2) return PoziomSIMD::AVX2;
+    if (sse2) return PoziomSIMD::SSE2;
+#endif
+    return PoziomSIMD::Skalarny;
+}
+
+bool obsluguje_ssse3() {
+#ifdef SILNIKI_X86
+#ifdef _MSC_VER
+    static const bool wynik = [] {
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 9)) != 0;
+    }();
+    return wynik;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3");
+#endif
+#else
+    return false;
+#endif
+}
+
+std::string nazwa_procesora() {
+#ifdef SILNIKI_X86
+    unsigned int marka[12] = {};
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0x80000000);
+    if (static_cast<unsigned int>(info[0]) < 0x80000004) return "nieznany";
+    for (int i = 0; i < 3; ++i) {
+        __cpuid(info, 0x80000002 + i);
+        for (int j = 0; j < 4; ++j) marka[i * 4 + j] = static_cast<unsigned int>(info[j]);
+    }
+#else
+    if (__get_cpuid_max(0x80000000, nullptr) < 0x80000004) return "nieznany";
+    for (unsigned int i = 0; i < 3; ++i) {
+        __get_cpuid(0x80000002 + i, &marka[i * 4], &marka[i * 4 + 1], &marka[i * 4 + 2], &marka[i * 4 + 3]);
+    }
+#endif
+    std::string nazwa(reinterpret_cast<const char*>(marka), sizeof(marka));
+    nazwa = nazwa.substr(0, nazwa.find('\0'));
+    const size_t poczatek = nazwa.find_first_not_of(' ');  // Intel wyrównuje ciąg spacjami z lewej
+    const size_t koniec = nazwa.find_last_not_of(' ');
+    return poczatek == std::string::npos ? "nieznany" : nazwa.substr(poczatek, koniec - poczatek + 1);
+#else
+    return "nieznany";
+#endif
+}
+
+PoziomSIMD wykryj_simd() {
+    static const PoziomSIMD poziom = wykryj_simd_bez_pamieci();  // Inicjalizacja bezpieczna wątkowo
+    return poziom;
+}
+
+const char* nazwa_simd(PoziomSIMD poziom) {
+    switch (poziom) {
+    case PoziomSIMD::AVX2: return "AVX2";
+    case PoziomSIMD::SSE2: return "SSE2";
+    default: return "skalarny";
+    }
+}
+
+// Publiczne jądra wyszukiwania
+// ============================
+
+uint64_t licz_simd(std::string_view tekst, std::string_view wzorzec, std::vector<size_t>* pozycje) {
+    return licz_simd(tekst, wzorzec, wykryj_simd(), pozycje);
+}
+
+uint64_t licz_simd(std::string_view tekst, std::string_view wzorzec, PoziomSIMD poziom, std::vector<size_t>* pozycje) {
+    const size_t m = wzorzec.size();
+    const size_t n = tekst.size();
+    if (m == 0 || n < m) return 0;  // Zabezpieczenie przed pustym wzorcem
+
+    if (static_cast<int>(poziom) > static_cast<int>(wykryj_simd())) poziom = wykryj_simd();  // Nie wykonuj nieobsługiwanych instrukcji
+
+#ifdef SILNIKI_X86
+    if (poziom == PoziomSIMD::AVX2) return licz_avx2(tekst.data(), n, wzorzec.data(), m, pozycje);
+    if (poziom == PoziomSIMD::SSE2) return licz_sse2(tekst.data(), n, wzorzec.data(), m, pozycje);
+#endif
+    return licz_skalarnie(tekst.data(), n, wzorzec.data(), m, 0, pozycje);
+}
+
+uint64_t licz_cale_slowa(std::string_view tekst, std::string_view wzorzec, const PolozenieFragmentu& polozenie, std::vector<size_t>* pozycje) {
+    return licz_cale_slowa(tekst, wzorzec, polozenie, wykryj_simd(), pozycje);
+}
+
+uint64_t licz_cale_slowa(std::string_view tekst, std::string_view wzorzec, const PolozenieFragmentu& polozenie, PoziomSIMD poziom,
+    std::vector<size_t>* pozycje) {
+    const size_t m = wzorzec.size();
+    const size_t n = tekst.size();
+    if (m == 0 || n < m) return 0;
+
+    if (static_cast<int>(poziom) > static_cast<int>(wykryj_simd())) poziom = wykryj_simd();
+
+#ifdef SILNIKI_X86
+    if (poziom == PoziomSIMD::AVX2) return licz_cale_slowa_avx2(tekst.data(), n, wzorzec.data(), m, polozenie, pozycje);
+    if (poziom == PoziomSIMD::SSE2) return licz_cale_slowa_sse2(tekst.data(), n, wzorzec.data(), m, polozenie, pozycje);
+#endif
+    return licz_cale_slowa_skalarnie(tekst.data(), n, wzorzec.data(), m, 0, polozenie, pozycje);
+}
+
+uint64_t licz_bez_diakrytykow(std::string_view tekst, std::string_view zlozony_wzorzec, const PolozenieFragmentu& polozenie, bool cale_slowa,
+    std::vector<size_t>* pozycje) {
+    return licz_bez_diakrytykow(tekst, zlozony_wzorzec, polozenie, cale_slowa, wykryj_simd(), pozycje);
+}
+
+uint64_t licz_bez_diakrytykow(std::string_view tekst, std::string_view zlozony_wzorzec, const PolozenieFragmentu& polozenie, bool cale_slowa, PoziomSIMD poziom,
+    std::vector<size_t>* pozycje) {
+    const size_t m = zlozony_wzorzec.size();
+    const size_t n = tekst.size();
+    if (m == 0 || n < m) return 0;  // Dopasowanie ma co najmniej m bajtów
+
+    if (static_cast<int>(poziom) > static_cast<int>(wykryj_simd())) poziom = wykryj_simd();
+
+#ifdef SILNIKI_X86
+    if (poziom == PoziomSIMD::AVX2) return licz_bez_diakrytykow_avx2(tekst.data(), n, zlozony_wzorzec.data(), m, polozenie, cale_slowa, pozycje);
+    if (poziom == PoziomSIMD::SSE2) return licz_bez_diakrytykow_sse2(tekst.data(), n, zlozony_wzorzec.data(), m, polozenie, cale_slowa, pozycje);
+#endif
+    return licz_bez_diakrytykow_skalarnie(tekst.data(), n, zlozony_wzorzec.data(), m, 0, polozenie, cale_slowa, pozycje);
+}
+
+uint64_t licz_bajt(std::string_view tekst, char bajt, std::vector<size_t>* pozycje) {
+    const char* s = tekst.data();
+    const size_t n = tekst.size();
+#ifdef SILNIKI_X86
+    if (!pozycje && wykryj_simd() == PoziomSIMD::AVX2) return licz_bajt_avx2(s, n, bajt);  // Liczniki bajtowe nie dają pozycji
+    if (!pozycje && wykryj_simd() == PoziomSIMD::SSE2) return licz_bajt_sse2(s, n, bajt);
+#endif
+    uint64_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const void* trafienie = memchr(s + i, bajt, n - i);
+        if (!trafienie) break;
+        i = static_cast<size_t>(static_cast<const char*>(trafienie) - s);
+        zapisz_trafienie(i, count, pozycje);
+    }
+    return count;
+}
+
+std::vector<uint32_t> tablica_horspool(std::string_view wzorzec) {
+    const size_t m = wzorzec.size();
+    std::vector<uint32_t> przesuniecia(256, static_cast<uint32_t>(m));  // Bajt spoza wzorca - przeskocz całe okno
+    for (size_t i = 0; i + 1 < m; ++i) {  // Ostatni bajt wzorca nie wpływa na przesunięcie
+        przesuniecia[static_cast<unsigned char>(wzorzec[i])] = static_cast<uint32_t>(m - 1 - i);
+    }
+    return przesuniecia;
+}
+
+uint64_t licz_horspool(std::string_view tekst, std::string_view wzorzec, const uint32_t* przesuniecia, std::vector<size_t>* pozycje) {
+    const size_t m = wzorzec.size();
+    const size_t n = tekst.size();
+    if (m == 0 || n < m) return 0;  // Zabezpieczenie przed pustym wzorcem
+
+    uint64_t count = 0;
+    const char* s = tekst.data();
+    const char* p = wzorzec.data();
+    const char ostatni = p[m - 1];
+    for (size_t i = 0; i + m <= n;) {
+        const char c = s[i + m - 1];
+        if (c == ostatni && memcmp(s + i, p, m - 1) == 0) zapisz_trafienie(i, count, pozycje);
+        // Przesunięcie zależy tylko od bajtu pod końcem okna, więc nie pomija nakładających się wystąpień
+        i += przesuniecia[static_cast<unsigned char>(c)];
+    }
+    return count;
+}
+
+uint64_t licznik_cykli() {
+#ifdef SILNIKI_X86
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Matcher Teddy dla małych zestawów słów
+// ======================================
+
+Teddy::Teddy(const std::vector<std::string>& wzorce) : wzorce_(wzorce), koszyki_(8) {
+    std::vector<uint32_t> kolejnosc;  // Niepuste słowa
+    size_t min_dlugosc = 0;
+    for (uint32_t id = 0; id < wzorce_.size(); ++id) {
+        size_t dl = wzorce_[id].size();
+        if (dl == 0) continue;  // Pusty wzorzec nie ma wystąpień
+        kolejnosc.push_back(id);
+        if (min_dlugosc == 0 || dl < min_dlugosc) min_dlugosc = dl;
+        if (dl > maks_dlugosc_) maks_dlugosc_ = dl;
+    }
+    odcisk_ = (min_dlugosc == 0) ? 1 : (min_dlugosc < 3 ? min_dlugosc : 3);
+
+    // Słowa o podobnych początkach trafiają do tego samego koszyka - mniej fałszywych kandydatów
+    std::sort(kolejnosc.begin(), kolejnosc.end(), [&](uint32_t a, uint32_t b) {
+        return wzorce_[a].compare(0, odcisk_, wzorce_[b], 0, odcisk_) < 0;
+    });
+
+    memset(maski_niskie_, 0, sizeof(maski_niskie_));
+    memset(maski_wysokie_, 0, sizeof(maski_wysokie_));
+    for (size_t i = 0; i < kolejnosc.size(); ++i) {
+        const size_t koszyk = i * 8 / kolejnosc.size();  // Ciągłe bloki posortowanych słów
+        const uint32_t id = kolejnosc[i];
+        koszyki_[koszyk].push_back(id);
+        for (size_t k = 0; k < odcisk_; ++k) {
+            unsigned char c = static_cast<unsigned char>(wzorce_[id][k]);
+            maski_niskie_[k][c & 0x0F] |= static_cast<uint8_t>(1u << koszyk);
+            maski_wysokie_[k][c >> 4] |= static_cast<uint8_t>(1u << koszyk);
+        }
+    }
+}
+
+const char* Teddy::nazwa() const {
+#ifdef SILNIKI_X86
+    if (wykryj_simd() == PoziomSIMD::AVX2) return "Teddy (AVX2)";
+    if (obsluguje_ssse3()) return "Teddy (SSSE3)";
+#endif
+    return "Teddy (skalarny)";
+}
+
+void Teddy::weryfikuj(const char* s, size_t n, size_t poz, uint8_t koszyki, size_t min_koniec, size_t max_poczatek, std::vector<uint64_t>& liczniki) const {
+    if (poz >= max_poczatek) return;  // Dopasowanie należy do następnego fragmentu
+    while (koszyki) {
+        const unsigned koszyk = najnizszy_bit(koszyki);
+        for (uint32_t id : koszyki_[koszyk]) {
+            const size_t dl = wzorce_[id].size();
+            if (poz + dl <= n && poz + dl - 1 >= min_koniec && memcmp(s + poz, wzorce_[id].data(), dl) == 0) {
+                ++liczniki[id];
+            }
+        }
+        koszyki &= static_cast<uint8_t>(koszyki - 1);
+    }
+}
+
+void Teddy::zlicz_skalarnie(const char* s, size_t n, size_t od, size_t min_koniec, size_t max_poczatek, std::vector<uint64_t>& liczniki) const {
+    size_t koniec = n - odcisk_ + 1;  // Ostatnia pozycja, od której mieści się odcisk
+    if (koniec > max_poczatek) koniec = max_poczatek;
+    for (size_t poz = od; poz < koniec; ++poz) {
+        uint8_t koszyki = 0xFF;
+        for (size_t k = 0; k < odcisk_; ++k) {  // Te same tablice co w wersji wektorowej
+            unsigned char c = static_cast<unsigned char>(s[poz + k]);
+            koszyki &= maski_niskie_[k][c & 0x0F] & maski_wysokie_[k][c >> 4];
+        }
+        if (koszyki) weryfikuj(s, n, poz, koszyki, min_koniec, max_poczatek, liczniki);
+    }
+}
+
+#ifdef SILNIKI_X86
+
+// Wersja SSSE3 - PSHUFB sprawdza 16 pozycji naraz
+CEL_SSSE3 void Teddy::zlicz_ssse3(const char* s, size_t n, size_t min_koniec, size_t max_poczatek, std::vector<uint64_t>& liczniki) const {
+    const __m128i polowka = _mm_set1_epi8(0x0F);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i niskie[3], wysokie[3];
+    for (size_t k = 0; k < odcisk_; ++k) {
+        niskie[k] = _mm_load_si128(reinterpret_cast<const __m128i*>(maski_niskie_[k]));
+        wysokie[k] = _mm_load_si128(reinterpret_cast<const __m128i*>(maski_wysokie_[k]));
+    }
+
+    size_t koniec = n - odcisk_ + 1;
+    if (koniec > max_poczatek) koniec = max_poczatek;
+    size_t i = 0;
+    for (; i + 16 <= koniec; i += 16) {
+        __m128i wynik = _mm_set1_epi8(-1);
+        for (size_t k = 0; k < odcisk_; ++k) {  // Bajt k odcisku leży na pozycji i + k
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + k));
+            __m128i mlodsza = _mm_and_si128(v, polowka);
+            __m128i starsza = _mm_and_si128(_mm_srli_epi16(v, 4), polowka);
+            wynik = _mm_and_si128(wynik, _mm_and_si128(_mm_shuffle_epi8(niskie[k], mlodsza), _mm_shuffle_epi8(wysokie[k], starsza)));
+        }
+
+        uint32_t kandydaci = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(wynik, zero))) & 0xFFFFu;
+        if (kandydaci) {
+            alignas(16) uint8_t koszyki[16];
+            _mm_store_si128(reinterpret_cast<__m128i*>(koszyki), wynik);
+            while (kandydaci) {
+                unsigned j = najnizszy_bit(kandydaci);
+                weryfikuj(s, n, i + j, koszyki[j], min_koniec, max_poczatek, liczniki);
+                kandydaci &= kandydaci - 1;
+            }
+        }
+    }
+    zlicz_skalarnie(s, n, i, min_koniec, max_poczatek, liczniki);  // Końcówka krótsza niż blok
+}
+
+// Wersja AVX2 - VPSHUFB działa w obrębie 128-bitowych połówek, więc tablice są powielone w obu
+CEL_AVX2 void Teddy::zlicz_avx2(const char* s, size_t n, size_t min_koniec, size_t max_poczatek, std::vector<uint64_t>& liczniki) const {
+    const __m256i polowka = _mm256_set1_epi8(0x0F);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i niskie[3], wysokie[3];
+    for (size_t k = 0; k < odcisk_; ++k) {
+        niskie[k] = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(maski_niskie_[k])));
+        wysokie[k] = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(maski_wysokie_[k])));
+    }
+
+    size_t koniec = n - odcisk_ + 1;
+    if (koniec > max_poczatek) koniec = max_poczatek;
+    size_t i = 0;
+    for (; i + 32 <= koniec; i += 32) {
+        __m256i wynik = _mm256_set1_epi8(-1);
+        for (size_t k = 0; k < odcisk_; ++k) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + k));
+            __m256i mlodsza = _mm256_and_si256(v, polowka);
+            __m256i starsza = _mm256_and_si256(_mm256_srli_epi16(v, 4), polowka);
+            wynik = _mm256_and_si256(wynik, _mm256_and_si256(_mm256_shuffle_epi8(niskie[k], mlodsza), _mm256_shuffle_epi8(wysokie[k], starsza)));
+        }
+
+        uint32_t kandydaci = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(wynik, zero)));
+        if (kandydaci) {
+            alignas(32) uint8_t koszyki[32];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(koszyki), wynik);
+            while (kandydaci) {
+                unsigned j = najnizszy_bit(kandydaci);
+                weryfikuj(s, n, i + j, koszyki[j], min_koniec, max_poczatek, liczniki);
+                kandydaci &= kandydaci - 1;
+            }
+        }
+    }
+    zlicz_skalarnie(s, n, i, min_koniec, max_poczatek, liczniki);  // Końcówka krótsza niż blok
+}
+
+#endif // SILNIKI_X86
+
+void Teddy::zlicz(std::string_view fragment, size_t min_koniec, size_t max_poczatek, std::vector<uint64_t>& liczniki) const {
+    if (liczniki.size() < wzorce_.size()) liczniki.resize(wzorce_.size(), 0);
+    if (maks_dlugosc_ == 0 || fragment.size() < odcisk_) return;
+
+    const char* s = fragment.data();
+    const size_t n = fragment.size();
+#ifdef SILNIKI_X86
+    if (wykryj_simd() == PoziomSIMD::AVX2) return zlicz_avx2(s, n, min_koniec, max_poczatek, liczniki);
+    if (obsluguje_ssse3()) return zlicz_ssse3(s, n, min_koniec, max_poczatek, liczniki);
+#endif
+    zlicz_skalarnie(s, n, 0, min_koniec, max_poczatek, liczniki);
+}
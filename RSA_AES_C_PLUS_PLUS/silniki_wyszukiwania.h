@@ -0,0 +1,210 @@
+#pragma once                 // Dyrektywa kompilatora zapobiegająca wielokrotnemu dołączaniu
+#ifndef SILNIKI_WYSZUKIWANIA_H   // Tradycyjne zabezpieczenie przed podwójnym include
+#define SILNIKI_WYSZUKIWANIA_H
+
+#include <string_view>  // Lekka reprezentacja fragmentów stringów
+#include <cstdint>      // Typy o stałej szerokości (uint64_t)
+#include <string>       // Biblioteka do obsługi ciągów znaków (std::string)
+#include <vector>       // Lista wzorców i liczniki
+#include <cstddef>      // size_t
+
+// Zestaw instrukcji wektorowych używany przez jądra wyszukiwania
+enum class PoziomSIMD {
+    Skalarny,  // Brak instrukcji wektorowych (memchr + memcmp)
+    SSE2,      // 16 bajtów na iterację
+    AVX2       // 32 bajty na iterację
+};
+
+/**
+ * Wykrywa najlepszy zestaw instrukcji obsługiwany przez procesor i system (CPUID/XGETBV)
+ * @return Poziom SIMD - wynik jest obliczany raz i zapamiętywany
+ */
+PoziomSIMD wykryj_simd();
+
+/**
+ * Zwraca nazwę poziomu SIMD do raportów
+ * @param poziom Poziom SIMD
+ */
+const char* nazwa_simd(PoziomSIMD poziom);
+
+/**
+ * Zlicza wystąpienia wzorca (również nakładające się) wektorowym filtrem pierwszego i ostatniego bajtu
+ * @param tekst Przeszukiwany fragment
+ * @param wzorzec Szukany wzorzec
+ * @param pozycje[out] Opcjonalnie: dopisywane są rosnąco początki wystąpień (względem początku tekstu);
+ *        tak samo w pozostałych jądrach jednego słowa
+ * @return Liczba wystąpień - identyczna jak w algorytmie KMP
+ * @details Kandydaci są wyznaczani porównaniem 32 (AVX2) lub 16 (SSE2) pozycji naraz z pierwszym
+ *          i ostatnim bajtem wzorca, a następnie weryfikowani przez memcmp. Poziom wybierany w czasie
+ *          wykonania przez wykryj_simd().
+ */
+uint64_t licz_simd(std::string_view tekst, std::string_view wzorzec, std::vector<size_t>* pozycje = nullptr);
+
+/**
+ * Jak wyżej, ale z wymuszonym poziomem SIMD (do porównań wydajności)
+ * @param poziom Poziom SIMD - jeśli procesor go nie obsługuje, używany jest wykryj_simd()
+ */
+uint64_t licz_simd(std::string_view tekst, std::string_view wzorzec, PoziomSIMD poziom, std::vector<size_t>* pozycje = nullptr);
+
+/**
+ * Położenie przeszukiwanego widoku w pliku - tryb całych słów sprawdza znaki wokół dopasowania,
+ * więc musi wiedzieć, czy brak bajtu przed/za widokiem oznacza granicę pliku, czy inny fragment
+ */
+struct PolozenieFragmentu {
+    bool poczatek_pliku = true;  // Widok zaczyna się na początku pliku
+    bool koniec_pliku = true;    // Widok kończy się na końcu pliku
+    size_t wlasciwa = SIZE_MAX;  // Długość części właściwej - okna zaczynające się dalej należą do następnego fragmentu
+    size_t nakladka = 0;         // Bajty przeniesione z poprzedniego bufora strumienia - okna mieszczące się w nich były już liczone
+};
+
+// Dodatkowe bajty wokół słowa w trybie całych słów: 2 przed (litera UTF-8 ma 2 bajty) i 1 za słowem.
+// Fragmenty i bufory strumienia muszą mieć nakładkę dla wzorca o długości m + KONTEKST_CALYCH_SLOW.
+constexpr size_t KONTEKST_CALYCH_SLOW = 3;
+
+/**
+ * Sprawdza, czy bajt rozpoczyna znak słowa (litera/cyfra ASCII lub polska litera UTF-8)
+ * @details Polskie litery (i pozostałe litery łacińskie z zakresu U+00C0-U+017F) mają w UTF-8 bajt
+ *          wiodący 0xC3-0xC5. Znaki interpunkcyjne UTF-8 (cudzysłowy, myślniki) mają inne bajty wiodące.
+ */
+bool znak_slowa(unsigned char bajt);
+
+/**
+ * Zlicza wystąpienia wzorca jako całego słowa - przed i za nim nie może stać znak słowa
+ * @param tekst Przeszukiwany widok (fragment z nakładką lub bufor strumienia)
+ * @param wzorzec Szukane słowo
+ * @param polozenie Położenie widoku w pliku
+ * @return Liczba wystąpień, w których "kot" nie jest częścią "kotek" ani "szkoto"
+ * @details Każde wystąpienie jest przypisane do okna [początek - 2, koniec + 1) i liczone w widoku,
+ *          w którym to okno się mieści i zaczyna w części właściwej. Klasyfikacja sąsiednich bajtów ASCII
+ *          odbywa się wektorowo razem z filtrem pierwszego/ostatniego bajtu; bajty UTF-8 są sprawdzane
+ *          skalarnie tylko dla kandydatów, którzy przeszli filtr.
+ */
+uint64_t licz_cale_slowa(std::string_view tekst, std::string_view wzorzec, const PolozenieFragmentu& polozenie,
+    std::vector<size_t>* pozycje = nullptr);
+
+/**
+ * Jak wyżej, ale z wymuszonym poziomem SIMD (do porównań wydajności)
+ */
+uint64_t licz_cale_slowa(std::string_view tekst, std::string_view wzorzec, const PolozenieFragmentu& polozenie, PoziomSIMD poziom,
+    std::vector<size_t>* pozycje = nullptr);
+
+/**
+ * Składa tekst do postaci porównywanej w trybie bez rozróżniania wielkości liter i znaków diakrytycznych
+ * @param tekst Tekst UTF-8 (zwykle szukane słowo)
+ * @return Jeden bajt na znak: litery ASCII małe, 2-bajtowe litery łacińskie (U+00C0-U+017F) jako mała
+ *         litera bazowa, pozostałe bajty bez zmian - "Łódź", "ŁÓDŹ" i "lodz" dają "lodz"
+ */
+std::string zloz_znaki(std::string_view tekst);
+
+/**
+ * Zlicza wystąpienia wzorca bez rozróżniania wielkości liter i znaków diakrytycznych
+ * @param tekst Przeszukiwany widok - nie jest kopiowany ani składany w całości
+ * @param zlozony_wzorzec Wzorzec po zloz_znaki()
+ * @param polozenie Położenie widoku w pliku
+ * @param cale_slowa Tylko wystąpienia będące całym słowem (granice jak w licz_cale_slowa)
+ * @return Liczba wystąpień (również nakładających się)
+ * @details Wystąpienie wzorca o m znakach zajmuje od m do 2m bajtów tekstu, więc nakładka fragmentów
+ *          musi mieć 2m - 1 bajtów (2m + 2 z całymi słowami). Filtr wektorowy porównuje pierwsze dwa
+ *          znaki z ich wariantami (wielka litera ASCII, bajty wiodące liter UTF-8), a kandydaci są
+ *          weryfikowani składaniem znaków tekstu przez tablicę liter bazowych.
+ */
+uint64_t licz_bez_diakrytykow(std::string_view tekst, std::string_view zlozony_wzorzec, const PolozenieFragmentu& polozenie, bool cale_slowa,
+    std::vector<size_t>* pozycje = nullptr);
+
+/**
+ * Jak wyżej, ale z wymuszonym poziomem SIMD (do porównań wydajności)
+ */
+uint64_t licz_bez_diakrytykow(std::string_view tekst, std::string_view zlozony_wzorzec, const PolozenieFragmentu& polozenie, bool cale_slowa, PoziomSIMD poziom,
+    std::vector<size_t>* pozycje = nullptr);
+
+/**
+ * Zlicza wystąpienia jednego bajtu (wzorce jednoznakowe)
+ * @param tekst Przeszukiwany fragment
+ * @param bajt Szukany znak
+ * @return Liczba wystąpień
+ * @details Wersje wektorowe sumują wyniki porównań w licznikach bajtowych i co 255 bloków składają
+ *          je instrukcją PSADBW - bez pętli po bitach maski. Wersja skalarna używa memchr
+ *          (również z pozycjami - liczniki bajtowe ich nie dają).
+ */
+uint64_t licz_bajt(std::string_view tekst, char bajt, std::vector<size_t>* pozycje = nullptr);
+
+/**
+ * Buduje tablicę przesunięć Boyera-Moore'a-Horspoola (256 wpisów)
+ * @param wzorzec Szukany wzorzec (niepusty)
+ * @return Dla każdego bajtu: o ile przesunąć okno, gdy ten bajt stoi pod ostatnią pozycją wzorca
+ */
+std::vector<uint32_t> tablica_horspool(std::string_view wzorzec);
+
+/**
+ * Zlicza wystąpienia wzorca (również nakładające się) algorytmem Boyera-Moore'a-Horspoola
+ * @param tekst Przeszukiwany fragment
+ * @param wzorzec Szukany wzorzec
+ * @param przesuniecia Tablica z tablica_horspool() dla tego wzorca
+ * @return Liczba wystąpień - identyczna jak w algorytmie KMP
+ * @details Dla długich wzorców okno przesuwa się średnio o prawie całą długość wzorca,
+ *          więc większość bajtów tekstu nie jest w ogóle odczytywana.
+ */
+uint64_t licz_horspool(std::string_view tekst, std::string_view wzorzec, const uint32_t* przesuniecia, std::vector<size_t>* pozycje = nullptr);
+
+/**
+ * Odczytuje licznik cykli procesora (RDTSC) do przeliczania przepustowości na bajty/cykl
+ * @note Na procesorach innych niż x86 zwraca nanosekundy zegara monotonicznego
+ */
+uint64_t licznik_cykli();
+
+/**
+ * Nazwa modelu procesora do opisu środowiska pomiarów (ciąg marki CPUID 0x80000002-0x80000004)
+ * @return Np. "AMD Ryzen 9 7950X 16-Core Processor"; "nieznany" poza x86 lub bez ciągu marki
+ */
+std::string nazwa_procesora();
+
+/**
+ * Wektorowy matcher małych zestawów słów (metoda Teddy)
+ * @brief Dla 2-32 krótkich słów automat jest zbyt duży względem pracy - Teddy dzieli słowa na 8 koszyków
+ *        i dla pierwszych (maksymalnie 3) bajtów każdego słowa buduje maski połówek bajtu (nibble).
+ *        Instrukcja PSHUFB sprawdza 16 (SSSE3) lub 32 (AVX2) pozycji naraz, a kandydaci z koszyka
+ *        są weryfikowani przez memcmp. Bez SSSE3 używana jest skalarna wersja tych samych tablic.
+ */
+class Teddy {
+public:
+    static constexpr size_t MAKS_SLOW = 32;  // Powyżej tej liczby słów fałszywych kandydatów jest za dużo
+
+    /**
+     * Buduje maski dla zestawu słów
+     * @param wzorce Szukane słowa (co najwyżej MAKS_SLOW) - puste słowa są pomijane
+     */
+    explicit Teddy(const std::vector<std::string>& wzorce);
+
+    /**
+     * Zlicza wystąpienia wszystkich słów - semantyka jak w AhoCorasick::zlicz
+     * @param fragment Przeszukiwany fragment
+     * @param min_koniec Dopasowania kończące się przed tym indeksem są pomijane
+     * @param max_poczatek Dopasowania zaczynające się od tego indeksu są pomijane
+     * @param liczniki[in,out] Liczniki słów - wyniki są dodawane do istniejących wartości
+     */
+    void zlicz(std::string_view fragment, size_t min_koniec, size_t max_poczatek, std::vector<uint64_t>& liczniki) const;
+
+    size_t maks_dlugosc() const { return maks_dlugosc_; }  // Długość najdłuższego słowa
+    const char* nazwa() const;                             // Nazwa wersji wybranej w czasie wykonania
+
+private:
+    // Wspólna weryfikacja kandydatów z koszyków zapisanych w bitach `koszyki` dla pozycji `poz`
+    void weryfikuj(const char* s, size_t n, size_t poz, uint8_t koszyki, size_t min_koniec, size_t max_poczatek, std::vector<uint64_t>& liczniki) const;
+    void zlicz_skalarnie(const char* s, size_t n, size_t od, size_t min_koniec, size_t max_poczatek, std::vector<uint64_t>& liczniki) const;
+    void zlicz_ssse3(const char* s, size_t n, size_t min_koniec, size_t max_poczatek, std::vector<uint64_t>& liczniki) const;  // Tylko x86
+    void zlicz_avx2(const char* s, size_t n, size_t min_koniec, size_t max_poczatek, std::vector<uint64_t>& liczniki) const;   // Tylko x86
+
+    std::vector<std::string> wzorce_;
+    std::vector<std::vector<uint32_t>> koszyki_;  // Numery słów w każdym z 8 koszyków
+    size_t odcisk_ = 1;         // Liczba bajtów odcisku (1-3, nie więcej niż najkrótsze słowo)
+    size_t maks_dlugosc_ = 0;
+    alignas(16) uint8_t maski_niskie_[3][16];  // [bajt odcisku][młodsza połówka] -> bity koszyków
+    alignas(16) uint8_t maski_wysokie_[3][16]; // [bajt odcisku][starsza połówka] -> bity koszyków
+};
+
+/**
+ * Sprawdza, czy procesor obsługuje PSHUFB (SSSE3) - wymagane przez wektorową wersję Teddy
+ */
+bool obsluguje_ssse3();
+
+#endif // SILNIKI_WYSZUKIWANIA_H
@@ -0,0 +1,190 @@
+// Sekcja includów - dołączanie niezbędnych bibliotek
+#include "topologia_numa.h"  // Deklaracje topologii i pamięci stron
+#include <thread>            // std::thread::hardware_concurrency - topologia zastępcza
+#include <utility>           // std::swap
+#include <algorithm>         // std::sort
+
+#ifdef _WIN32
+#define NOMINMAX             // Wyłącz makra min/max z windows.h
+#include <windows.h>         // GetNumaNodeProcessorMaskEx, SetThreadGroupAffinity, VirtualAlloc
+#else
+#include <sched.h>           // sched_getaffinity, sched_setaffinity
+#include <sys/mman.h>        // mmap - strony bez dotykania
+#include <fstream>           // Odczyt cpulist węzła
+#include <sstream>           // Podział listy procesorów
+#include <filesystem>        // Katalogi węzłów w /sys
+#endif
+
+// Wykrywanie węzłów
+// =================
+
+#ifndef _WIN32
+// Lista procesorów w formacie jądra, np. "0-15,32-47"
+static std::vector<int> parsuj_liste_procesorow(const std::string& lista) {
+    std::vector<int> wynik;
+    std::stringstream strumien(lista);
+    std::string zakres;
+    while (std::getline(strumien, zakres, ',')) {
+        if (zakres.empty() || zakres[0] < '0' || zakres[0] > '9') continue;
+        const size_t kreska = zakres.find('-');
+        const int od = std::stoi(zakres.substr(0, kreska));
+        const int do_ = kreska == std::string::npos ? od : std::stoi(zakres.substr(kreska + 1));
+        for (int p = od; p <= do_; ++p) wynik.push_back(p);
+    }
+    return wynik;
+}
+#endif
+
+TopologiaNUMA::TopologiaNUMA() {
+#ifdef _WIN32
+    ULONG najwyzszy = 0;
+    if (GetNumaHighestNodeNumber(&najwyzszy)) {
+        for (ULONG wezel = 0; wezel <= najwyzszy; ++wezel) {
+            GROUP_AFFINITY maska{};
+            if (!GetNumaNodeProcessorMaskEx(static_cast<USHORT>(wezel), &maska)) continue;
+            std::vector<ProcesorLogiczny> procesory;
+            for (uint16_t bit = 0; bit < 64; ++bit) {
+                if (maska.Mask & (static_cast<KAFFINITY>(1) << bit)) procesory.push_back({ maska.Group, bit });
+            }
+            if (!procesory.empty()) wezly_.push_back(std::move(procesory));
+        }
+    }
+#else
+    // Tylko procesory dozwolone dla procesu (kontenery, taskset) - do innych nie da się przypiąć
+    cpu_set_t dozwolone;
+    CPU_ZERO(&dozwolone);
+    const bool znana_maska = sched_getaffinity(0, sizeof(dozwolone), &dozwolone) == 0;
+
+    std::vector<std::pair<int, std::string>> katalogi;
+    std::error_code blad;
+    for (const auto& wpis : std::filesystem::directory_iterator("/sys/devices/system/node", blad)) {
+        const std::string nazwa = wpis.path().filename().string();
+        if (nazwa.size() > 4 && nazwa.compare(0, 4, "node") == 0 && nazwa.find_first_not_of("0123456789", 4) == std::string::npos) {
+            katalogi.emplace_back(std::stoi(nazwa.substr(4)), wpis.path().string());
+        }
+    }
+    std::sort(katalogi.begin(), katalogi.end());
+    for (const auto& katalog : katalogi) {
+        std::ifstream plik(katalog.second + "/cpulist");
+        std::string lista;
+        std::getline(plik, lista);
+        std::vector<ProcesorLogiczny> procesory;
+        for (int p : parsuj_liste_procesorow(lista)) {
+            if (p < CPU_SETSIZE && (!znana_maska || CPU_ISSET(p, &dozwolone))) procesory.push_back({ 0, static_cast<uint16_t>(p) });
+        }
+        if (!procesory.empty()) wezly_.push_back(std::move(procesory));  // Węzły tylko z pamięcią są pomijane
+    }
+    if (wezly_.empty() && znana_maska) {
+        std::vector<ProcesorLogiczny> procesory;
+        for (int p = 0; p < CPU_SETSIZE; ++p) {
+            if (CPU_ISSET(p, &dozwolone)) procesory.push_back({ 0, static_cast<uint16_t>(p) });
+        }
+        if (!procesory.empty()) wezly_.push_back(std::move(procesory));
+    }
+#endif
+    if (wezly_.empty()) {  // Brak informacji - jeden węzeł ze wszystkimi procesorami
+        const unsigned liczba = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+        std::vector<ProcesorLogiczny> procesory;
+        for (unsigned p = 0; p < liczba; ++p) procesory.push_back({ static_cast<uint16_t>(p / 64), static_cast<uint16_t>(p % 64) });
+        wezly_.push_back(std::move(procesory));
+    }
+    for (const auto& wezel : wezly_) wszystkie_.insert(wszystkie_.end(), wezel.begin(), wezel.end());
+}
+
+const TopologiaNUMA& TopologiaNUMA::systemowa() {
+    static const TopologiaNUMA topologia;
+    return topologia;
+}
+
+std::string TopologiaNUMA::opis() const {
+    std::string wynik = std::to_string(wezly_.size()) + (wezly_.size() == 1 ? " wezel" : " wezly") + " NUMA (";
+    for (size_t i = 0; i < wezly_.size(); ++i) {
+        if (i) wynik += " + ";
+        wynik += std::to_string(wezly_[i].size());
+    }
+    return wynik + " procesorow)";
+}
+
+// Rozmieszczenie wątków
+// =====================
+
+size_t TopologiaNUMA::wezel_watku(size_t watek, size_t liczba_watkow) const {
+    if (liczba_watkow == 0) return 0;
+    return watek * wezly_.size() / liczba_watkow;
+}
+
+bool TopologiaNUMA::przypnij_watek(size_t watek, size_t liczba_watkow) const {
+    const size_t wezel = wezel_watku(watek, liczba_watkow);
+    // Pierwszy wątek węzła - pierwszy procesor węzła; więcej wątków niż procesorów - od początku
+    size_t pierwszy = 0;
+    while (pierwszy < watek && wezel_watku(pierwszy, liczba_watkow) != wezel) ++pierwszy;
+    const ProcesorLogiczny& procesor = wezly_[wezel][(watek - pierwszy) % wezly_[wezel].size()];
+#ifdef _WIN32
+    GROUP_AFFINITY maska{};
+    maska.Group = procesor.grupa;
+    maska.Mask = static_cast<KAFFINITY>(1) << procesor.numer;
+    return SetThreadGroupAffinity(GetCurrentThread(), &maska, nullptr) != 0;
+#else
+    cpu_set_t maska;
+    CPU_ZERO(&maska);
+    CPU_SET(procesor.numer, &maska);
+    return sched_setaffinity(0, sizeof(maska), &maska) == 0;  // 0 - bieżący wątek
+#endif
+}
+
+void TopologiaNUMA::odepnij_watek() const {
+#ifdef _WIN32
+    DWORD_PTR procesu = 0, systemu = 0;
+    if (GetProcessAffinityMask(GetCurrentProcess(), &procesu, &systemu)) SetThreadAffinityMask(GetCurrentThread(), procesu);
+#else
+    cpu_set_t maska;
+    CPU_ZERO(&maska);
+    for (const auto& procesor : wszystkie_) CPU_SET(procesor.numer, &maska);
+    sched_setaffinity(0, sizeof(maska), &maska);
+#endif
+}
+
+// Pamięć stron
+// ============
+
+PamiecStron::PamiecStron(size_t rozmiar) {
+    if (rozmiar == 0) return;
+#ifdef _WIN32
+    void* adres = VirtualAlloc(nullptr, rozmiar, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!adres) return;
+#else
+    void* adres = mmap(nullptr, rozmiar, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (adres == MAP_FAILED) return;
+#endif
+    dane_ = static_cast<char*>(adres);
+    rozmiar_ = rozmiar;
+}
+
+PamiecStron::~PamiecStron() {
+    zwolnij();
+}
+
+PamiecStron::PamiecStron(PamiecStron&& inna) noexcept {
+    std::swap(dane_, inna.dane_);
+    std::swap(rozmiar_, inna.rozmiar_);
+}
+
+PamiecStron& PamiecStron::operator=(PamiecStron&& inna) noexcept {
+    if (this != &inna) {
+        zwolnij();
+        std::swap(dane_, inna.dane_);
+        std::swap(rozmiar_, inna.rozmiar_);
+    }
+    return *this;
+}
+
+void PamiecStron::zwolnij() {
+    if (!dane_) return;
+#ifdef _WIN32
+    VirtualFree(dane_, 0, MEM_RELEASE);
+#else
+    munmap(dane_, rozmiar_);
+#endif
+    dane_ = nullptr;
+    rozmiar_ = 0;
+}
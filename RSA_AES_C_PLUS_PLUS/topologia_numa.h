@@ -0,0 +1,75 @@
+#pragma once           // Dyrektywa kompilatora zapobiegająca wielokrotnemu dołączaniu
+#ifndef TOPOLOGIA_NUMA_H  // Tradycyjne zabezpieczenie przed podwójnym include
+#define TOPOLOGIA_NUMA_H
+
+#include <cstddef>  // Definicje standardowe (np. size_t)
+#include <cstdint>  // uint16_t - grupa i numer procesora
+#include <vector>   // Procesory węzłów
+#include <string>   // Opis topologii
+
+// Procesor logiczny - na Windows procesory są numerowane w grupach po najwyżej 64
+struct ProcesorLogiczny {
+    uint16_t grupa = 0;  // Grupa procesorów (Linux: zawsze 0)
+    uint16_t numer = 0;  // Numer w grupie (Linux: numer procesora)
+};
+
+/**
+ * Węzły NUMA systemu i rozmieszczenie na nich wątków roboczych
+ * @brief Wątek `w` z `n` trafia na węzeł w * liczba_wezlow / n, więc kolejne bloki wątków - a przez to
+ *        kolejne bloki fragmentów pliku (pula rozdziela zadania ciągłymi blokami) - leżą na kolejnych węzłach.
+ * @details Linux: /sys/devices/system/node/node<N>/cpulist, Windows: GetNumaNodeProcessorMaskEx.
+ *          Bez informacji o węzłach (lub na maszynie z jednym gniazdem) topologia ma jeden węzeł
+ *          ze wszystkimi procesorami - przypinanie nadal działa, rozmieszczenie stron niczego nie zmienia.
+ */
+class TopologiaNUMA {
+public:
+    static const TopologiaNUMA& systemowa();  // Wykrywana raz na proces
+
+    size_t liczba_wezlow() const { return wezly_.size(); }
+    const std::vector<ProcesorLogiczny>& procesory(size_t wezel) const { return wezly_[wezel]; }
+    size_t wezel_watku(size_t watek, size_t liczba_watkow) const;
+
+    /**
+     * Przypina bieżący wątek do procesora swojego węzła (kolejne wątki węzła - kolejne procesory)
+     * @return false, gdy system odmówił (np. procesor spoza dozwolonego zbioru procesu)
+     */
+    bool przypnij_watek(size_t watek, size_t liczba_watkow) const;
+    void odepnij_watek() const;  // Przywraca bieżącemu wątkowi wszystkie procesory procesu
+
+    std::string opis() const;  // Np. "2 wezly NUMA (16 + 16 procesorow)"
+
+private:
+    TopologiaNUMA();
+    std::vector<std::vector<ProcesorLogiczny>> wezly_;  // Procesory dozwolone dla procesu, według węzłów
+    std::vector<ProcesorLogiczny> wszystkie_;           // Do odepnij_watek()
+};
+
+/**
+ * Strony pamięci przydzielone bez dotykania (VirtualAlloc / mmap)
+ * @brief System przydziela fizyczną stronę dopiero przy pierwszym zapisie, na węźle NUMA wątku,
+ *        który ją zapisał - bufor wypełniany równolegle przez wątki robocze ma więc każdą część
+ *        w pamięci węzła wątku, który będzie ją skanował. std::string zeruje całość w wątku głównym,
+ *        przez co wszystkie strony lądują na jednym węźle.
+ */
+class PamiecStron {
+public:
+    PamiecStron() = default;
+    explicit PamiecStron(size_t rozmiar);
+    ~PamiecStron();
+
+    PamiecStron(const PamiecStron&) = delete;
+    PamiecStron& operator=(const PamiecStron&) = delete;
+    PamiecStron(PamiecStron&& inna) noexcept;
+    PamiecStron& operator=(PamiecStron&& inna) noexcept;
+
+    char* dane() const { return dane_; }
+    size_t rozmiar() const { return rozmiar_; }
+
+private:
+    void zwolnij();
+
+    char* dane_ = nullptr;
+    size_t rozmiar_ = 0;
+};
+
+#endif // TOPOLOGIA_NUMA_H
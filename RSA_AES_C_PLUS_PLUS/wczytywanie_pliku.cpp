@@ -0,0 +1,331 @@
+// Sekcja includów - dołączanie niezbędnych bibliotek
+#include "wczytywanie_pliku.h"  // Deklaracje klas wczytujących pliki
+#include <utility>              // std::swap
+#include <fstream>              // Odczyt strumieniowy (ifstream)
+#include <cstring>              // memcpy
+#include <filesystem>           // Przechodzenie katalogu korpusu
+
+#ifdef _WIN32
+#define NOMINMAX                // Wyłącz makra min/max z windows.h
+#include <windows.h>            // CreateFileMapping, MapViewOfFile, PrefetchVirtualMemory
+#else
+#include <fcntl.h>              // open
+#include <sys/mman.h>           // mmap, madvise
+#include <sys/stat.h>           // fstat
+#include <unistd.h>             // close, pread
+#include <cerrno>               // EINTR
+#endif
+
+// Implementacja mapowania pliku
+// =============================
+
+MapowanyPlik::MapowanyPlik(const std::string& sciezka, bool wstepne_wczytanie) {
+#ifdef _WIN32
+    // FILE_FLAG_SEQUENTIAL_SCAN to odpowiednik MADV_SEQUENTIAL dla menedżera pamięci podręcznej
+    HANDLE plik = CreateFileA(sciezka.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (plik == INVALID_HANDLE_VALUE) return;  // Błąd otwarcia pliku
+
+    LARGE_INTEGER rozmiar;
+    if (!GetFileSizeEx(plik, &rozmiar) || rozmiar.QuadPart == 0) {  // Pustego pliku nie da się zmapować
+        CloseHandle(plik);
+        return;
+    }
+
+    HANDLE mapowanie = CreateFileMappingA(plik, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapowanie) {
+        CloseHandle(plik);
+        return;
+    }
+
+    void* widok = MapViewOfFile(mapowanie, FILE_MAP_READ, 0, 0, 0);
+    if (!widok) {
+        CloseHandle(mapowanie);
+        CloseHandle(plik);
+        return;
+    }
+
+    uchwyt_pliku_ = plik;
+    uchwyt_mapowania_ = mapowanie;
+    dane_ = static_cast<const char*>(widok);
+    rozmiar_ = static_cast<size_t>(rozmiar.QuadPart);
+
+    if (wstepne_wczytanie) {
+        // Odpowiednik MAP_POPULATE/MADV_WILLNEED - asynchroniczne wczytanie stron do pamięci
+        WIN32_MEMORY_RANGE_ENTRY zakres{ widok, rozmiar_ };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &zakres, 0);
+    }
+#else
+    int fd = open(sciezka.c_str(), O_RDONLY);
+    if (fd < 0) return;  // Błąd otwarcia pliku
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {  // Pustego pliku nie da się zmapować
+        close(fd);
+        return;
+    }
+
+    int flagi = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (wstepne_wczytanie) flagi |= MAP_POPULATE;  // Wczytaj wszystkie strony już podczas mmap
+#endif
+    void* widok = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, flagi, fd, 0);
+    close(fd);  // Mapowanie pozostaje ważne po zamknięciu deskryptora
+    if (widok == MAP_FAILED) return;
+
+    dane_ = static_cast<const char*>(widok);
+    rozmiar_ = static_cast<size_t>(info.st_size);
+
+    // Wskazówki dla jądra: czytamy sekwencyjnie i całość będzie potrzebna (agresywny read-ahead)
+    madvise(widok, rozmiar_, MADV_SEQUENTIAL);
+    madvise(widok, rozmiar_, MADV_WILLNEED);
+#endif
+}
+
+MapowanyPlik::~MapowanyPlik() {
+    zamknij();
+}
+
+MapowanyPlik::MapowanyPlik(MapowanyPlik&& inny) noexcept {
+    *this = std::move(inny);
+}
+
+MapowanyPlik& MapowanyPlik::operator=(MapowanyPlik&& inny) noexcept {
+    if (this != &inny) {
+        zamknij();
+        std::swap(dane_, inny.dane_);
+        std::swap(rozmiar_, inny.rozmiar_);
+#ifdef _WIN32
+        std::swap(uchwyt_pliku_, inny.uchwyt_pliku_);
+        std::swap(uchwyt_mapowania_, inny.uchwyt_mapowania_);
+#endif
+    }
+    return *this;
+}
+
+void MapowanyPlik::zamknij() {
+    if (!dane_) return;
+#ifdef _WIN32
+    UnmapViewOfFile(dane_);
+    CloseHandle(uchwyt_mapowania_);
+    CloseHandle(uchwyt_pliku_);
+    uchwyt_mapowania_ = nullptr;
+    uchwyt_pliku_ = nullptr;
+#else
+    munmap(const_cast<char*>(dane_), rozmiar_);
+#endif
+    dane_ = nullptr;
+    rozmiar_ = 0;
+}
+
+// Implementacja strumieniowego wczytywania
+// ========================================
+
+StrumienFragmentow::StrumienFragmentow(const std::string& sciezka, size_t rozmiar_fragmentu, size_t nakladka, size_t liczba_buforow)
+    : rozmiar_fragmentu_(rozmiar_fragmentu), nakladka_(nakladka) {
+    if (liczba_buforow == 0) liczba_buforow = 1;
+    bufory_.resize(liczba_buforow);
+    zapelnienie_.resize(liczba_buforow, 0);
+    nakladki_.resize(liczba_buforow, 0);
+    ostatnie_.resize(liczba_buforow, 0);
+    for (size_t i = 0; i < liczba_buforow; ++i) {
+        bufory_[i].resize(nakladka_ + rozmiar_fragmentu_);  // Cała pamięć alokowana raz, z góry
+        wolne_.push_back(i);
+    }
+
+    std::ifstream test(sciezka, std::ios::binary);
+    otwarty_ = static_cast<bool>(test);
+    if (!otwarty_) {
+        koniec_ = true;  // Nic do czytania - pobierz() od razu zwróci false
+        return;
+    }
+    czytnik_ = std::thread(&StrumienFragmentow::czytaj, this, sciezka);
+}
+
+StrumienFragmentow::~StrumienFragmentow() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        zatrzymaj_ = true;
+    }
+    jest_wolny_.notify_all();
+    if (czytnik_.joinable()) czytnik_.join();
+}
+
+void StrumienFragmentow::czytaj(const std::string& sciezka) {
+    std::ifstream file(sciezka, std::ios::binary);
+    std::vector<char> przeniesienie;  // Końcówka poprzedniej porcji (maksymalnie nakladka_ bajtów)
+    przeniesienie.reserve(nakladka_);
+
+    while (true) {
+        // Czekaj na wolny bufor
+        size_t slot;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            jest_wolny_.wait(lock, [&] { return !wolne_.empty() || zatrzymaj_; });
+            if (zatrzymaj_) break;
+            slot = wolne_.front();
+            wolne_.pop_front();
+        }
+
+        // Nakładka z poprzedniej porcji + nowe dane z pliku
+        char* bufor = bufory_[slot].data();
+        memcpy(bufor, przeniesienie.data(), przeniesienie.size());
+        file.read(bufor + przeniesienie.size(), static_cast<std::streamsize>(rozmiar_fragmentu_));
+        size_t wczytano = static_cast<size_t>(file.gcount());
+        size_t rozmiar = przeniesienie.size() + wczytano;
+
+        if (wczytano == 0) {  // Koniec pliku - oddaj nieużyty bufor
+            std::lock_guard<std::mutex> lock(mutex_);
+            wolne_.push_back(slot);
+            break;
+        }
+
+        // Zapamiętaj końcówkę dla następnej porcji
+        size_t nowa_nakladka = (rozmiar < nakladka_) ? rozmiar : nakladka_;
+        przeniesienie.assign(bufor + rozmiar - nowa_nakladka, bufor + rozmiar);
+        const bool ostatni = wczytano < rozmiar_fragmentu_ || file.peek() == std::char_traits<char>::eof();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            zapelnienie_[slot] = rozmiar;
+            nakladki_[slot] = rozmiar - wczytano;
+            ostatnie_[slot] = ostatni ? 1 : 0;
+            wczytano_ += wczytano;
+            gotowe_.push_back(slot);
+        }
+        jest_gotowy_.notify_one();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        koniec_ = true;
+    }
+    jest_gotowy_.notify_all();
+}
+
+bool StrumienFragmentow::pobierz(std::string_view& fragment, size_t& slot) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    jest_gotowy_.wait(lock, [&] { return !gotowe_.empty() || koniec_; });
+    if (gotowe_.empty()) return false;  // Koniec pliku i wszystkie bufory rozdane
+
+    slot = gotowe_.front();
+    gotowe_.pop_front();
+    fragment = std::string_view(bufory_[slot].data(), zapelnienie_[slot]);
+    return true;
+}
+
+void StrumienFragmentow::zwolnij(size_t slot) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wolne_.push_back(slot);
+    }
+    jest_wolny_.notify_one();
+}
+
+size_t StrumienFragmentow::pamiec_buforow() const {
+    return bufory_.size() * (nakladka_ + rozmiar_fragmentu_);
+}
+
+size_t StrumienFragmentow::wczytano_bajtow() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return wczytano_;
+}
+
+// Katalog jako korpus
+// ===================
+
+std::vector<PlikKorpusu> wylistuj_katalog(const std::string& katalog) {
+    namespace fs = std::filesystem;
+    std::vector<PlikKorpusu> pliki;
+    std::error_code blad;
+    fs::recursive_directory_iterator it(katalog, fs::directory_options::skip_permission_denied, blad);
+    for (; !blad && it != fs::recursive_directory_iterator(); it.increment(blad)) {
+        std::error_code blad_pliku;
+        if (!it->is_regular_file(blad_pliku)) continue;
+        const uintmax_t rozmiar = it->file_size(blad_pliku);
+        if (blad_pliku || rozmiar == 0) continue;
+        pliki.push_back({ it->path().string(), static_cast<uint64_t>(rozmiar) });
+    }
+    return pliki;
+}
+
+std::string_view odczytaj_zakres(const std::string& sciezka, uint64_t od, size_t ile, std::vector<char>& bufor) {
+    std::ifstream plik(sciezka, std::ios::binary);
+    if (!plik) return {};
+    if (od > 0) plik.seekg(static_cast<std::streamoff>(od));
+    if (bufor.size() < ile) bufor.resize(ile);
+    plik.read(bufor.data(), static_cast<std::streamsize>(ile));
+    return std::string_view(bufor.data(), static_cast<size_t>(plik.gcount()));
+}
+
+// Odczyty pozycyjne
+// =================
+
+PlikPozycyjny::PlikPozycyjny(const std::string& sciezka) {
+#ifdef _WIN32
+    HANDLE plik = CreateFileA(sciezka.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, nullptr);
+    if (plik == INVALID_HANDLE_VALUE) return;
+    LARGE_INTEGER rozmiar;
+    if (!GetFileSizeEx(plik, &rozmiar)) {
+        CloseHandle(plik);
+        return;
+    }
+    uchwyt_ = plik;
+    rozmiar_ = static_cast<uint64_t>(rozmiar.QuadPart);
+#else
+    int fd = open(sciezka.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return;
+    }
+    deskryptor_ = fd;
+    rozmiar_ = static_cast<uint64_t>(info.st_size);
+#endif
+    otwarty_ = true;
+}
+
+PlikPozycyjny::~PlikPozycyjny() {
+#ifdef _WIN32
+    if (uchwyt_) CloseHandle(static_cast<HANDLE>(uchwyt_));
+#else
+    if (deskryptor_ >= 0) close(deskryptor_);
+#endif
+}
+
+std::string_view PlikPozycyjny::odczytaj(uint64_t od, size_t ile, std::vector<char>& bufor) const {
+    if (!otwarty_ || od >= rozmiar_) return {};
+    if (ile > rozmiar_ - od) ile = static_cast<size_t>(rozmiar_ - od);
+    if (bufor.size() < ile) bufor.resize(ile);  // Pierwsze dotknięcie stron bufora przez wątek, który go skanuje
+    return std::string_view(bufor.data(), odczytaj(od, bufor.data(), ile));
+}
+
+size_t PlikPozycyjny::odczytaj(uint64_t od, char* cel, size_t ile) const {
+    if (!otwarty_ || od >= rozmiar_) return 0;
+    if (ile > rozmiar_ - od) ile = static_cast<size_t>(rozmiar_ - od);
+
+    size_t wczytano = 0;
+    while (wczytano < ile) {  // Odczyt może zwrócić mniej bajtów niż żądano
+#ifdef _WIN32
+        const uint64_t pozycja = od + wczytano;
+        OVERLAPPED zadanie{};
+        zadanie.Offset = static_cast<DWORD>(pozycja);
+        zadanie.OffsetHigh = static_cast<DWORD>(pozycja >> 32);
+        zadanie.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);  // Własne zdarzenie - wiele odczytów na jednym uchwycie
+        DWORD bajty = 0;
+        BOOL ok = ReadFile(static_cast<HANDLE>(uchwyt_), cel + wczytano, static_cast<DWORD>(ile - wczytano), nullptr, &zadanie);
+        if (ok || GetLastError() == ERROR_IO_PENDING) ok = GetOverlappedResult(static_cast<HANDLE>(uchwyt_), &zadanie, &bajty, TRUE);
+        CloseHandle(zadanie.hEvent);
+        if (!ok || bajty == 0) break;
+        wczytano += bajty;
+#else
+        const ssize_t wynik = pread(deskryptor_, cel + wczytano, ile - wczytano, static_cast<off_t>(od + wczytano));
+        if (wynik < 0 && errno == EINTR) continue;
+        if (wynik <= 0) break;
+        wczytano += static_cast<size_t>(wynik);
+#endif
+    }
+    return wczytano;
+}
@@ -0,0 +1,169 @@
+#pragma once              // Dyrektywa kompilatora zapobiegająca wielokrotnemu dołączaniu
+#ifndef WCZYTYWANIE_PLIKU_H   // Tradycyjne zabezpieczenie przed podwójnym include
+#define WCZYTYWANIE_PLIKU_H
+
+#include <string>       // Biblioteka do obsługi ciągów znaków (std::string)
+#include <string_view>  // Lekka reprezentacja fragmentów stringów
+#include <cstddef>      // Definicje standardowe (np. size_t)
+#include <vector>       // Bufory pierścienia
+#include <deque>        // Kolejki numerów buforów
+#include <thread>       // Wątek czytający
+#include <mutex>        // Synchronizacja czytnika i wątków roboczych
+#include <condition_variable>  // Oczekiwanie na wolny / wypełniony bufor
+#include <cstdint>      // uint64_t - rozmiary plików katalogu
+
+/**
+ * Plik zmapowany w pamięci tylko do odczytu (mmap / MapViewOfFile)
+ * @brief Udostępnia zawartość pliku jako std::string_view bez kopiowania danych do bufora procesu.
+ *        Strony są wczytywane przez system na żądanie, więc skanowanie może ruszyć od razu.
+ * @note W razie błędu (brak pliku, plik pusty) dane() zwraca pusty widok - tak jak odczytaj_caly_plik zwraca "".
+ */
+class MapowanyPlik {
+public:
+    MapowanyPlik() = default;
+
+    /**
+     * Mapuje plik do pamięci
+     * @param sciezka Ścieżka do pliku
+     * @param wstepne_wczytanie true - wczytaj wszystkie strony od razu (MAP_POPULATE / PrefetchVirtualMemory)
+     */
+    explicit MapowanyPlik(const std::string& sciezka, bool wstepne_wczytanie = false);
+    ~MapowanyPlik();
+
+    // Mapowanie jest zasobem systemowym - tylko przenoszenie, bez kopiowania
+    MapowanyPlik(const MapowanyPlik&) = delete;
+    MapowanyPlik& operator=(const MapowanyPlik&) = delete;
+    MapowanyPlik(MapowanyPlik&& inny) noexcept;
+    MapowanyPlik& operator=(MapowanyPlik&& inny) noexcept;
+
+    std::string_view dane() const { return { dane_, rozmiar_ }; }  // Widok na całą zawartość pliku
+    bool otwarty() const { return dane_ != nullptr; }               // Czy mapowanie się powiodło
+
+private:
+    void zamknij();  // Zwalnia mapowanie (wywoływane przez destruktor i przeniesienie)
+
+    const char* dane_ = nullptr;  // Początek zmapowanego obszaru
+    size_t rozmiar_ = 0;          // Rozmiar pliku w bajtach
+#ifdef _WIN32
+    void* uchwyt_pliku_ = nullptr;      // HANDLE pliku
+    void* uchwyt_mapowania_ = nullptr;  // HANDLE obiektu mapowania
+#endif
+};
+
+/**
+ * Strumieniowe wczytywanie pliku przez pierścień buforów o stałym rozmiarze
+ * @brief Wątek czytający wypełnia wolne bufory kolejnymi porcjami pliku, a wątki robocze pobierają
+ *        wypełnione bufory, przetwarzają je i oddają do ponownego użycia. Zużycie pamięci wynosi
+ *        liczba_buforow * (rozmiar_fragmentu + nakladka) niezależnie od rozmiaru pliku.
+ * @details Na początek każdego bufora kopiowane jest ostatnie `nakladka` bajtów poprzedniej porcji,
+ *          więc dopasowanie przecinające granicę porcji znajduje się w całości w jednym buforze.
+ */
+class StrumienFragmentow {
+public:
+    /**
+     * Otwiera plik i uruchamia wątek czytający
+     * @param sciezka Ścieżka do pliku
+     * @param rozmiar_fragmentu Liczba nowych bajtów pliku w każdym buforze
+     * @param nakladka Liczba bajtów przenoszonych z końca poprzedniej porcji (zwykle długość wzorca - 1)
+     * @param liczba_buforow Liczba buforów w pierścieniu
+     */
+    StrumienFragmentow(const std::string& sciezka, size_t rozmiar_fragmentu, size_t nakladka, size_t liczba_buforow);
+    ~StrumienFragmentow();  // Zatrzymuje i dołącza wątek czytający
+
+    StrumienFragmentow(const StrumienFragmentow&) = delete;
+    StrumienFragmentow& operator=(const StrumienFragmentow&) = delete;
+
+    /**
+     * Pobiera kolejny wypełniony bufor (blokuje, dopóki czytnik go nie dostarczy)
+     * @param fragment[out] Widok na zawartość bufora
+     * @param slot[out] Numer bufora - należy go oddać przez zwolnij()
+     * @return false, gdy cały plik został już rozdany
+     */
+    bool pobierz(std::string_view& fragment, size_t& slot);
+    void zwolnij(size_t slot);  // Oddaje bufor czytnikowi
+    size_t nakladka(size_t slot) const { return nakladki_[slot]; }  // Liczba bajtów przeniesionych z poprzedniej porcji na początku bufora
+    bool koniec_pliku(size_t slot) const { return ostatnie_[slot] != 0; }  // Czy bufor kończy się na końcu pliku
+
+    bool otwarty() const { return otwarty_; }  // Czy udało się otworzyć plik
+    size_t pamiec_buforow() const;             // Łączny rozmiar pierścienia w bajtach
+    size_t wczytano_bajtow() const;            // Liczba bajtów pliku wczytanych do tej pory
+
+private:
+    void czytaj(const std::string& sciezka);  // Pętla wątku czytającego
+
+    size_t rozmiar_fragmentu_;
+    size_t nakladka_;
+    std::vector<std::vector<char>> bufory_;  // Pierścień buforów
+    std::vector<size_t> zapelnienie_;        // Liczba ważnych bajtów w każdym buforze
+    std::vector<size_t> nakladki_;           // Długość nakładki na początku każdego bufora
+    std::vector<char> ostatnie_;             // 1 - bufor zawiera ostatnią porcję pliku
+    std::deque<size_t> wolne_;               // Bufory gotowe do zapisu przez czytnik
+    std::deque<size_t> gotowe_;              // Bufory gotowe do przetworzenia
+    size_t wczytano_ = 0;                    // Licznik bajtów pliku (bez nakładek)
+    bool koniec_ = false;                    // Czytnik doszedł do końca pliku
+    bool zatrzymaj_ = false;                 // Żądanie przerwania czytania (destruktor)
+    bool otwarty_ = false;
+    mutable std::mutex mutex_;
+    std::condition_variable jest_wolny_;
+    std::condition_variable jest_gotowy_;
+    std::thread czytnik_;
+};
+
+// Plik znaleziony w katalogu korpusu
+struct PlikKorpusu {
+    std::string sciezka;
+    uint64_t rozmiar = 0;
+};
+
+/**
+ * Zwraca zwykłe pliki katalogu i wszystkich podkatalogów (std::filesystem)
+ * @details Katalogi bez uprawnień i pliki, których rozmiaru nie da się odczytać, są pomijane.
+ *          Puste pliki nie są zwracane - nie zawierają żadnego wystąpienia.
+ */
+std::vector<PlikKorpusu> wylistuj_katalog(const std::string& katalog);
+
+/**
+ * Wczytuje zakres pliku do bufora wielokrotnego użytku (bez alokacji, gdy bufor ma już pojemność)
+ * @param od Przesunięcie pierwszego bajtu
+ * @param ile Maksymalna liczba bajtów - przy końcu pliku wczytywane jest mniej
+ * @return Widok na wczytane bajty w buforze (pusty przy błędzie)
+ */
+std::string_view odczytaj_zakres(const std::string& sciezka, uint64_t od, size_t ile, std::vector<char>& bufor);
+
+/**
+ * Plik do odczytów pozycyjnych z wielu wątków naraz (pread / ReadFile z OVERLAPPED)
+ * @brief Odczyt nie zmienia wspólnej pozycji pliku, więc każdy wątek czyta swój zakres jednym
+ *        wywołaniem systemowym, bez blokady i bez osobnego otwierania pliku.
+ * @note Na Windows uchwyt jest otwierany z FILE_FLAG_OVERLAPPED - odczyty na uchwycie synchronicznym
+ *       system szereguje, co odebrałoby równoległość.
+ */
+class PlikPozycyjny {
+public:
+    explicit PlikPozycyjny(const std::string& sciezka);
+    ~PlikPozycyjny();
+
+    PlikPozycyjny(const PlikPozycyjny&) = delete;
+    PlikPozycyjny& operator=(const PlikPozycyjny&) = delete;
+
+    /**
+     * Wczytuje zakres pliku do bufora wątku (bufor rośnie tylko przy pierwszym użyciu)
+     * @param ile Maksymalna liczba bajtów - przy końcu pliku wczytywane jest mniej
+     * @return Widok na wczytane bajty w buforze (pusty przy błędzie)
+     */
+    std::string_view odczytaj(uint64_t od, size_t ile, std::vector<char>& bufor) const;
+    size_t odczytaj(uint64_t od, char* cel, size_t ile) const;  // Do gotowej pamięci; zwraca liczbę wczytanych bajtów
+
+    bool otwarty() const { return otwarty_; }
+    uint64_t rozmiar() const { return rozmiar_; }
+
+private:
+    uint64_t rozmiar_ = 0;
+    bool otwarty_ = false;
+#ifdef _WIN32
+    void* uchwyt_ = nullptr;  // HANDLE pliku
+#else
+    int deskryptor_ = -1;
+#endif
+};
+
+#endif // WCZYTYWANIE_PLIKU_H
@@ -0,0 +1,591 @@
+// Sekcja includów - dołączanie niezbędnych bibliotek
+#include "wiersz_polecen.h"        // Deklaracja trybu nieinteraktywnego
+#include "liczenie_slow.h"         // Wersje zliczania, OpcjeSkanowania i Metrics
+#include "rsa_aes.h"               // Seria szyfrowań z pomiarem
+#include "backendy_rownolegle.h"   // Modele wątków spoza trzech stałych wersji
+#include "silniki_wyszukiwania.h"  // Poziom SIMD i nazwa procesora do opisu środowiska
+#include "topologia_numa.h"        // Liczba węzłów NUMA do opisu środowiska
+#include <iostream>                // Wyniki na standardowe wyjście, błędy flag na std::cerr
+#include <fstream>                 // Wyniki do pliku (--wyjscie)
+#include <sstream>                 // Formatowanie liczb
+#include <iomanip>                 // std::setprecision
+#include <string>                  // Klasa string do obsługi napisów
+#include <vector>                  // Rekordy i pola
+#include <thread>                  // std::thread::hardware_concurrency
+#include <ctime>                   // Znacznik czasu pomiaru
+#include <cmath>                   // std::isfinite
+#include <cstdlib>                 // srand - powtarzalne teksty serii szyfrowań
+#include <cstdio>                  // std::snprintf - kody znaków sterujących w JSON
+#include <filesystem>              // Sprawdzenie --plik przed pomiarami
+
+// Parametry wywołania
+// ===================
+
+static const char* const POMOC =
+    "Uzycie: RSA_AES_C_PLUS_PLUS --tryb <tryb> [flagi]\n"
+    "  --tryb slowa|wiele|katalog|histogram|szyfrowanie\n"
+    "  --wersja <lista>      Wersje rozdzielone przecinkami (domyslnie wszystkie dostepne w trybie):\n"
+    "                        slowa: sekwencyjna, thread, openmp, korutyny, zadania-openmp, std-execution, arena\n"
+    "                        wiele: sekwencyjna, thread, openmp, korutyny; katalog: sekwencyjna, thread, openmp\n"
+    "                        histogram: thread, openmp\n"
+    "  --watki N             Liczba watkow (domyslnie liczba rdzeni)\n"
+    "  --slowa a,b,c         Szukane slowa (slowa, wiele, katalog)\n"
+    "  --plik <sciezka>      Plik (katalog w trybie katalog)\n"
+    "  --wczytywanie caly|mmap|strumien|async|pozycyjny\n"
+    "  --silnik auto|kmp|simd|horspool|bajt|regex\n"
+    "  --fragment BAJTY      Rozmiar czesci wlasciwej fragmentu\n"
+    "  --cale-slowa --bez-diakrytykow --filtr-ngramow --numa\n"
+    "  --najczestsze N       Histogram: liczba slow w wyniku (domyslnie 20)\n"
+    "  --algorytm aes|rsa    Szyfrowanie (domyslnie aes)\n"
+    "  --klucz BITY          AES 128/192/256 (domyslnie 256), RSA 512-4096 (domyslnie 2048)\n"
+    "  --teksty N            Szyfrowanie: teksty w serii (domyslnie 100)\n"
+    "  --min-dlugosc N --max-dlugosc N  Szyfrowanie: dlugosc losowych tekstow (domyslnie 16-64)\n"
+    "  --iteracje N          Powtorzenia kazdego pomiaru - rekord na powtorzenie (domyslnie 1)\n"
+    "  --format json|csv     (domyslnie json)\n"
+    "  --wyjscie <sciezka>   Plik wynikow (domyslnie standardowe wyjscie)\n";
+
+struct Parametry {
+    std::string tryb;                 // slowa, wiele, katalog, histogram, szyfrowanie
+    std::vector<std::string> wersje;  // Puste - wszystkie wersje trybu
+    int watki = 0;                    // 0 - liczba rdzeni
+    std::vector<std::string> slowa;
+    std::string plik;
+    OpcjeSkanowania opcje;
+    size_t najczestsze = 20;
+    std::string algorytm = "AES";
+    int klucz = 0;                    // 0 - domyślny dla algorytmu
+    int teksty = 100;
+    int min_dlugosc = 16;
+    int max_dlugosc = 64;
+    int iteracje = 1;
+    std::string format = "json";
+    std::string wyjscie;              // Puste - standardowe wyjście
+    bool pomoc = false;
+};
+
+// Dzieli listę rozdzieloną przecinkami, pomijając puste elementy
+static std::vector<std::string> podziel_liste(const std::string& lista) {
+    std::vector<std::string> wynik;
+    std::string element;
+    std::istringstream strumien(lista);
+    while (std::getline(strumien, element, ',')) {
+        if (!element.empty()) wynik.push_back(element);
+    }
+    return wynik;
+}
+
+// Liczba całkowita nie mniejsza niż minimum - false dla tekstu, który nie jest w całości liczbą
+static bool odczytaj_liczbe(const std::string& tekst, long long minimum, long long& wynik) {
+    try {
+        size_t koniec = 0;
+        wynik = std::stoll(tekst, &koniec);
+        return koniec == tekst.size() && wynik >= minimum;
+    }
+    catch (...) {
+        return false;
+    }
+}
+
+// Wersje dostępne w trybie - pierwsza lista flagi --wersja
+static const std::vector<std::string>& wersje_trybu(const std::string& tryb) {
+    static const std::vector<std::string> slowa = { "sekwencyjna", "thread", "openmp", "korutyny", "zadania-openmp", "std-execution", "arena" };
+    static const std::vector<std::string> wiele = { "sekwencyjna", "thread", "openmp", "korutyny" };
+    static const std::vector<std::string> trzy = { "sekwencyjna", "thread", "openmp" };
+    static const std::vector<std::string> histogram = { "thread", "openmp" };
+    static const std::vector<std::string> brak;
+    if (tryb == "slowa") return slowa;
+    if (tryb == "wiele") return wiele;
+    if (tryb == "katalog") return trzy;
+    if (tryb == "histogram") return histogram;
+    return brak;
+}
+
+// Ustawia jedną flagę z wartością; false i opis w blad dla nieznanej flagi lub niepoprawnej wartości
+static bool ustaw_flage(Parametry& p, const std::string& flaga, const std::string& wartosc, std::string& blad) {
+    long long liczba = 0;
+    if (flaga == "tryb") p.tryb = wartosc;
+    else if (flaga == "wersja") p.wersje = podziel_liste(wartosc);
+    else if (flaga == "watki") { if (!odczytaj_liczbe(wartosc, 1, liczba)) { blad = "--watki wymaga liczby >= 1"; return false; } p.watki = static_cast<int>(liczba); }
+    else if (flaga == "slowa") p.slowa = podziel_liste(wartosc);
+    else if (flaga == "plik") p.plik = wartosc;
+    else if (flaga == "wczytywanie") {
+        if (wartosc == "caly") p.opcje.wczytywanie = TrybWczytywania::CalyPlik;
+        else if (wartosc == "mmap") p.opcje.wczytywanie = TrybWczytywania::Mmap;
+        else if (wartosc == "strumien") p.opcje.wczytywanie = TrybWczytywania::Strumieniowy;
+        else if (wartosc == "async") p.opcje.wczytywanie = TrybWczytywania::Asynchroniczny;
+        else if (wartosc == "pozycyjny") p.opcje.wczytywanie = TrybWczytywania::Pozycyjny;
+        else { blad = "Nieznany tryb wczytywania: " + wartosc; return false; }
+    }
+    else if (flaga == "silnik") {
+        if (wartosc == "auto") p.opcje.silnik = SilnikWyszukiwania::Automatyczny;
+        else if (wartosc == "kmp") p.opcje.silnik = SilnikWyszukiwania::KMP;
+        else if (wartosc == "simd") p.opcje.silnik = SilnikWyszukiwania::SIMD;
+        else if (wartosc == "horspool") p.opcje.silnik = SilnikWyszukiwania::Horspool;
+        else if (wartosc == "bajt") p.opcje.silnik = SilnikWyszukiwania::Bajt;
+        else if (wartosc == "regex") p.opcje.silnik = SilnikWyszukiwania::Regex;
+        else { blad = "Nieznany silnik: " + wartosc; return false; }
+    }
+    else if (flaga == "fragment") { if (!odczytaj_liczbe(wartosc, 1, liczba)) { blad = "--fragment wymaga liczby >= 1"; return false; } p.opcje.rozmiar_fragmentu = static_cast<size_t>(liczba); }
+    else if (flaga == "najczestsze") { if (!odczytaj_liczbe(wartosc, 1, liczba)) { blad = "--najczestsze wymaga liczby >= 1"; return false; } p.najczestsze = static_cast<size_t>(liczba); }
+    else if (flaga == "algorytm") {
+        if (wartosc == "aes" || wartosc == "AES") p.algorytm = "AES";
+        else if (wartosc == "rsa" || wartosc == "RSA") p.algorytm = "RSA";
+        else { blad = "Nieznany algorytm: " + wartosc; return false; }
+    }
+    else if (flaga == "klucz") { if (!odczytaj_liczbe(wartosc, 1, liczba)) { blad = "--klucz wymaga liczby bitow"; return false; } p.klucz = static_cast<int>(liczba); }
+    else if (flaga == "teksty") { if (!odczytaj_liczbe(wartosc, 1, liczba)) { blad = "--teksty wymaga liczby >= 1"; return false; } p.teksty = static_cast<int>(liczba); }
+    else if (flaga == "min-dlugosc") { if (!odczytaj_liczbe(wartosc, 1, liczba)) { blad = "--min-dlugosc wymaga liczby >= 1"; return false; } p.min_dlugosc = static_cast<int>(liczba); }
+    else if (flaga == "max-dlugosc") { if (!odczytaj_liczbe(wartosc, 1, liczba)) { blad = "--max-dlugosc wymaga liczby >= 1"; return false; } p.max_dlugosc = static_cast<int>(liczba); }
+    else if (flaga == "iteracje") { if (!odczytaj_liczbe(wartosc, 1, liczba)) { blad = "--iteracje wymaga liczby >= 1"; return false; } p.iteracje = static_cast<int>(liczba); }
+    else if (flaga == "format") {
+        if (wartosc != "json" && wartosc != "csv") { blad = "Nieznany format: " + wartosc; return false; }
+        p.format = wartosc;
+    }
+    else if (flaga == "wyjscie") p.wyjscie = wartosc;
+    else { blad = "Nieznana flaga: --" + flaga; return false; }
+    return true;
+}
+
+// Odczytuje flagi (--flaga wartosc lub --flaga=wartosc) i sprawdza ich spójność
+static bool wczytaj_parametry(int argc, char* argv[], Parametry& p, std::string& blad) {
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument.rfind("--", 0) != 0) { blad = "Oczekiwano flagi, otrzymano: " + argument; return false; }
+        argument = argument.substr(2);
+
+        // Przełączniki bez wartości
+        if (argument == "pomoc") { p.pomoc = true; return true; }
+        if (argument == "cale-slowa") { p.opcje.cale_slowa = true; continue; }
+        if (argument == "bez-diakrytykow") { p.opcje.bez_diakrytykow = true; continue; }
+        if (argument == "filtr-ngramow") { p.opcje.filtr_ngramow = true; continue; }
+        if (argument == "numa") { p.opcje.numa = true; continue; }
+
+        std::string wartosc;
+        const size_t rownosc = argument.find('=');
+        if (rownosc != std::string::npos) {
+            wartosc = argument.substr(rownosc + 1);
+            argument.resize(rownosc);
+        }
+        else if (i + 1 < argc) {
+            wartosc = argv[++i];
+        }
+        else {
+            blad = "Brak wartosci flagi --" + argument;
+            return false;
+        }
+        if (!ustaw_flage(p, argument, wartosc, blad)) return false;
+    }
+
+    // Spójność parametrów
+    if (p.tryb != "szyfrowanie" && wersje_trybu(p.tryb).empty()) { blad = "Brak lub nieznany --tryb"; return false; }
+    for (const auto& wersja : p.wersje) {
+        bool znana = false;
+        for (const auto& dostepna : wersje_trybu(p.tryb)) znana = znana || wersja == dostepna;
+        if (!znana) { blad = "Wersja " + wersja + " nie jest dostepna w trybie " + p.tryb; return false; }
+    }
+    if (p.wersje.empty()) p.wersje = wersje_trybu(p.tryb);
+    if (p.watki == 0) p.watki = std::thread::hardware_concurrency() ? static_cast<int>(std::thread::hardware_concurrency()) : 1;
+    if (p.tryb == "szyfrowanie") {
+        if (p.klucz == 0) p.klucz = p.algorytm == "RSA" ? 2048 : 256;
+        if (!poprawny_klucz(p.algorytm, p.klucz)) { blad = "Nieprawidlowy rozmiar klucza " + p.algorytm + ": " + std::to_string(p.klucz); return false; }
+        if (p.max_dlugosc < p.min_dlugosc) { blad = "--max-dlugosc mniejsza niz --min-dlugosc"; return false; }
+        return true;
+    }
+    if (p.plik.empty()) { blad = "Brak --plik"; return false; }
+
+    // Brak pliku nie może dać po cichu wyniku 0 - wersje zliczania traktują go jak pusty korpus
+    std::error_code blad_pliku;
+    if (p.tryb == "katalog") {
+        if (!std::filesystem::is_directory(p.plik, blad_pliku)) { blad = "--plik nie jest katalogiem: " + p.plik; return false; }
+    }
+    else if (!std::filesystem::is_regular_file(p.plik, blad_pliku) || !std::ifstream(p.plik, std::ios::binary)) {
+        blad = "Nie mozna odczytac pliku: " + p.plik;
+        return false;
+    }
+    if (p.slowa.empty() && p.tryb != "histogram") { blad = "Brak --slowa"; return false; }
+    return true;
+}
+
+// Pomiary
+// =======
+
+// Jeden pomiar: parametry, od których zależy wynik, i wszystkie metryki
+struct Rekord {
+    std::string tryb;
+    std::string wersja;     // Wersja zliczania (puste przy szyfrowaniu)
+    std::string slowo;      // Tryb wiele - słowa rozdzielone przecinkami
+    std::string plik;
+    int liczba_watkow = 1;
+    int iteracja = 0;
+    std::string algorytm;   // Tylko szyfrowanie
+    int klucz = 0;          // Tylko szyfrowanie
+    Metrics wynik{};
+};
+
+// Wykonuje jedną wersję zliczania w trybie z parametrów (wersja sprawdzona w wczytaj_parametry)
+static Metrics zmierz_wersje(const Parametry& p, const std::string& wersja, const std::string& slowo) {
+    const int n = p.watki;
+    if (p.tryb == "wiele") {
+        if (wersja == "sekwencyjna") return liczba_wielu_slow_sekwencyjny(p.plik, p.slowa, p.opcje);
+        if (wersja == "thread") return liczba_wielu_slow_Thread(p.plik, p.slowa, n, p.opcje);
+        if (wersja == "korutyny") return liczba_wielu_slow_korutyny(p.plik, p.slowa, n, p.opcje);
+        return liczba_wielu_slow_OpenMP(p.plik, p.slowa, n, p.opcje);
+    }
+    if (p.tryb == "katalog") {
+        if (wersja == "sekwencyjna") return liczba_slow_katalog_sekwencyjny(p.plik, slowo, p.opcje);
+        if (wersja == "thread") return liczba_slow_katalog_Thread(p.plik, slowo, n, p.opcje);
+        return liczba_slow_katalog_OpenMP(p.plik, slowo, n, p.opcje);
+    }
+    if (p.tryb == "histogram") {
+        if (wersja == "thread") return histogram_slow_Thread(p.plik, p.najczestsze, n, p.opcje);
+        return histogram_slow_OpenMP(p.plik, p.najczestsze, n, p.opcje);
+    }
+    if (wersja == "sekwencyjna") return liczba_slow_sekwencyjny(p.plik, slowo, p.opcje);
+    if (wersja == "thread") return liczba_slow_Thread(p.plik, slowo, n, p.opcje);
+    if (wersja == "openmp") return liczba_slow_OpenMP(p.plik, slowo, n, p.opcje);
+    if (wersja == "korutyny") return liczba_slow_korutyny(p.plik, slowo, n, p.opcje);
+    const RodzajBackendu rodzaj = wersja == "zadania-openmp" ? RodzajBackendu::OpenMPZadania
+        : wersja == "std-execution" ? RodzajBackendu::StdExecution : RodzajBackendu::ArenaZadan;
+    auto backend = utworz_backend(rodzaj, n);
+    return liczba_slow_backend(p.plik, slowo, *backend, p.opcje);
+}
+
+// Wszystkie pomiary wywołania: wersja x słowo x iteracja albo seria szyfrowań x iteracja
+static std::vector<Rekord> wykonaj_pomiary(const Parametry& p) {
+    std::vector<Rekord> rekordy;
+    if (p.tryb == "szyfrowanie") {
+        srand(1);  // Te same teksty w każdym uruchomieniu - porównywalne wyniki nocnych przebiegów
+        for (int iteracja = 0; iteracja < p.iteracje; ++iteracja) {
+            std::vector<std::string> teksty;
+            for (int i = 0; i < p.teksty; ++i) teksty.push_back(generateRandomText(p.min_dlugosc, p.max_dlugosc));
+            Rekord rekord;
+            rekord.tryb = p.tryb;
+            rekord.iteracja = iteracja;
+            rekord.algorytm = p.algorytm;
+            rekord.klucz = p.klucz;
+            rekord.wynik = seria_szyfrowan(p.algorytm, p.klucz, teksty);
+            rekordy.push_back(std::move(rekord));
+        }
+        return rekordy;
+    }
+
+    // Tryb wiele liczy wszystkie słowa naraz, histogram - wszystkie słowa pliku
+    std::vector<std::string> slowa = p.slowa;
+    if (p.tryb == "wiele") {
+        std::string razem;
+        for (const auto& slowo : p.slowa) razem += (razem.empty() ? "" : ",") + slowo;
+        slowa = { razem };
+    }
+    else if (p.tryb == "histogram") {
+        slowa = { "" };
+    }
+
+    for (const auto& wersja : p.wersje) {
+        for (const auto& slowo : slowa) {
+            for (int iteracja = 0; iteracja < p.iteracje; ++iteracja) {
+                Rekord rekord;
+                rekord.tryb = p.tryb;
+                rekord.wersja = wersja;
+                rekord.slowo = slowo;
+                rekord.plik = p.plik;
+                rekord.liczba_watkow = wersja == "sekwencyjna" ? 1 : p.watki;
+                rekord.iteracja = iteracja;
+                rekord.wynik = zmierz_wersje(p, wersja, slowo);
+                rekordy.push_back(std::move(rekord));
+            }
+        }
+    }
+    return rekordy;
+}
+
+// Środowisko pomiaru
+// ==================
+
+// Kompilator i jego wersja
+static std::string opis_kompilatora() {
+    std::ostringstream opis;
+#if defined(__clang__)
+    opis << "Clang " << __clang_version__;
+#elif defined(_MSC_VER)
+    opis << "MSVC " << _MSC_FULL_VER;
+#elif defined(__GNUC__)
+    opis << "GCC " << __VERSION__;
+#else
+    opis << "nieznany";
+#endif
+    return opis.str();
+}
+
+// Flagi kompilacji widoczne w kodzie - makra ustawiane przez opcje kompilatora (pełnej linii poleceń program nie zna)
+static std::string flagi_kompilacji() {
+    std::string flagi;
+    auto dodaj = [&](const std::string& flaga) { flagi += (flagi.empty() ? "" : " ") + flaga; };
+#ifdef _MSVC_LANG
+    dodaj("C++" + std::to_string(_MSVC_LANG));
+#else
+    dodaj("C++" + std::to_string(__cplusplus));
+#endif
+#ifdef _OPENMP
+    dodaj("OpenMP" + std::to_string(_OPENMP));
+#endif
+#ifdef NDEBUG
+    dodaj("NDEBUG");
+#endif
+#ifdef _DEBUG
+    dodaj("_DEBUG");
+#endif
+#ifdef __OPTIMIZE__
+    dodaj("__OPTIMIZE__");
+#endif
+#if defined(__AVX512F__)
+    dodaj("AVX512");
+#elif defined(__AVX2__)
+    dodaj("AVX2");
+#elif defined(__AVX__)
+    dodaj("AVX");
+#endif
+#if defined(_M_X64) || defined(__x86_64__)
+    dodaj("x64");
+#elif defined(_M_ARM64) || defined(__aarch64__)
+    dodaj("ARM64");
+#elif defined(_M_IX86) || defined(__i386__)
+    dodaj("x86");
+#endif
+#ifdef CZYTNIK_IO_URING
+    dodaj("CZYTNIK_IO_URING");
+#endif
+    return flagi;
+}
+
+// Nazwa systemu operacyjnego, dla którego zbudowano program
+static const char* nazwa_systemu() {
+#if defined(_WIN32)
+    return "Windows";
+#elif defined(__linux__)
+    return "Linux";
+#elif defined(__APPLE__)
+    return "macOS";
+#else
+    return "nieznany";
+#endif
+}
+
+// Bieżący czas UTC w formacie ISO 8601
+static std::string znacznik_czasu() {
+    const std::time_t teraz = std::time(nullptr);
+    std::tm czas{};
+#ifdef _WIN32
+    gmtime_s(&czas, &teraz);
+#else
+    gmtime_r(&teraz, &czas);
+#endif
+    char tekst[32];
+    std::strftime(tekst, sizeof(tekst), "%Y-%m-%dT%H:%M:%SZ", &czas);
+    return tekst;
+}
+
+// Zapis wyników
+// =============
+
+// Pole rekordu w obu formatach: wartość JSON (z cudzysłowami i zagnieżdżeniem) i treść komórki CSV
+// Listy w CSV: elementy rozdzielone ';', pola elementu - '|' (np. watki: zadania|kradzieze|bezczynnosc|praca|wezel|kradzieze_zdalne)
+struct Pole {
+    std::string nazwa;
+    std::string json;
+    std::string csv;
+};
+
+// Napis JSON - znaki sterujące jako \u00XX, bajty UTF-8 bez zmian
+static std::string napis_json(const std::string& tekst) {
+    std::string wynik = "\"";
+    for (unsigned char znak : tekst) {
+        if (znak == '"' || znak == '\\') { wynik += '\\'; wynik += static_cast<char>(znak); }
+        else if (znak < 0x20) {
+            char kod[8];
+            std::snprintf(kod, sizeof(kod), "\\u%04x", znak);
+            wynik += kod;
+        }
+        else wynik += static_cast<char>(znak);
+    }
+    return wynik + "\"";
+}
+
+// Liczba zmiennoprzecinkowa - nieskończoność i NaN (np. czas 0) jako null / pusta komórka
+static std::string liczba_tekst(double wartosc) {
+    if (!std::isfinite(wartosc)) return "";
+    std::ostringstream tekst;
+    tekst << std::setprecision(12) << wartosc;
+    return tekst.str();
+}
+
+static Pole pole_tekst(const char* nazwa, const std::string& wartosc) { return { nazwa, napis_json(wartosc), wartosc }; }
+static Pole pole_calkowite(const char* nazwa, uint64_t wartosc) { return { nazwa, std::to_string(wartosc), std::to_string(wartosc) }; }
+static Pole pole_liczba(const char* nazwa, double wartosc) {
+    const std::string tekst = liczba_tekst(wartosc);
+    return { nazwa, tekst.empty() ? "null" : tekst, tekst };
+}
+
+// Lista obiektów: element(x) daje pola obiektu, z których budowany jest obiekt JSON i element CSV
+template <typename T, typename F>
+static Pole pole_lista(const char* nazwa, const std::vector<T>& elementy, F element) {
+    Pole pole{ nazwa, "[", "" };
+    for (size_t i = 0; i < elementy.size(); ++i) {
+        const std::vector<Pole> pola = element(elementy[i]);
+        pole.json += i ? ",{" : "{";
+        if (i) pole.csv += ';';
+        for (size_t j = 0; j < pola.size(); ++j) {
+            pole.json += (j ? "," : "") + napis_json(pola[j].nazwa) + ":" + pola[j].json;
+            pole.csv += (j ? "|" : "") + pola[j].csv;
+        }
+        pole.json += "}";
+    }
+    pole.json += "]";
+    return pole;
+}
+
+static std::vector<Pole> pola_srodowiska() {
+    return {
+        pole_tekst("procesor", nazwa_procesora()),
+        pole_calkowite("rdzenie", std::thread::hardware_concurrency()),
+        pole_calkowite("wezly_numa", TopologiaNUMA::systemowa().liczba_wezlow()),
+        pole_tekst("simd", nazwa_simd(wykryj_simd())),
+        pole_tekst("system", nazwa_systemu()),
+        pole_tekst("kompilator", opis_kompilatora()),
+        pole_tekst("flagi_kompilacji", flagi_kompilacji()),
+        pole_tekst("czas_pomiaru", znacznik_czasu()),
+    };
+}
+
+static std::vector<Pole> pola_rekordu(const Rekord& r) {
+    const Metrics& m = r.wynik;
+    std::vector<Pole> pola = {
+        pole_tekst("tryb", r.tryb),
+        pole_tekst("wersja", r.wersja),
+        pole_tekst("slowo", r.slowo),
+        pole_tekst("plik", r.plik),
+        pole_calkowite("liczba_watkow", r.liczba_watkow),
+        pole_calkowite("iteracja", r.iteracja),
+        pole_tekst("algorytm", r.algorytm),
+        pole_calkowite("klucz", r.klucz),
+        pole_calkowite("count", m.count),
+        pole_liczba("czas", m.czas),
+        pole_liczba("cpu_usage", m.cpu_usage),
+        pole_calkowite("ram_usage", m.ram_usage),
+        pole_calkowite("bajty", m.bajty),
+        pole_calkowite("cykle", m.cykle),
+        pole_liczba("cpu_uzytkownika", m.cpu_uzytkownika),
+        pole_liczba("cpu_systemu", m.cpu_systemu),
+        pole_liczba("cpu_watku", m.cpu_watku),
+        pole_calkowite("szczyt_pamieci", m.szczyt_pamieci),
+        pole_calkowite("przelaczenia_dobrowolne", m.przelaczenia_dobrowolne),
+        pole_calkowite("przelaczenia_wymuszone", m.przelaczenia_wymuszone),
+        pole_calkowite("bledy_stron", m.bledy_stron),
+        pole_calkowite("bledy_stron_dysku", m.bledy_stron_dysku),
+    };
+    Pole liczniki{ "liczniki_slow", "[", "" };
+    for (size_t i = 0; i < m.liczniki_slow.size(); ++i) {
+        liczniki.json += (i ? "," : "") + std::to_string(m.liczniki_slow[i]);
+        liczniki.csv += (i ? ";" : "") + std::to_string(m.liczniki_slow[i]);
+    }
+    liczniki.json += "]";
+    pola.push_back(liczniki);
+    pola.push_back(pole_tekst("silnik", m.silnik));
+    pola.push_back(pole_liczba("czas_wczytywania", m.czas_wczytywania));
+    pola.push_back(pole_lista("watki", m.watki, [](const StatystykiWatku& w) {
+        return std::vector<Pole>{ pole_calkowite("zadania", w.zadania), pole_calkowite("kradzieze", w.kradzieze),
+            pole_liczba("bezczynnosc", w.bezczynnosc), pole_liczba("praca", w.praca), pole_calkowite("wezel", w.wezel),
+            pole_calkowite("kradzieze_zdalne", w.kradzieze_zdalne) };
+        }));
+    pola.push_back(pole_tekst("backend", m.backend));
+    pola.push_back(pole_lista("najczestsze", m.najczestsze, [](const CzestoscSlowa& c) {
+        return std::vector<Pole>{ pole_tekst("slowo", c.slowo), pole_calkowite("liczba", c.liczba) };
+        }));
+    pola.push_back(pole_calkowite("pominiete_fragmenty", m.pominiete_fragmenty));
+    pola.push_back(pole_calkowite("liczba_fragmentow", m.liczba_fragmentow));
+    pola.push_back(pole_lista("pliki", m.pliki, [](const WynikPliku& w) {
+        return std::vector<Pole>{ pole_tekst("sciezka", w.sciezka), pole_calkowite("rozmiar", w.rozmiar), pole_calkowite("liczba", w.liczba) };
+        }));
+    pola.push_back(pole_tekst("odczyt", m.odczyt));
+    pola.push_back(pole_calkowite("bajty_urzadzenia", m.bajty_urzadzenia));
+    pola.push_back(pole_liczba("czas_odczytu", m.czas_odczytu));
+    pola.push_back(pole_liczba("czas_skanowania", m.czas_skanowania));
+    pola.push_back(pole_lista("wezly", m.wezly, [](const StatystykiWezla& w) {
+        return std::vector<Pole>{ pole_calkowite("watki", w.watki), pole_calkowite("bajty", w.bajty), pole_liczba("praca", w.praca),
+            pole_calkowite("kradzieze_zdalne", w.kradzieze_zdalne) };
+        }));
+    pola.push_back(pole_calkowite("pozycje_bajty", m.pozycje.size()));  // Strumień varint jest binarny - tylko jego rozmiar
+    return pola;
+}
+
+// Jeden dokument: {"srodowisko": {...}, "rekordy": [{...}, ...]}
+static void zapisz_json(std::ostream& wyjscie, const std::vector<Rekord>& rekordy) {
+    wyjscie << "{\n  \"srodowisko\": {";
+    const auto srodowisko = pola_srodowiska();
+    for (size_t i = 0; i < srodowisko.size(); ++i) wyjscie << (i ? ", " : "") << napis_json(srodowisko[i].nazwa) << ": " << srodowisko[i].json;
+    wyjscie << "},\n  \"rekordy\": [";
+    for (size_t r = 0; r < rekordy.size(); ++r) {
+        wyjscie << (r ? ",\n    {" : "\n    {");
+        const auto pola = pola_rekordu(rekordy[r]);
+        for (size_t i = 0; i < pola.size(); ++i) wyjscie << (i ? ", " : "") << napis_json(pola[i].nazwa) << ": " << pola[i].json;
+        wyjscie << "}";
+    }
+    wyjscie << (rekordy.empty() ? "]\n}\n" : "\n  ]\n}\n");
+}
+
+// Komórka CSV - w cudzysłowie, gdy zawiera separator, cudzysłów lub koniec wiersza
+static std::string komorka_csv(const std::string& tekst) {
+    if (tekst.find_first_of(",\"\r\n") == std::string::npos) return tekst;
+    std::string wynik = "\"";
+    for (char znak : tekst) wynik += znak == '"' ? std::string("\"\"") : std::string(1, znak);
+    return wynik + "\"";
+}
+
+// Nagłówek i wiersz na rekord; kolumny środowiska powtarzane w każdym wierszu (wiersze można łączyć z wielu przebiegów)
+static void zapisz_csv(std::ostream& wyjscie, const std::vector<Rekord>& rekordy) {
+    const auto srodowisko = pola_srodowiska();
+    std::vector<Pole> naglowek = srodowisko;
+    const auto pola_wzorcowe = pola_rekordu(Rekord{});
+    naglowek.insert(naglowek.end(), pola_wzorcowe.begin(), pola_wzorcowe.end());
+    for (size_t i = 0; i < naglowek.size(); ++i) wyjscie << (i ? "," : "") << komorka_csv(naglowek[i].nazwa);
+    wyjscie << "\n";
+    for (const auto& rekord : rekordy) {
+        std::vector<Pole> wiersz = srodowisko;
+        const auto pola = pola_rekordu(rekord);
+        wiersz.insert(wiersz.end(), pola.begin(), pola.end());
+        for (size_t i = 0; i < wiersz.size(); ++i) wyjscie << (i ? "," : "") << komorka_csv(wiersz[i].csv);
+        wyjscie << "\n";
+    }
+}
+
+// Tryb nieinteraktywny
+// ====================
+
+int uruchom_wiersz_polecen(int argc, char* argv[]) {
+    Parametry parametry;
+    std::string blad;
+    if (!wczytaj_parametry(argc, argv, parametry, blad)) {
+        std::cerr << blad << "\n\n" << POMOC;
+        return 2;
+    }
+    if (parametry.pomoc) {
+        std::cout << POMOC;
+        return 0;
+    }
+
+    // Plik wyników otwierany przed pomiarami - zła ścieżka nie marnuje całej serii
+    std::ofstream plik;
+    if (!parametry.wyjscie.empty()) {
+        plik.open(parametry.wyjscie, std::ios::binary | std::ios::trunc);
+        if (!plik) {
+            std::cerr << "Nie mozna otworzyc pliku wynikow: " << parametry.wyjscie << "\n";
+            return 1;
+        }
+    }
+    std::ostream& wyjscie = parametry.wyjscie.empty() ? std::cout : plik;
+
+    const std::vector<Rekord> rekordy = wykonaj_pomiary(parametry);
+    if (parametry.format == "csv") zapisz_csv(wyjscie, rekordy);
+    else zapisz_json(wyjscie, rekordy);
+    wyjscie.flush();
+    return wyjscie ? 0 : 1;
+}
@@ -0,0 +1,15 @@
+#pragma once              // Dyrektywa kompilatora zapobiegająca wielokrotnemu dołączaniu
+#ifndef WIERSZ_POLECEN_H  // Tradycyjne zabezpieczenie przed podwójnym include
+#define WIERSZ_POLECEN_H
+
+/**
+ * Tryb nieinteraktywny - wszystkie parametry z flag, wyniki jako rekordy JSON lub CSV
+ * @brief Każdy pomiar (wersja x słowo x iteracja, albo seria szyfrowań) daje jeden rekord ze wszystkimi
+ *        polami Metrics i parametrami wywołania; do każdego wyniku dołączany jest opis środowiska
+ *        (procesor, rdzenie, kompilator i flagi kompilacji). Menu w main() jest nakładką na te same funkcje.
+ *        Pełna lista flag: --pomoc.
+ * @return Kod wyjścia procesu: 0 - sukces, 1 - błąd wykonania (np. zapis wyników), 2 - błędne flagi
+ */
+int uruchom_wiersz_polecen(int argc, char* argv[]);
+
+#endif // WIERSZ_POLECEN_H
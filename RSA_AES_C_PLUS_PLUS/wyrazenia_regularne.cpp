@@ -0,0 +1,648 @@
+// Sekcja includów - dołączanie niezbędnych bibliotek
+#include "wyrazenia_regularne.h"  // Deklaracja wyrażenia
+#include <algorithm>              // std::sort, std::min, std::max, std::reverse
+#include <atomic>                 // Licznik identyfikatorów wyrażeń
+#include <unordered_map>          // Słownik zbiorów stanów NFA -> stan DFA
+#include <sstream>                // Składanie opisu
+
+// Drzewo składni
+// ==============
+
+namespace {
+
+using ZbiorBajtow = std::array<uint64_t, 4>;
+
+// Węzeł drzewa składni wyrażenia
+struct Wezel {
+    enum class Typ { Zbior, Sekwencja, Alternatywa, Powtorzenie } typ = Typ::Sekwencja;
+    ZbiorBajtow zbior{};         // Zbior: dopasowywane bajty
+    std::vector<Wezel> dzieci;   // Sekwencja / Alternatywa: elementy; Powtorzenie: jeden element
+    size_t min = 1, max = 1;     // Powtorzenie: zakres liczby powtórzeń
+};
+
+void dodaj_bajt(ZbiorBajtow& zbior, unsigned char bajt) {
+    zbior[bajt >> 6] |= 1ull << (bajt & 63);
+}
+
+bool zawiera(const ZbiorBajtow& zbior, unsigned char bajt) {
+    return (zbior[bajt >> 6] >> (bajt & 63)) & 1;
+}
+
+void dodaj_zakres(ZbiorBajtow& zbior, unsigned char od, unsigned char doo) {
+    for (unsigned b = od; b <= doo; ++b) dodaj_bajt(zbior, static_cast<unsigned char>(b));
+}
+
+void odwroc(ZbiorBajtow& zbior) {
+    for (auto& slowo : zbior) slowo = ~slowo;
+}
+
+int liczba_bajtow(const ZbiorBajtow& zbior) {
+    int wynik = 0;
+    for (int b = 0; b < 256; ++b) wynik += zawiera(zbior, static_cast<unsigned char>(b));
+    return wynik;
+}
+
+// Parser rekurencyjny: alternatywa := sekwencja ('|' sekwencja)*, sekwencja := (atom kwantyfikator?)*
+class Parser {
+public:
+    explicit Parser(std::string_view wzorzec) : w_(wzorzec) {}
+
+    bool parsuj(Wezel& wynik, std::string& blad) {
+        wynik = alternatywa();
+        if (blad_.empty() && poz_ < w_.size()) ustaw_blad("nieoczekiwany znak ')'");
+        blad = blad_;
+        return blad_.empty();
+    }
+
+private:
+    void ustaw_blad(const std::string& tresc) {
+        if (blad_.empty()) blad_ = tresc + " (pozycja " + std::to_string(poz_) + ")";
+    }
+
+    bool koniec() const { return poz_ >= w_.size() || !blad_.empty(); }
+
+    Wezel alternatywa() {
+        Wezel wynik;
+        wynik.typ = Wezel::Typ::Alternatywa;
+        wynik.dzieci.push_back(sekwencja());
+        while (!koniec() && w_[poz_] == '|') {
+            ++poz_;
+            wynik.dzieci.push_back(sekwencja());
+        }
+        if (wynik.dzieci.size() == 1) return std::move(wynik.dzieci[0]);
+        return wynik;
+    }
+
+    Wezel sekwencja() {
+        Wezel wynik;
+        while (!koniec() && w_[poz_] != '|' && w_[poz_] != ')') {
+            Wezel element = atom();
+            kwantyfikator(element);
+            wynik.dzieci.push_back(std::move(element));
+        }
+        return wynik;
+    }
+
+    Wezel atom() {
+        Wezel wynik;
+        wynik.typ = Wezel::Typ::Zbior;
+        const char c = w_[poz_++];
+        switch (c) {
+        case '(':
+            wynik = alternatywa();
+            if (koniec() || w_[poz_] != ')') ustaw_blad("brak ')'");
+            else ++poz_;
+            return wynik;
+        case '[':
+            klasa(wynik.zbior);
+            return wynik;
+        case '.':
+            dodaj_zakres(wynik.zbior, 0, 255);
+            wynik.zbior[0] &= ~(1ull << '\n');  // Jak w grep - kropka nie przechodzi do następnego wiersza
+            return wynik;
+        case '\\':
+            sekwencja_ucieczki(wynik.zbior);
+            return wynik;
+        case '*': case '+': case '?': case '{':
+            --poz_;
+            ustaw_blad(std::string("kwantyfikator '") + c + "' bez elementu");
+            ++poz_;
+            return wynik;
+        default:
+            dodaj_bajt(wynik.zbior, static_cast<unsigned char>(c));
+            return wynik;
+        }
+    }
+
+    // Odczytuje sekwencję po ukośniku (\d, \n, \xHH, \.) i dodaje jej bajty do zbioru
+    void sekwencja_ucieczki(ZbiorBajtow& zbior) {
+        if (poz_ >= w_.size()) {
+            ustaw_blad("ukosnik na koncu wzorca");
+            return;
+        }
+        const char c = w_[poz_++];
+        ZbiorBajtow klasa{};
+        switch (c) {
+        case 'd': case 'D':
+            dodaj_zakres(klasa, '0', '9');
+            break;
+        case 'w': case 'W':
+            dodaj_zakres(klasa, '0', '9');
+            dodaj_zakres(klasa, 'a', 'z');
+            dodaj_zakres(klasa, 'A', 'Z');
+            dodaj_bajt(klasa, '_');
+            break;
+        case 's': case 'S':
+            for (char b : std::string_view(" \t\n\r\f\v")) dodaj_bajt(klasa, static_cast<unsigned char>(b));
+            break;
+        case 'n': dodaj_bajt(zbior, '\n'); return;
+        case 't': dodaj_bajt(zbior, '\t'); return;
+        case 'r': dodaj_bajt(zbior, '\r'); return;
+        case 'x': {
+            unsigned wartosc = 0;
+            for (int i = 0; i < 2; ++i) {
+                const char h = poz_ < w_.size() ? w_[poz_] : '\0';
+                const int cyfra = (h >= '0' && h <= '9') ? h - '0' : (h >= 'a' && h <= 'f') ? h - 'a' + 10 : (h >= 'A' && h <= 'F') ? h - 'A' + 10 : -1;
+                if (cyfra < 0) {
+                    ustaw_blad("\\x wymaga dwoch cyfr szesnastkowych");
+                    return;
+                }
+                wartosc = wartosc * 16 + static_cast<unsigned>(cyfra);
+                ++poz_;
+            }
+            dodaj_bajt(zbior, static_cast<unsigned char>(wartosc));
+            return;
+        }
+        default:
+            if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+                ustaw_blad(std::string("nieznana sekwencja \\") + c);
+                return;
+            }
+            dodaj_bajt(zbior, static_cast<unsigned char>(c));  // \. \\ \[ itd. - znak dosłowny
+            return;
+        }
+        if (c >= 'A' && c <= 'Z') odwroc(klasa);  // \D \W \S
+        for (int i = 0; i < 4; ++i) zbior[i] |= klasa[i];
+    }
+
+    // Klasa znaków [...] po otwierającym nawiasie
+    void klasa(ZbiorBajtow& zbior) {
+        bool negacja = false;
+        if (poz_ < w_.size() && w_[poz_] == '^') {
+            negacja = true;
+            ++poz_;
+        }
+        bool pierwszy = true;
+        while (true) {
+            if (koniec()) {
+                ustaw_blad("brak ']'");
+                return;
+            }
+            char c = w_[poz_];
+            if (c == ']' && !pierwszy) break;
+            pierwszy = false;
+            ++poz_;
+            if (static_cast<unsigned char>(c) >= 0x80) {
+                ustaw_blad("klasy znakow obejmuja tylko znaki ASCII");
+                return;
+            }
+            if (c == '\\') {
+                sekwencja_ucieczki(zbior);
+                continue;
+            }
+            if (poz_ + 1 < w_.size() && w_[poz_] == '-' && w_[poz_ + 1] != ']') {  // Zakres a-z
+                const char doo = w_[poz_ + 1];
+                poz_ += 2;
+                if (static_cast<unsigned char>(doo) < static_cast<unsigned char>(c) || static_cast<unsigned char>(doo) >= 0x80) {
+                    ustaw_blad("niepoprawny zakres w klasie");
+                    return;
+                }
+                dodaj_zakres(zbior, static_cast<unsigned char>(c), static_cast<unsigned char>(doo));
+                continue;
+            }
+            dodaj_bajt(zbior, static_cast<unsigned char>(c));
+        }
+        ++poz_;  // ']'
+        if (negacja) odwroc(zbior);
+    }
+
+    size_t liczba() {
+        size_t wynik = 0;
+        const size_t poczatek = poz_;
+        while (poz_ < w_.size() && w_[poz_] >= '0' && w_[poz_] <= '9') {
+            wynik = std::min<size_t>(wynik * 10 + static_cast<size_t>(w_[poz_] - '0'), 1000000);
+            ++poz_;
+        }
+        if (poz_ == poczatek) ustaw_blad("oczekiwano liczby w {n,m}");
+        return wynik;
+    }
+
+    void kwantyfikator(Wezel& element) {
+        if (koniec()) return;
+        const char c = w_[poz_];
+        if (c == '*' || c == '+') {
+            ustaw_blad(std::string("'") + c + "' daje nieograniczona dlugosc dopasowania - uzyj {n,m}");
+            return;
+        }
+        size_t min = 1, max = 1;
+        if (c == '?') {
+            ++poz_;
+            min = 0;
+        }
+        else if (c == '{') {
+            ++poz_;
+            min = max = liczba();
+            if (!koniec() && w_[poz_] == ',') {
+                ++poz_;
+                if (!koniec() && w_[poz_] == '}') {
+                    ustaw_blad("{n,} daje nieograniczona dlugosc dopasowania - uzyj {n,m}");
+                    return;
+                }
+                max = liczba();
+            }
+            if (koniec() || w_[poz_] != '}') {
+                ustaw_blad("brak '}'");
+                return;
+            }
+            ++poz_;
+            if (max < min) {
+                ustaw_blad("{n,m} wymaga n <= m");
+                return;
+            }
+        }
+        else {
+            return;
+        }
+        Wezel powtorzenie;
+        powtorzenie.typ = Wezel::Typ::Powtorzenie;
+        powtorzenie.min = min;
+        powtorzenie.max = max;
+        powtorzenie.dzieci.push_back(std::move(element));
+        element = std::move(powtorzenie);
+        if (!koniec() && (w_[poz_] == '?' || w_[poz_] == '{' || w_[poz_] == '*' || w_[poz_] == '+')) {
+            ustaw_blad("podwojny kwantyfikator");
+        }
+    }
+
+    std::string_view w_;
+    size_t poz_ = 0;
+    std::string blad_;
+};
+
+// Najkrótsza i najdłuższa długość dopasowania węzła (nasycane, żeby {1000}{1000} nie przepełniło licznika)
+void dlugosci(const Wezel& w, size_t& min, size_t& max) {
+    const size_t SUFIT = 1u << 30;
+    switch (w.typ) {
+    case Wezel::Typ::Zbior:
+        min = max = 1;
+        return;
+    case Wezel::Typ::Sekwencja:
+        min = max = 0;
+        for (const auto& d : w.dzieci) {
+            size_t a, b;
+            dlugosci(d, a, b);
+            min = std::min(min + a, SUFIT);
+            max = std::min(max + b, SUFIT);
+        }
+        return;
+    case Wezel::Typ::Alternatywa:
+        min = SUFIT;
+        max = 0;
+        for (const auto& d : w.dzieci) {
+            size_t a, b;
+            dlugosci(d, a, b);
+            min = std::min(min, a);
+            max = std::max(max, b);
+        }
+        return;
+    case Wezel::Typ::Powtorzenie: {
+        size_t a, b;
+        dlugosci(w.dzieci[0], a, b);
+        min = std::min(a * w.min, SUFIT);
+        max = (b && w.max > SUFIT / b) ? SUFIT : std::min(b * w.max, SUFIT);
+        return;
+    }
+    }
+}
+
+// Najdłuższy ciąg pojedynczych bajtów w sekwencji najwyższego poziomu - obecny w każdym dopasowaniu
+std::string najdluzszy_literal(const Wezel& korzen) {
+    std::vector<const Wezel*> elementy;
+    if (korzen.typ == Wezel::Typ::Sekwencja) {
+        for (const auto& d : korzen.dzieci) elementy.push_back(&d);
+    }
+    else {
+        elementy.push_back(&korzen);
+    }
+    std::string najlepszy, biezacy;
+    auto pojedynczy = [](const Wezel& w, unsigned char& bajt) {
+        if (w.typ != Wezel::Typ::Zbior || liczba_bajtow(w.zbior) != 1) return false;
+        for (int b = 0; b < 256; ++b) {
+            if (zawiera(w.zbior, static_cast<unsigned char>(b))) bajt = static_cast<unsigned char>(b);
+        }
+        return true;
+    };
+    for (const Wezel* w : elementy) {
+        unsigned char bajt = 0;
+        if (pojedynczy(*w, bajt)) {
+            biezacy += static_cast<char>(bajt);
+        }
+        else if (w->typ == Wezel::Typ::Powtorzenie && w->min == w->max && pojedynczy(w->dzieci[0], bajt)) {
+            biezacy.append(w->min, static_cast<char>(bajt));
+        }
+        else {
+            biezacy.clear();
+        }
+        if (biezacy.size() > najlepszy.size()) najlepszy = biezacy;
+    }
+    return najlepszy;
+}
+
+std::atomic<uint64_t> nastepny_id{ 1 };
+
+} // namespace
+
+// Budowa NFA odwróconego wzorca
+// =============================
+
+// Buduje NFA Thompsona: fragment to stan początkowy i lista niepodłączonych wyjść (stan, 0 - nastepny / 1 - drugi)
+class BudowniczyNFA {
+public:
+    using Wyjscia = std::vector<std::pair<int, int>>;
+    struct Fragment {
+        int start = -1;
+        Wyjscia wyjscia;
+    };
+
+    BudowniczyNFA(std::vector<WyrazenieRegularne::StanNFA>& stany, std::vector<ZbiorBajtow>& zbiory)
+        : stany_(stany), zbiory_(zbiory) {}
+
+    bool przepelniony() const { return stany_.size() > WyrazenieRegularne::MAKS_STANOW_NFA; }
+
+    int nowy_stan(WyrazenieRegularne::StanNFA::Typ typ) {
+        stany_.push_back({});
+        stany_.back().typ = typ;
+        return static_cast<int>(stany_.size() - 1);
+    }
+
+    void podlacz(const Wyjscia& wyjscia, int cel) {
+        for (const auto& [stan, pole] : wyjscia) (pole ? stany_[stan].drugi : stany_[stan].nastepny) = cel;
+    }
+
+    Fragment polacz(Fragment a, Fragment b) {
+        if (a.start < 0) return b;
+        podlacz(a.wyjscia, b.start);
+        return { a.start, std::move(b.wyjscia) };
+    }
+
+    // Odwrócony węzeł: sekwencje są składane od końca, reszta jak w zwykłym NFA
+    Fragment buduj(const Wezel& w) {
+        if (przepelniony()) return pusty();
+        switch (w.typ) {
+        case Wezel::Typ::Zbior: {
+            const int s = nowy_stan(WyrazenieRegularne::StanNFA::Typ::Bajty);
+            zbiory_.push_back(w.zbior);
+            stany_[s].zbior = static_cast<int>(zbiory_.size() - 1);
+            return { s, { { s, 0 } } };
+        }
+        case Wezel::Typ::Sekwencja: {
+            if (w.dzieci.empty()) return pusty();
+            Fragment wynik;
+            for (size_t i = w.dzieci.size(); i-- > 0;) wynik = polacz(std::move(wynik), buduj(w.dzieci[i]));
+            return wynik;
+        }
+        case Wezel::Typ::Alternatywa: {
+            Fragment wynik = buduj(w.dzieci.back());
+            for (size_t i = w.dzieci.size() - 1; i-- > 0;) {
+                Fragment galaz = buduj(w.dzieci[i]);
+                const int s = nowy_stan(WyrazenieRegularne::StanNFA::Typ::Rozgalezienie);
+                stany_[s].nastepny = galaz.start;
+                stany_[s].drugi = wynik.start;
+                galaz.wyjscia.insert(galaz.wyjscia.end(), wynik.wyjscia.begin(), wynik.wyjscia.end());
+                wynik = { s, std::move(galaz.wyjscia) };
+            }
+            return wynik;
+        }
+        case Wezel::Typ::Powtorzenie: {
+            Fragment wynik;
+            for (size_t i = 0; i < w.min && !przepelniony(); ++i) wynik = polacz(std::move(wynik), buduj(w.dzieci[0]));
+            for (size_t i = w.min; i < w.max && !przepelniony(); ++i) {  // x{2,4} = x x x? x?
+                Fragment element = buduj(w.dzieci[0]);
+                const int s = nowy_stan(WyrazenieRegularne::StanNFA::Typ::Rozgalezienie);
+                stany_[s].nastepny = element.start;
+                element.wyjscia.push_back({ s, 1 });
+                wynik = polacz(std::move(wynik), { s, std::move(element.wyjscia) });
+            }
+            return wynik.start < 0 ? pusty() : wynik;
+        }
+        }
+        return pusty();
+    }
+
+private:
+    Fragment pusty() {  // Przejście bez bajtu (pusta sekwencja, x{0})
+        const int s = nowy_stan(WyrazenieRegularne::StanNFA::Typ::Rozgalezienie);
+        return { s, { { s, 0 } } };
+    }
+
+    std::vector<WyrazenieRegularne::StanNFA>& stany_;
+    std::vector<ZbiorBajtow>& zbiory_;
+};
+
+std::unique_ptr<WyrazenieRegularne> WyrazenieRegularne::kompiluj(std::string_view wzorzec, std::string& blad) {
+    blad.clear();
+    if (wzorzec.empty()) {
+        blad = "puste wyrazenie";
+        return nullptr;
+    }
+    Wezel korzen;
+    Parser parser(wzorzec);
+    if (!parser.parsuj(korzen, blad)) return nullptr;
+
+    size_t min = 0, max = 0;
+    dlugosci(korzen, min, max);
+    if (min == 0) {
+        blad = "wyrazenie dopasowuje pusty ciag - liczba dopasowan nie mialaby sensu";
+        return nullptr;
+    }
+    if (max > MAKS_DLUGOSC) {
+        blad = "najdluzsze dopasowanie (" + std::to_string(max) + " B) przekracza limit " + std::to_string(MAKS_DLUGOSC) + " B";
+        return nullptr;
+    }
+
+    std::unique_ptr<WyrazenieRegularne> wynik(new WyrazenieRegularne());
+    BudowniczyNFA budowniczy(wynik->stany_, wynik->zbiory_);
+    BudowniczyNFA::Fragment automat = budowniczy.buduj(korzen);
+    if (budowniczy.przepelniony()) {
+        blad = "wyrazenie po rozwinieciu {n,m} ma ponad " + std::to_string(MAKS_STANOW_NFA) + " stanow";
+        return nullptr;
+    }
+    const int akceptacja = budowniczy.nowy_stan(StanNFA::Typ::Akceptacja);
+    budowniczy.podlacz(automat.wyjscia, akceptacja);
+    wynik->start_ = automat.start;
+    wynik->max_dlugosc_ = max;
+    wynik->literal_ = najdluzszy_literal(korzen);
+    wynik->wzorzec_ = std::string(wzorzec);
+    wynik->id_ = nastepny_id++;
+
+    // Klasy bajtów: bajty należące do tych samych zbiorów są dla automatu nierozróżnialne,
+    // więc tablica przejść DFA ma kolumnę na klasę zamiast na każdy z 256 bajtów
+    std::array<uint16_t, 256> klasa{};
+    size_t liczba_klas = 1;
+    for (const auto& zbior : wynik->zbiory_) {
+        std::array<int, 512> nowa;  // (stara klasa, należy do zbioru) -> nowa klasa
+        nowa.fill(-1);
+        size_t kolejna = 0;
+        for (int b = 0; b < 256; ++b) {
+            int& cel = nowa[klasa[b] * 2 + (zawiera(zbior, static_cast<unsigned char>(b)) ? 1 : 0)];
+            if (cel < 0) cel = static_cast<int>(kolejna++);
+            klasa[b] = static_cast<uint16_t>(cel);
+        }
+        liczba_klas = kolejna;
+    }
+    for (int b = 0; b < 256; ++b) wynik->klasa_[b] = static_cast<uint8_t>(klasa[b]);
+    wynik->liczba_klas_ = liczba_klas;
+    return wynik;
+}
+
+std::string WyrazenieRegularne::opis() const {
+    std::ostringstream tekst;
+    tekst << "Wyrazenie regularne \"" << wzorzec_ << "\" (leniwy DFA: " << stany_.size() << " stanow NFA, "
+        << liczba_klas_ << " klas bajtow, dopasowanie do " << max_dlugosc_ << " B)";
+    return tekst.str();
+}
+
+// Leniwy DFA
+// ==========
+
+/**
+ * DFA budowany w trakcie skanowania - stan to zbiór stanów NFA, przejście jest liczone przy pierwszym użyciu
+ * @details Do każdego stanu dołączane jest domknięcie startu NFA, więc automat szuka dopasowań od każdej
+ *          pozycji naraz. Po przekroczeniu MAKS_STANOW_DFA cała pamięć podręczna jest czyszczona
+ *          i budowana od nowa od bieżącego stanu (pamięć jest ograniczona niezależnie od wyrażenia).
+ */
+class LeniwyDFA {
+public:
+    explicit LeniwyDFA(const WyrazenieRegularne& wyrazenie)
+        : w_(wyrazenie), id_(wyrazenie.id_), k_(wyrazenie.liczba_klas_), znacznik_(wyrazenie.stany_.size(), 0) {
+        for (int b = 255; b >= 0; --b) przedstawiciel_[w_.klasa_[b]] = static_cast<unsigned char>(b);
+        uruchom();
+    }
+
+    uint64_t id() const { return id_; }  // Kopia - wyrażenie mogło już zostać zwolnione
+
+    // Od końca - akceptacja po bajcie i oznacza dopasowanie zaczynające się w i; liczone są tylko i < limit
+    // Z pozycjami - osobna instancja pętli, więc zwykłe liczenie zostaje bez skoku w części właściwej
+    uint64_t licz(const unsigned char* s, size_t n, size_t limit, std::vector<size_t>* pozycje) {
+        return pozycje ? licz<true>(s, n, limit, pozycje) : licz<false>(s, n, limit, nullptr);
+    }
+
+private:
+    template <bool Z_POZYCJAMI>
+    uint64_t licz(const unsigned char* s, size_t n, size_t limit, std::vector<size_t>* pozycje) {
+        uint64_t count = 0;
+        uint32_t wpis = start_;
+        const uint8_t* klasa = w_.klasa_.data();
+        const uint32_t* tablica = przejscia_.data();
+        size_t i = n;
+        for (; i > limit;) {  // Nakładka - tylko przejścia
+            --i;
+            uint32_t nastepny = tablica[(wpis >> 1) + klasa[s[i]]];
+            if (nastepny == NIEZNANE) {
+                nastepny = przejdz(wpis >> 1, klasa[s[i]]);
+                tablica = przejscia_.data();
+            }
+            wpis = nastepny;
+        }
+        for (; i > 0;) {      // Część właściwa - bit akceptacji jest dodawany bez skoku
+            --i;
+            uint32_t nastepny = tablica[(wpis >> 1) + klasa[s[i]]];
+            if (nastepny == NIEZNANE) {
+                nastepny = przejdz(wpis >> 1, klasa[s[i]]);
+                tablica = przejscia_.data();
+            }
+            wpis = nastepny;
+            count += wpis & 1;
+            if (Z_POZYCJAMI && (wpis & 1)) pozycje->push_back(i);  // Malejąco - odwraca WyrazenieRegularne::licz
+        }
+        return count;
+    }
+
+    static constexpr uint32_t NIEZNANE = UINT32_MAX;  // Przejście jeszcze nie policzone
+
+    void uruchom() {
+        przejscia_.clear();
+        zbiory_.clear();
+        slownik_.clear();
+        std::vector<int> zbior;
+        ++pokolenie_;
+        domknij(w_.start_, zbior);
+        start_ = dodaj(std::move(zbior));
+    }
+
+    // Dodaje do zbioru stany bajtowe i akceptujące osiągalne z s przejściami pustymi
+    void domknij(int s, std::vector<int>& zbior) {
+        stos_.clear();
+        stos_.push_back(s);
+        while (!stos_.empty()) {
+            const int t = stos_.back();
+            stos_.pop_back();
+            if (t < 0 || znacznik_[t] == pokolenie_) continue;
+            znacznik_[t] = pokolenie_;
+            const auto& stan = w_.stany_[t];
+            if (stan.typ == WyrazenieRegularne::StanNFA::Typ::Rozgalezienie) {
+                stos_.push_back(stan.drugi);
+                stos_.push_back(stan.nastepny);
+            }
+            else {
+                zbior.push_back(t);
+            }
+        }
+    }
+
+    // Zwraca wpis stanu: (numer stanu * k_) << 1 | akceptuje - początek wiersza tablicy i bit akceptacji
+    uint32_t dodaj(std::vector<int>&& zbior) {
+        std::sort(zbior.begin(), zbior.end());
+        std::string klucz(reinterpret_cast<const char*>(zbior.data()), zbior.size() * sizeof(int));
+        auto it = slownik_.find(klucz);
+        if (it != slownik_.end()) return it->second;
+        bool akceptuje = false;
+        for (int t : zbior) akceptuje |= w_.stany_[t].typ == WyrazenieRegularne::StanNFA::Typ::Akceptacja;
+        const uint32_t nowy = static_cast<uint32_t>(przejscia_.size() << 1) | (akceptuje ? 1u : 0u);
+        przejscia_.resize(przejscia_.size() + k_, NIEZNANE);
+        zbiory_.push_back(std::move(zbior));
+        slownik_.emplace(std::move(klucz), nowy);
+        return nowy;
+    }
+
+    uint32_t przejdz(uint32_t wiersz, uint8_t klasa) {
+        const unsigned char bajt = przedstawiciel_[klasa];
+        std::vector<int> zbior;
+        ++pokolenie_;
+        for (int t : zbiory_[wiersz / k_]) {
+            const auto& s = w_.stany_[t];
+            if (s.typ == WyrazenieRegularne::StanNFA::Typ::Bajty && zawiera(w_.zbiory_[s.zbior], bajt)) domknij(s.nastepny, zbior);
+        }
+        domknij(w_.start_, zbior);  // Dopasowanie może zaczynać się (w odwróconym tekście) na każdej pozycji
+
+        if (zbiory_.size() >= WyrazenieRegularne::MAKS_STANOW_DFA) {  // Limit pamięci - zacznij od nowa
+            uruchom();
+            return dodaj(std::move(zbior));
+        }
+        const uint32_t nowy = dodaj(std::move(zbior));
+        przejscia_[wiersz + klasa] = nowy;
+        return nowy;
+    }
+
+    const WyrazenieRegularne& w_;
+    uint64_t id_;
+    size_t k_;                                       // Liczba klas bajtów (kolumn tablicy przejść)
+    std::array<unsigned char, 256> przedstawiciel_{};  // Klasa -> dowolny bajt tej klasy
+    std::vector<uint32_t> przejscia_;                // Wiersz stanu + klasa -> wpis następnego stanu
+    std::vector<std::vector<int>> zbiory_;           // Stan DFA -> posortowane stany NFA
+    std::unordered_map<std::string, uint32_t> slownik_;  // Zbiór stanów NFA -> wpis stanu DFA
+    uint32_t start_ = 0;
+    std::vector<uint32_t> znacznik_;                 // Odwiedzone stany NFA w bieżącym domknięciu
+    uint32_t pokolenie_ = 0;
+    std::vector<int> stos_;
+};
+
+// Zliczanie
+// =========
+
+uint64_t WyrazenieRegularne::licz(std::string_view tekst, const PolozenieFragmentu& polozenie, std::vector<size_t>* pozycje) const {
+    // Automat jest budowany leniwie, więc zmienia się przy czytaniu - każdy wątek ma własny
+    thread_local std::unique_ptr<LeniwyDFA> dfa;
+    if (!dfa || dfa->id() != id_) dfa = std::make_unique<LeniwyDFA>(*this);
+
+    // Początek liczy się tylko wtedy, gdy widok zawiera całe możliwe dopasowanie - dalsze pozycje
+    // należą do następnego fragmentu (albo bufora strumienia, który zaczyna się od nich jako nakładki)
+    const size_t n = tekst.size();
+    size_t limit = std::min(polozenie.wlasciwa, n);
+    if (!polozenie.koniec_pliku) limit = std::min(limit, n >= max_dlugosc_ - 1 ? n - (max_dlugosc_ - 1) : 0);
+    if (!pozycje) return dfa->licz(reinterpret_cast<const unsigned char*>(tekst.data()), n, limit, nullptr);
+    const size_t poprzednie = pozycje->size();
+    const uint64_t count = dfa->licz(reinterpret_cast<const unsigned char*>(tekst.data()), n, limit, pozycje);
+    std::reverse(pozycje->begin() + static_cast<std::ptrdiff_t>(poprzednie), pozycje->end());  // Automat czyta od końca
+    return count;
+}
@@ -0,0 +1,82 @@
+#pragma once             // Dyrektywa kompilatora zapobiegająca wielokrotnemu dołączaniu
+#ifndef WYRAZENIA_REGULARNE_H  // Tradycyjne zabezpieczenie przed podwójnym include
+#define WYRAZENIA_REGULARNE_H
+
+#include <string>                 // Tekst błędu i opis automatu
+#include <string_view>            // Wzorzec i przeszukiwany fragment
+#include <vector>                 // Stany NFA
+#include <array>                  // Zbiory bajtów i klasy bajtów
+#include <memory>                 // std::unique_ptr dla skompilowanego wyrażenia
+#include <cstddef>                // Definicje standardowe (np. size_t)
+#include <cstdint>                // Typy o stałej szerokości
+#include "silniki_wyszukiwania.h" // PolozenieFragmentu - część właściwa fragmentu
+
+/**
+ * Wyrażenie regularne o ograniczonej długości dopasowania, zliczane leniwie budowanym DFA
+ * @brief Składnia: znaki dosłowne, '.', klasy [a-z0-9_] i [^...], \d \w \s \D \W \S, \. \\ \n \t \xHH,
+ *        grupy (...), alternatywa |, kwantyfikatory ?, {n} i {n,m}. Wyrażenie działa na bajtach -
+ *        litera UTF-8 poza klasą jest po prostu ciągiem bajtów.
+ * @details Zliczane są pozycje, od których zaczyna się co najmniej jedno dopasowanie - dla wzorca
+ *          bez metaznaków wynik jest równy liczbie (nakładających się) wystąpień silnika dosłownego.
+ *          Automat odwróconego wyrażenia przechodzi fragment od końca do początku, więc dopasowanie
+ *          zaczynające się w części właściwej kończy się najpóźniej max_dlugosc() - 1 bajtów dalej,
+ *          w nakładce fragmentu - dlatego * i + nie są obsługiwane (nakładka musi być skończona).
+ *          Stany DFA powstają dopiero przy pierwszym przejściu przez nie, a pamięć automatu jest
+ *          ograniczona - po przekroczeniu limitu pamięć podręczna stanów jest czyszczona.
+ */
+class WyrazenieRegularne {
+public:
+    static constexpr size_t MAKS_DLUGOSC = 1024;     // Najdłuższe dopasowanie (nakładka fragmentów)
+    static constexpr size_t MAKS_STANOW_NFA = 20000; // Limit rozmiaru po rozwinięciu {n,m}
+    static constexpr size_t MAKS_STANOW_DFA = 2048;  // Limit stanów DFA jednego wątku przed wyczyszczeniem
+
+    /**
+     * Kompiluje wyrażenie do NFA odwróconego wzorca
+     * @param wzorzec Tekst wyrażenia
+     * @param blad[out] Opis błędu składni (z pozycją), gdy wynik jest pusty
+     * @return nullptr, gdy wyrażenie jest niepoprawne, może dopasować pusty ciąg lub ma nieograniczoną długość
+     */
+    static std::unique_ptr<WyrazenieRegularne> kompiluj(std::string_view wzorzec, std::string& blad);
+
+    /**
+     * Zlicza pozycje początków dopasowań w części właściwej widoku
+     * @param tekst Fragment z nakładką lub bufor strumienia
+     * @param polozenie Położenie widoku - początek liczy się, gdy leży w części właściwej i (poza końcem
+     *        pliku) widok zawiera za nim pełne max_dlugosc() bajtów
+     * @param pozycje[out] Opcjonalnie: dopisywane są rosnąco policzone początki dopasowań
+     * @note Każdy wątek ma własny leniwy DFA (thread_local), więc wywołania z wielu wątków są bezpieczne
+     */
+    uint64_t licz(std::string_view tekst, const PolozenieFragmentu& polozenie = {}, std::vector<size_t>* pozycje = nullptr) const;
+
+    size_t max_dlugosc() const { return max_dlugosc_; }     // Najdłuższe możliwe dopasowanie w bajtach
+    size_t liczba_stanow_nfa() const { return stany_.size(); }
+    size_t liczba_klas() const { return liczba_klas_; }     // Klasy bajtów nierozróżnialnych przez wyrażenie
+    const std::string& literal() const { return literal_; } // Najdłuższy tekst dosłowny obecny w każdym dopasowaniu
+    std::string opis() const;                               // Do Metrics::silnik
+
+private:
+    friend class LeniwyDFA;
+    friend class BudowniczyNFA;
+    WyrazenieRegularne() = default;
+
+    // Stan NFA Thompsona (odwróconego wzorca)
+    struct StanNFA {
+        enum class Typ : uint8_t { Bajty, Rozgalezienie, Akceptacja } typ = Typ::Akceptacja;
+        int zbior = -1;      // Bajty: indeks w zbiory_
+        int nastepny = -1;   // Bajty: stan po bajcie; Rozgałęzienie: pierwsza gałąź
+        int drugi = -1;      // Rozgałęzienie: druga gałąź
+    };
+    using ZbiorBajtow = std::array<uint64_t, 4>;
+
+    std::vector<StanNFA> stany_;
+    std::vector<ZbiorBajtow> zbiory_;
+    int start_ = -1;
+    size_t max_dlugosc_ = 0;
+    std::array<uint8_t, 256> klasa_{};  // Bajt -> klasa bajtów
+    size_t liczba_klas_ = 0;
+    std::string literal_;
+    std::string wzorzec_;
+    uint64_t id_ = 0;                   // Rozróżnia wyrażenia w pamięci podręcznej automatów wątków
+};
+
+#endif // WYRAZENIA_REGULARNE_H
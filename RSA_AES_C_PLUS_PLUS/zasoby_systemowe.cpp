@@ -0,0 +1,144 @@
+// Sekcja includów - dołączanie niezbędnych bibliotek
+#include "zasoby_systemowe.h"   // Deklaracje liczników zasobów i pomiaru
+#include "silniki_wyszukiwania.h"  // licznik_cykli - cykle w czasie pomiaru
+#include <thread>               // std::thread::hardware_concurrency - liczba procesorów logicznych
+
+#ifdef _WIN32
+#define NOMINMAX                // Wyłącz makra min/max z windows.h
+#include <windows.h>            // GetProcessTimes, GetThreadTimes
+#include <psapi.h>              // GetProcessMemoryInfo
+
+#pragma comment(lib, "psapi.lib")  // Linkowanie z biblioteką psapi
+#else
+#include <time.h>               // clock_gettime
+#include <sys/resource.h>       // getrusage
+#include <fstream>              // Odczyt /proc/self/status
+#include <string>               // Wiersze /proc/self/status
+#include <cstdlib>              // std::strtoull
+#endif
+
+// Odczyt liczników
+// ================
+
+#ifdef _WIN32
+// Czas z FILETIME (jednostki 100 ns) w sekundach
+static double sekundy(const FILETIME& czas) {
+    ULARGE_INTEGER wartosc;
+    wartosc.LowPart = czas.dwLowDateTime;
+    wartosc.HighPart = czas.dwHighDateTime;
+    return wartosc.QuadPart * 1e-7;
+}
+
+ZasobyProcesu odczytaj_zasoby() {
+    ZasobyProcesu zasoby;
+    FILETIME utworzenie, zakonczenie, jadro, uzytkownik;
+    if (GetProcessTimes(GetCurrentProcess(), &utworzenie, &zakonczenie, &jadro, &uzytkownik)) {
+        zasoby.cpu_uzytkownika = sekundy(uzytkownik);
+        zasoby.cpu_systemu = sekundy(jadro);
+        zasoby.cpu = zasoby.cpu_uzytkownika + zasoby.cpu_systemu;
+    }
+    if (GetThreadTimes(GetCurrentThread(), &utworzenie, &zakonczenie, &jadro, &uzytkownik))
+        zasoby.cpu_watku = sekundy(uzytkownik) + sekundy(jadro);
+
+    PROCESS_MEMORY_COUNTERS_EX pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), (PROCESS_MEMORY_COUNTERS*)&pmc, sizeof(pmc))) {
+        zasoby.pamiec_prywatna = pmc.PrivateUsage;
+        zasoby.pamiec_rezydentna = pmc.WorkingSetSize;
+        zasoby.szczyt_pamieci = pmc.PeakWorkingSetSize;
+        zasoby.bledy_stron = pmc.PageFaultCount;  // Bez podziału na drobne i dyskowe
+    }
+    return zasoby;
+}
+#else
+// Czas zegara CPU w sekundach (0, gdy zegar niedostępny)
+static double czas_zegara(clockid_t zegar) {
+    timespec czas;
+    if (clock_gettime(zegar, &czas) != 0) return 0.0;
+    return czas.tv_sec + czas.tv_nsec * 1e-9;
+}
+
+static double sekundy(const timeval& czas) {
+    return czas.tv_sec + czas.tv_usec * 1e-6;
+}
+
+// Pola pamięci z /proc/self/status (wartości w kB)
+static void odczytaj_status(ZasobyProcesu& zasoby) {
+    std::ifstream status("/proc/self/status");
+    bool jest_anonimowa = false;
+    std::string wiersz;
+    while (std::getline(status, wiersz)) {
+        size_t* pole = nullptr;
+        if (wiersz.compare(0, 8, "RssAnon:") == 0) { pole = &zasoby.pamiec_prywatna; jest_anonimowa = true; }
+        else if (wiersz.compare(0, 6, "VmRSS:") == 0) pole = &zasoby.pamiec_rezydentna;
+        else if (wiersz.compare(0, 6, "VmHWM:") == 0) pole = &zasoby.szczyt_pamieci;
+        if (pole) *pole = static_cast<size_t>(std::strtoull(wiersz.c_str() + wiersz.find(':') + 1, nullptr, 10)) * 1024;
+    }
+    // Jądra starsze niż 4.5 nie podają RssAnon - wtedy pamięć prywatna to cały zbiór roboczy
+    if (!jest_anonimowa) zasoby.pamiec_prywatna = zasoby.pamiec_rezydentna;
+}
+
+ZasobyProcesu odczytaj_zasoby() {
+    ZasobyProcesu zasoby;
+    rusage uzycie;
+    if (getrusage(RUSAGE_SELF, &uzycie) == 0) {
+        zasoby.cpu_uzytkownika = sekundy(uzycie.ru_utime);
+        zasoby.cpu_systemu = sekundy(uzycie.ru_stime);
+        zasoby.przelaczenia_dobrowolne = uzycie.ru_nvcsw;
+        zasoby.przelaczenia_wymuszone = uzycie.ru_nivcsw;
+        zasoby.bledy_stron = uzycie.ru_minflt;
+        zasoby.bledy_stron_dysku = uzycie.ru_majflt;
+    }
+    odczytaj_status(zasoby);
+
+    // Zegar CPU procesu ma rozdzielczość nanosekund, getrusage - mikrosekund, więc suma pochodzi z zegara;
+    // odczytany na końcu, żeby parsowanie /proc na starcie pomiaru nie wliczało się do czasu CPU
+    zasoby.cpu = czas_zegara(CLOCK_PROCESS_CPUTIME_ID);
+    zasoby.cpu_watku = czas_zegara(CLOCK_THREAD_CPUTIME_ID);
+    return zasoby;
+}
+#endif
+
+// Pomiar
+// ======
+
+// Przyrost licznika - zero, gdy wartość spadła (np. zwolniona pamięć)
+template <typename T>
+static T przyrost(T koniec, T poczatek) {
+    return koniec > poczatek ? koniec - poczatek : T{};
+}
+
+Pomiar rozpocznij_pomiar() {
+    Pomiar pomiar;
+    pomiar.start_zasoby = odczytaj_zasoby();
+    pomiar.start_time = std::chrono::high_resolution_clock::now();
+    pomiar.start_cykle = licznik_cykli();
+    return pomiar;
+}
+
+Metrics zakoncz_pomiar(const Pomiar& pomiar) {
+    // Odczyt liczników przed zatrzymaniem zegarów - jego koszt trafia i do czasu CPU, i do czasu ściennego
+    const ZasobyProcesu koniec = odczytaj_zasoby();
+    uint64_t end_cykle = licznik_cykli();
+    auto end_time = std::chrono::high_resolution_clock::now();
+    const ZasobyProcesu& start = pomiar.start_zasoby;
+
+    // Oblicz metryki
+    double czas = std::chrono::duration<double>(end_time - pomiar.start_time).count();
+    unsigned num_cpus = std::thread::hardware_concurrency();  // Procesory logiczne
+    if (num_cpus == 0) num_cpus = 1;
+
+    Metrics wynik{};
+    wynik.czas = czas;
+    wynik.cpu_usage = czas > 0.0 ? (koniec.cpu - start.cpu) / (czas * num_cpus) * 100.0 : 0.0;  // Uwzględnij liczbę rdzeni
+    wynik.ram_usage = przyrost(koniec.pamiec_prywatna, start.pamiec_prywatna);
+    wynik.cykle = end_cykle - pomiar.start_cykle;
+    wynik.cpu_uzytkownika = przyrost(koniec.cpu_uzytkownika, start.cpu_uzytkownika);
+    wynik.cpu_systemu = przyrost(koniec.cpu_systemu, start.cpu_systemu);
+    wynik.cpu_watku = przyrost(koniec.cpu_watku, start.cpu_watku);
+    wynik.szczyt_pamieci = koniec.szczyt_pamieci;
+    wynik.przelaczenia_dobrowolne = przyrost(koniec.przelaczenia_dobrowolne, start.przelaczenia_dobrowolne);
+    wynik.przelaczenia_wymuszone = przyrost(koniec.przelaczenia_wymuszone, start.przelaczenia_wymuszone);
+    wynik.bledy_stron = przyrost(koniec.bledy_stron, start.bledy_stron);
+    wynik.bledy_stron_dysku = przyrost(koniec.bledy_stron_dysku, start.bledy_stron_dysku);
+    return wynik;
+}
@@ -0,0 +1,55 @@
+#pragma once                // Dyrektywa kompilatora zapobiegająca wielokrotnemu dołączaniu
+#ifndef ZASOBY_SYSTEMOWE_H  // Tradycyjne zabezpieczenie przed podwójnym include
+#define ZASOBY_SYSTEMOWE_H
+
+#include <cstddef>        // Definicje standardowe (np. size_t)
+#include <cstdint>        // uint64_t - liczniki jądra i cykle
+#include <chrono>         // Czas ścienny pomiaru
+#include "liczenie_slow.h"  // Metrics - wynik pomiaru
+
+/**
+ * Migawka liczników zasobów procesu (jedno wywołanie systemu na grupę liczników)
+ * @details Linux: clock_gettime (CLOCK_PROCESS_CPUTIME_ID, CLOCK_THREAD_CPUTIME_ID), getrusage(RUSAGE_SELF)
+ *          i /proc/self/status (RssAnon, VmRSS, VmHWM).
+ *          Windows: GetProcessTimes, GetThreadTimes i GetProcessMemoryInfo (PrivateUsage, WorkingSetSize,
+ *          PeakWorkingSetSize). Windows nie prowadzi licznika przełączeń kontekstu procesu ani podziału
+ *          błędów stron na drobne i dyskowe - te pola są tam zerami (PageFaultCount trafia do bledy_stron).
+ */
+struct ZasobyProcesu {
+    double cpu = 0.0;               // Czas CPU wszystkich wątków procesu w sekundach
+    double cpu_uzytkownika = 0.0;   // W tym w trybie użytkownika
+    double cpu_systemu = 0.0;       // W tym w trybie jądra
+    double cpu_watku = 0.0;         // Czas CPU wątku wywołującego
+    size_t pamiec_prywatna = 0;     // Anonimowa pamięć rezydentna (Linux: RssAnon) / pamięć prywatna (Windows: PrivateUsage)
+    size_t pamiec_rezydentna = 0;   // Zbiór roboczy z mapowaniami plików (VmRSS / WorkingSetSize)
+    size_t szczyt_pamieci = 0;      // Największy zbiór roboczy od startu procesu (VmHWM / PeakWorkingSetSize)
+    uint64_t przelaczenia_dobrowolne = 0;  // Oddanie procesora w oczekiwaniu na zasób (ru_nvcsw)
+    uint64_t przelaczenia_wymuszone = 0;   // Wywłaszczenie przez planistę (ru_nivcsw)
+    uint64_t bledy_stron = 0;       // Błędy stron obsłużone bez dysku (ru_minflt; Windows: wszystkie błędy stron)
+    uint64_t bledy_stron_dysku = 0; // Błędy stron wymagające odczytu z dysku (ru_majflt)
+};
+
+/**
+ * Odczytuje bieżące liczniki zasobów procesu
+ * @note Liczniki, których system nie udostępnia, pozostają zerami
+ */
+ZasobyProcesu odczytaj_zasoby();
+
+// Pomiar zasobów wspólny dla zliczania słów i szyfrowania
+struct Pomiar {
+    ZasobyProcesu start_zasoby;
+    std::chrono::high_resolution_clock::time_point start_time;
+    uint64_t start_cykle;
+};
+
+// Rozpoczyna pomiar czasu, CPU, pamięci i liczników jądra
+Pomiar rozpocznij_pomiar();
+
+/**
+ * Kończy pomiar i oblicza metryki (liczbę wystąpień i bajtów uzupełnia wywołujący)
+ * @details cpu_usage to czas CPU procesu względem czasu ściennego wszystkich procesorów logicznych,
+ *          ram_usage i liczniki jądra to przyrosty od rozpocznij_pomiar(), szczyt_pamieci - wartość bezwzględna.
+ */
+Metrics zakoncz_pomiar(const Pomiar& pomiar);
+
+#endif // ZASOBY_SYSTEMOWE_H